@@ -0,0 +1,52 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace plug::bench
+{
+    std::size_t allocations();
+
+    // Reports the heap allocations per iteration of the benchmark as "allocs/op"
+    class AllocationCounter
+    {
+    public:
+        explicit AllocationCounter(benchmark::State& state)
+            : state_(state), start_(allocations())
+        {
+        }
+
+        AllocationCounter(const AllocationCounter&) = delete;
+
+        ~AllocationCounter()
+        {
+            state_.counters["allocs/op"] = benchmark::Counter(static_cast<double>(allocations() - start_), benchmark::Counter::kAvgIterations);
+        }
+
+        AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    private:
+        benchmark::State& state_;
+        const std::size_t start_;
+    };
+}
@@ -0,0 +1,131 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/BulkPresetLoader.h"
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace plug::bench
+{
+    using namespace plug::com;
+
+    namespace
+    {
+        inline constexpr std::size_t corpusSize{10'000};
+
+        // Synthetic FUSE files, written once and removed on exit
+        class Corpus
+        {
+        public:
+            Corpus()
+            {
+                std::filesystem::create_directories(directory);
+
+                for (std::size_t i = 0; i < corpusSize; ++i)
+                {
+                    files.push_back(directory / ("preset-" + std::to_string(i) + ".fuse"));
+                    std::ofstream out{files.back()};
+                    out << R"(<?xml version="1.0" encoding="utf-8"?><Preset amplifier="Mustang III" ProductId="1"><Amplifier><Module ID="94" POS="0" BypassState="1">)";
+
+                    for (std::size_t knob = 0; knob < 21; ++knob)
+                    {
+                        out << R"(<Param ControlIndex=")" << knob << R"(">)" << ((i + knob) * 257 % 65536) << "</Param>";
+                    }
+
+                    out << R"(</Module></Amplifier><FX><Stompbox ID="1"><Module ID="60" POS="0" BypassState="1">)";
+
+                    for (std::size_t knob = 0; knob < 6; ++knob)
+                    {
+                        out << R"(<Param ControlIndex=")" << knob << R"(">)" << (knob * 4096) << "</Param>";
+                    }
+
+                    out << R"(</Module></Stompbox></FX><FUSE><Info name="Preset )" << i << R"(" author="plug" /></FUSE></Preset>)";
+                }
+            }
+
+            Corpus(const Corpus&) = delete;
+
+            ~Corpus()
+            {
+                std::error_code error;
+                std::filesystem::remove_all(directory, error);
+            }
+
+            Corpus& operator=(const Corpus&) = delete;
+
+            const std::filesystem::path directory{std::filesystem::temp_directory_path() / "plug-bench-corpus"};
+            std::vector<std::filesystem::path> files;
+        };
+
+        const Corpus& corpus()
+        {
+            static const Corpus instance;
+            return instance;
+        }
+
+        // Stand-in for the Qt based FUSE reader: reads the whole file and scans the parameters and the name
+        SignalChain scanPresetFile(const std::filesystem::path& file)
+        {
+            std::ifstream in{file};
+            const std::string content{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+            const std::string_view text{content};
+
+            amp_settings amp{};
+            constexpr std::string_view param{R"(<Param ControlIndex=")"};
+
+            for (auto pos = text.find(param); pos != std::string_view::npos; pos = text.find(param, pos))
+            {
+                pos += param.size();
+                int index{0};
+                int value{0};
+                const auto indexEnd = std::from_chars(text.data() + pos, text.data() + text.size(), index).ptr;
+                std::from_chars(indexEnd + 2, text.data() + text.size(), value);
+
+                if (index == 1)
+                {
+                    amp.gain = static_cast<std::uint8_t>(value >> 8);
+                }
+            }
+
+            constexpr std::string_view info{R"(<Info name=")"};
+            const auto nameStart = text.find(info) + info.size();
+            return SignalChain{std::string{text.substr(nameStart, text.find('"', nameStart) - nameStart)}, amp, {}};
+        }
+    }
+
+
+    void bulkLoad(benchmark::State& state)
+    {
+        const auto& files = corpus().files;
+        const auto numberOfThreads = static_cast<std::size_t>(state.range(0));
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(loadPresets(files, scanPresetFile, numberOfThreads));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * files.size()));
+    }
+    BENCHMARK(bulkLoad)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
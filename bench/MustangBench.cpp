@@ -0,0 +1,193 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AllocationCounter.h"
+#include "ScriptedConnection.h"
+#include "DeviceModel.h"
+#include "com/AmpSession.h"
+#include "com/Mustang.h"
+#include "com/Packet.h"
+#include "com/PacketSerializer.h"
+#include "com/ReplayConnection.h"
+#include "com/SessionRecording.h"
+#include "com/SimulatorConnection.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+
+namespace plug::bench
+{
+    using namespace plug::com;
+
+    namespace
+    {
+        const amp_settings ampSettings{amps::BRITISH_80S, 1, 2, 3, 4, 5, cabinets::cab4x12G, 6, 7, 8, 9, 10, 11, 12, 1, true, 13};
+        const fx_pedal_settings effectSettings{FxSlot{2}, effects::TAPE_DELAY, 1, 2, 3, 4, 5, 6, true};
+        const DeviceModel deviceModel{"Benchmark", DeviceModel::Category::MustangV1, 100};
+
+        std::vector<PacketRawType> bankPackets()
+        {
+            const auto effect = serializeEffectSettings(effectSettings).getBytes();
+            return {serializeName(0, "bank name").getBytes(),
+                    serializeAmpSettings(ampSettings).getBytes(),
+                    effect,
+                    effect,
+                    effect,
+                    effect,
+                    serializeAmpSettingsUsbGain(ampSettings).getBytes()};
+        }
+
+        PacketRawType confirmationPacket()
+        {
+            Header header{};
+            header.setStage(Stage::ready);
+            header.setType(Type::operation);
+            header.setDSP(DSP::none);
+            return Packet<EmptyPayload>{header, EmptyPayload{}}.getBytes();
+        }
+    }
+
+
+    void startAmp(benchmark::State& state)
+    {
+        // Init acknowledges, preset names and the current bank; the transmission ends with a timeout once the script is consumed
+        std::vector<PacketRawType> script(2, PacketRawType{});
+
+        for (std::uint8_t i = 0; i < deviceModel.numberOfPresets(); ++i)
+        {
+            script.push_back(serializeName(i, "preset name").getBytes());
+            script.push_back(PacketRawType{});
+        }
+
+        const auto bank = bankPackets();
+        script.insert(script.cend(), bank.cbegin(), bank.cend());
+
+        const auto conn = std::make_shared<ScriptedConnection>(script);
+        Mustang mustang{deviceModel, conn};
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            conn->rewind();
+            benchmark::DoNotOptimize(mustang.start_amp());
+        }
+    }
+    BENCHMARK(startAmp);
+
+    void loadMemoryBank(benchmark::State& state)
+    {
+        auto script = bankPackets();
+        script.push_back(confirmationPacket());
+
+        const auto conn = std::make_shared<ScriptedConnection>(script);
+        Mustang mustang{deviceModel, conn};
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            conn->rewind();
+            benchmark::DoNotOptimize(mustang.load_memory_bank(3));
+        }
+    }
+    BENCHMARK(loadMemoryBank);
+
+    void setEffect(benchmark::State& state)
+    {
+        // Alternating knob values, otherwise the unchanged settings are never sent again
+        fx_pedal_settings other = effectSettings;
+        other.knob1 = 100;
+        const std::array settings{effectSettings, other};
+
+        const auto conn = std::make_shared<ScriptedConnection>(std::vector<PacketRawType>(4, PacketRawType{}));
+        Mustang mustang{deviceModel, conn};
+        std::size_t i{0};
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            conn->rewind();
+            mustang.set_effect(settings[i++ % settings.size()]);
+        }
+    }
+    BENCHMARK(setEffect);
+
+    void presetSwitches(benchmark::State& state)
+    {
+        const auto conn = std::make_shared<SimulatorConnection>(deviceModel.numberOfPresets(), std::chrono::microseconds{0});
+        Mustang mustang{deviceModel, conn};
+        std::size_t slot{0};
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mustang.load_memory_bank(static_cast<std::uint8_t>(slot++ % deviceModel.numberOfPresets())));
+        }
+    }
+    BENCHMARK(presetSwitches);
+
+    void broadcastPreset(benchmark::State& state)
+    {
+        // Latency per packet of the simulated amps; alternating presets, so the shadow state doesn't skip packets
+        const std::chrono::microseconds latency{200};
+        std::vector<std::unique_ptr<Mustang>> amps;
+
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            amps.push_back(std::make_unique<Mustang>(deviceModel, std::make_shared<SimulatorConnection>(deviceModel.numberOfPresets(), latency)));
+        }
+
+        const auto sessions = openSessions(std::move(amps));
+        const std::array presets{SignalChain{"first", ampSettings, {effectSettings}},
+                                 SignalChain{"second", amp_settings{}, {fx_pedal_settings{FxSlot{2}, effects::EMPTY, 0, 0, 0, 0, 0, 0, false}}}};
+        std::size_t i{0};
+
+        for (auto _ : state)
+        {
+            broadcast(sessions, presets[i++ % presets.size()]);
+        }
+    }
+    BENCHMARK(broadcastPreset)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+    void startAmpReplay(benchmark::State& state)
+    {
+        // Session of a Mustang III/IV/V recorded by PLUG_RECORD
+        const char* path = std::getenv("PLUG_BENCH_RECORDING");
+
+        if (path == nullptr)
+        {
+            state.SkipWithError("PLUG_BENCH_RECORDING not set");
+            return;
+        }
+
+        std::ifstream in{path, std::ios::binary};
+        const auto conn = std::make_shared<ReplayConnection>(readRecording(in), ReplaySpeed::asFastAsPossible);
+        Mustang mustang{deviceModel, conn};
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            conn->rewind();
+            benchmark::DoNotOptimize(mustang.start_amp());
+        }
+    }
+    BENCHMARK(startAmpReplay);
+}
@@ -0,0 +1,221 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AllocationCounter.h"
+#include "com/Packet.h"
+#include "com/PacketSerializer.h"
+#include "com/PacketView.h"
+#include <benchmark/benchmark.h>
+
+namespace plug::bench
+{
+    using namespace plug::com;
+
+    namespace
+    {
+        const amp_settings ampSettings{amps::BRITISH_80S, 1, 2, 3, 4, 5, cabinets::cab4x12G, 6, 7, 8, 9, 10, 11, 12, 1, true, 13};
+        const fx_pedal_settings effectSettings{FxSlot{2}, effects::TAPE_DELAY, 1, 2, 3, 4, 5, 6, true};
+        const std::vector<fx_pedal_settings> saveEffects{fx_pedal_settings{FxSlot{1}, effects::MONO_DELAY, 0, 1, 2, 3, 4, 5, true},
+                                                         fx_pedal_settings{FxSlot{2}, effects::SINE_FLANGER, 6, 7, 8, 0, 0, 0, true}};
+
+        std::vector<PacketRawType> presetListPackets()
+        {
+            std::vector<PacketRawType> packets;
+
+            for (std::uint8_t i = 0; i < 100; ++i)
+            {
+                packets.push_back(serializeName(i, "preset name " + std::to_string(i)).getBytes());
+                packets.push_back(PacketRawType{});
+            }
+            return packets;
+        }
+    }
+
+
+    void packetGetBytes(benchmark::State& state)
+    {
+        const auto packet = serializeAmpSettings(ampSettings);
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(packet.getBytes());
+        }
+    }
+    BENCHMARK(packetGetBytes);
+
+    void packetFromBytes(benchmark::State& state)
+    {
+        const auto data = serializeAmpSettings(ampSettings).getBytes();
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            Packet<AmpPayload> packet{};
+            packet.fromBytes(data);
+            benchmark::DoNotOptimize(packet);
+        }
+    }
+    BENCHMARK(packetFromBytes);
+
+
+    void serializeAmpSettingsBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeAmpSettings(ampSettings));
+        }
+    }
+    BENCHMARK(serializeAmpSettingsBench)->Name("serializeAmpSettings");
+
+    void serializeAmpSettingsUsbGainBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeAmpSettingsUsbGain(ampSettings));
+        }
+    }
+    BENCHMARK(serializeAmpSettingsUsbGainBench)->Name("serializeAmpSettingsUsbGain");
+
+    void serializeNameBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeName(3, "preset name"));
+        }
+    }
+    BENCHMARK(serializeNameBench)->Name("serializeName");
+
+    void serializeEffectSettingsBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeEffectSettings(effectSettings));
+        }
+    }
+    BENCHMARK(serializeEffectSettingsBench)->Name("serializeEffectSettings");
+
+    void serializeClearEffectSettingsBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeClearEffectSettings(effectSettings));
+        }
+    }
+    BENCHMARK(serializeClearEffectSettingsBench)->Name("serializeClearEffectSettings");
+
+    void serializeSaveEffectNameBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeSaveEffectName(3, "effect name", saveEffects));
+        }
+    }
+    BENCHMARK(serializeSaveEffectNameBench)->Name("serializeSaveEffectName");
+
+    void serializeSaveEffectPacketBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeSaveEffectPacket(3, saveEffects));
+        }
+    }
+    BENCHMARK(serializeSaveEffectPacketBench)->Name("serializeSaveEffectPacket");
+
+    void serializeCommandsBench(benchmark::State& state)
+    {
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializeLoadSlotCommand(3));
+            benchmark::DoNotOptimize(serializeLoadCommand());
+            benchmark::DoNotOptimize(serializeApplyCommand());
+            benchmark::DoNotOptimize(serializeApplyCommand(effectSettings));
+            benchmark::DoNotOptimize(serializeInitCommand());
+        }
+    }
+    BENCHMARK(serializeCommandsBench)->Name("serializeCommands");
+
+
+    void decodeNameFromDataBench(benchmark::State& state)
+    {
+        const auto data = serializeName(3, "preset name").getBytes();
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(decodeNameFromData(PacketView<NamePayload>{data}));
+        }
+    }
+    BENCHMARK(decodeNameFromDataBench)->Name("decodeNameFromData");
+
+    void decodeAmpFromDataBench(benchmark::State& state)
+    {
+        const auto data = serializeAmpSettings(ampSettings).getBytes();
+        const auto dataUsbGain = serializeAmpSettingsUsbGain(ampSettings).getBytes();
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(decodeAmpFromData(PacketView<AmpPayload>{data}, PacketView<AmpPayload>{dataUsbGain}));
+        }
+    }
+    BENCHMARK(decodeAmpFromDataBench)->Name("decodeAmpFromData");
+
+    void decodeEffectsFromDataBench(benchmark::State& state)
+    {
+        const auto data = serializeEffectSettings(effectSettings).getBytes();
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(decodeEffectsFromData({{PacketView<EffectPayload>{data}, PacketView<EffectPayload>{data},
+                                                             PacketView<EffectPayload>{data}, PacketView<EffectPayload>{data}}}));
+        }
+    }
+    BENCHMARK(decodeEffectsFromDataBench)->Name("decodeEffectsFromData");
+
+    void decodePresetListFromDataBench(benchmark::State& state)
+    {
+        const auto packets = presetListPackets();
+        const AllocationCounter counter{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(decodePresetListFromData(std::span<const PacketRawType>{packets}));
+        }
+    }
+    BENCHMARK(decodePresetListFromDataBench)->Name("decodePresetListFromData");
+}
@@ -0,0 +1,88 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Connection.h"
+#include "com/Packet.h"
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace plug::bench
+{
+    // Replays the scripted packets as responses, signals a timeout once all are consumed
+    class ScriptedConnection : public com::Connection
+    {
+    public:
+        explicit ScriptedConnection(std::vector<com::PacketRawType> responses)
+            : responses_(std::move(responses)), next_(0)
+        {
+        }
+
+        void rewind()
+        {
+            next_ = 0;
+        }
+
+        void close() override
+        {
+        }
+
+        bool isOpen() const override
+        {
+            return true;
+        }
+
+        std::vector<std::uint8_t> receive(std::size_t recvSize) override
+        {
+            com::PacketRawType packet{};
+            const auto size = std::min(receiveInto(packet), recvSize);
+            return std::vector<std::uint8_t>(packet.cbegin(), std::next(packet.cbegin(), size));
+        }
+
+        std::size_t receiveInto(std::span<std::uint8_t, com::packetRawTypeSize> buffer) override
+        {
+            if (next_ >= responses_.size())
+            {
+                return 0;
+            }
+            const auto& packet = responses_[next_++];
+            std::copy(packet.cbegin(), packet.cend(), buffer.begin());
+            return packet.size();
+        }
+
+        std::string name() const override
+        {
+            return "Scripted";
+        }
+
+    private:
+        std::size_t sendImpl([[maybe_unused]] const std::uint8_t* data, std::size_t size) override
+        {
+            return size;
+        }
+
+        std::vector<com::PacketRawType> responses_;
+        std::size_t next_;
+    };
+}
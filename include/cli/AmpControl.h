@@ -0,0 +1,84 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include "com/AmpBackup.h"
+#include "com/Mustang.h"
+#include <ostream>
+
+namespace plug::daemon
+{
+    class DaemonClient;
+}
+
+namespace plug::cli
+{
+    // The amp operations used by the commands; they run on a connected amp or through a running plugd
+    class AmpControl
+    {
+    public:
+        virtual ~AmpControl() = default;
+
+        virtual com::InitialData state() = 0;
+        virtual SignalChain load(std::uint8_t slot) = 0;
+        virtual void setAmp(const amp_settings& amp) = 0;
+        virtual void setEffect(const fx_pedal_settings& effect) = 0;
+        virtual void backup(std::ostream& out) = 0;
+        virtual void restore(const com::AmpBackup& backup) = 0;
+    };
+
+
+    // The state is read by starting the amp
+    class MustangControl : public AmpControl
+    {
+    public:
+        explicit MustangControl(com::Mustang& mustang);
+
+        com::InitialData state() override;
+        SignalChain load(std::uint8_t slot) override;
+        void setAmp(const amp_settings& amp) override;
+        void setEffect(const fx_pedal_settings& effect) override;
+        void backup(std::ostream& out) override;
+        void restore(const com::AmpBackup& backup) override;
+
+    private:
+        com::Mustang& mustang_;
+    };
+
+
+    // Backup and restore transfer all presets, they aren't served by plugd
+    class DaemonControl : public AmpControl
+    {
+    public:
+        explicit DaemonControl(daemon::DaemonClient& client);
+
+        com::InitialData state() override;
+        SignalChain load(std::uint8_t slot) override;
+        void setAmp(const amp_settings& amp) override;
+        void setEffect(const fx_pedal_settings& effect) override;
+        void backup(std::ostream& out) override;
+        void restore(const com::AmpBackup& backup) override;
+
+    private:
+        daemon::DaemonClient& client_;
+    };
+}
@@ -0,0 +1,63 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include "cli/AmpControl.h"
+#include "com/BulkPresetLoader.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace plug::cli
+{
+    std::string usage();
+    std::vector<std::string> splitCommand(std::string_view line);
+
+    // Runs plug-cli commands on a started amp; the current state is tracked, so commands can change single settings
+    class CommandInterpreter
+    {
+    public:
+        CommandInterpreter(AmpControl& amp, com::PresetLoader loader, std::ostream& out);
+
+        void start();
+        void execute(const std::vector<std::string>& command);
+        std::size_t runBatch(std::istream& in, std::ostream& err);
+
+    private:
+        void load(const std::vector<std::string>& args);
+        void dump() const;
+        void apply(const std::vector<std::string>& args);
+        void setAmp(const std::vector<std::string>& args);
+        void setFx(const std::vector<std::string>& args);
+        void backup(const std::vector<std::string>& args);
+        void restore(const std::vector<std::string>& args);
+        void applyPreset(const SignalChain& preset);
+
+        AmpControl& amp_;
+        com::PresetLoader loader_;
+        std::ostream& out_;
+        SignalChain current_;
+        std::vector<std::string> presetNames_;
+    };
+}
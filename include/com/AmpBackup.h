@@ -0,0 +1,43 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Packet.h"
+#include <array>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace plug::com
+{
+    // Memory banks and Mod / Dly/Rev knob presets as transmitted by the amp
+    struct AmpBackup
+    {
+        std::vector<std::array<PacketRawType, 7>> banks;
+        std::vector<PacketRawType> knobPresets;
+    };
+
+    void writeBackupHeader(std::ostream& out);
+    void writeBackupKnobPresets(std::ostream& out, std::span<const PacketRawType> packets);
+    void writeBackupBank(std::ostream& out, std::span<const PacketRawType, 7> bank);
+    AmpBackup readBackup(std::istream& in);
+}
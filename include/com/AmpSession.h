@@ -0,0 +1,86 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Mustang.h"
+#include "com/SpscQueue.h"
+#include "SignalChain.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <semaphore>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+
+namespace plug::com
+{
+    // Runs all communication with one amp on its own thread; the owning thread is the only one submitting commands
+    class AmpSession
+    {
+    public:
+        explicit AmpSession(std::unique_ptr<Mustang> mustang);
+        AmpSession(const AmpSession&) = delete;
+        ~AmpSession();
+
+        DeviceModel getDeviceModel() const;
+
+        std::future<InitialData> start();
+        std::future<void> stop();
+        std::future<SignalChain> load(std::uint8_t slot);
+        std::future<void> apply(const SignalChain& signalChain);
+
+        template <class Fn>
+        std::future<std::invoke_result_t<Fn, Mustang&>> submit(Fn fn)
+        {
+            using Result = std::invoke_result_t<Fn, Mustang&>;
+
+            auto task = std::make_shared<std::packaged_task<Result()>>([this, fn = std::move(fn)]() mutable
+                                                                       { return fn(*mustang_); });
+            auto result = task->get_future();
+            post([task]
+                 { (*task)(); });
+            return result;
+        }
+
+        AmpSession& operator=(const AmpSession&) = delete;
+
+    private:
+        using Command = std::function<void()>;
+        using CommandQueue = SpscQueue<Command, 64>;
+
+        void post(Command command);
+        void run(std::stop_token stopToken);
+
+        const std::unique_ptr<Mustang> mustang_;
+        CommandQueue commands_;
+        std::counting_semaphore<> commandsAvailable_;
+        std::counting_semaphore<CommandQueue::capacity()> freeSlots_;
+        std::jthread worker_;
+    };
+
+
+    std::vector<std::unique_ptr<AmpSession>> openSessions(std::vector<std::unique_ptr<Mustang>> amps);
+
+    // Applies the signal chain on all amps in parallel; waits for every amp and rethrows the first failure
+    void broadcast(std::span<const std::unique_ptr<AmpSession>> sessions, const SignalChain& signalChain);
+}
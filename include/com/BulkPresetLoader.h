@@ -0,0 +1,47 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace plug::com
+{
+    using PresetLoader = std::function<SignalChain(const std::filesystem::path&)>;
+
+    struct PresetLoadResult
+    {
+        std::filesystem::path path;
+        std::optional<SignalChain> signalChain;
+        std::string error;
+    };
+
+    // Loads the files in parallel, the results are in the order of the files. Each thread works on its own share of the files
+    // and steals from the others once it's done. The loader is called concurrently.
+    std::vector<PresetLoadResult> loadPresets(std::span<const std::filesystem::path> files, const PresetLoader& loader,
+                                              std::size_t numberOfThreads = std::thread::hardware_concurrency());
+}
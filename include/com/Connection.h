@@ -20,12 +20,22 @@
 
 #pragma once
 
+#include "com/Packet.h"
+#include <algorithm>
+#include <iterator>
+#include <span>
 #include <vector>
 #include <string>
 #include <cstdint>
 
 namespace plug::com
 {
+    enum class Direction
+    {
+        send,
+        receive
+    };
+
 
     class Connection
     {
@@ -35,17 +45,50 @@ namespace plug::com
         virtual void close() = 0;
         virtual bool isOpen() const = 0;
 
-        template <class Container>
-        std::size_t send(Container c)
+        std::size_t send(std::span<const std::uint8_t> data)
         {
-            return sendImpl(c.data(), c.size());
+            return sendImpl(data.data(), data.size());
+        }
+
+        // Sends the packets in order, returns the number of packets sent completely before the first failed one.
+        // Pipelining overrides may already have sent packets after the failed one; only the returned prefix is reliable.
+        virtual std::size_t sendBatch(std::span<const PacketRawType> packets)
+        {
+            const auto failed = std::find_if(packets.begin(), packets.end(), [this](const auto& packet)
+                                             { return send(packet) != packet.size(); });
+            return static_cast<std::size_t>(std::distance(packets.begin(), failed));
         }
 
         virtual std::vector<std::uint8_t> receive(std::size_t recvSize) = 0;
 
+        virtual std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+        {
+            const auto data = receive(buffer.size());
+            const auto size = std::min(data.size(), buffer.size());
+            std::copy_n(data.cbegin(), size, buffer.begin());
+            return size;
+        }
+
+        // Appends up to count packets to the (preallocated) packets, stops early on timeout
+        std::size_t receiveMany(std::vector<PacketRawType>& packets, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto& packet = packets.emplace_back();
+
+                if (receiveInto(packet) == 0)
+                {
+                    packets.pop_back();
+                    return i;
+                }
+            }
+            return count;
+        }
+
         virtual std::string name() const = 0;
 
     private:
-        virtual std::size_t sendImpl(std::uint8_t* data, std::size_t size) = 0;
+        virtual std::size_t sendImpl(const std::uint8_t* data, std::size_t size) = 0;
     };
+
 }
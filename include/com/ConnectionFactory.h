@@ -20,7 +20,13 @@
 
 #pragma once
 
+#include "com/UsbHotplug.h"
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace plug::com
 {
@@ -28,4 +34,31 @@ namespace plug::com
 
 
     std::unique_ptr<Mustang> connect();
+    std::vector<std::unique_ptr<Mustang>> connectAll();
+#ifdef PLUG_DIAGNOSTICS
+    std::unique_ptr<Mustang> connectSimulator(std::size_t numberOfPresets, std::chrono::microseconds latency);
+#endif
+
+
+    // Tracks the amp through hotplug events; connecting uses the last arrived amp instead of scanning the bus.
+    // The listener is called on the usb event thread once an amp arrives or the tracked amp is removed.
+    class AmpWatcher
+    {
+    public:
+        using Listener = std::function<void(bool available)>;
+
+        explicit AmpWatcher(Listener listener);
+
+        bool isWatching() const;
+        bool isAvailable() const;
+        std::unique_ptr<Mustang> connect();
+
+    private:
+        void onHotplug(usb::HotplugEvent event, usb::Device device);
+
+        mutable std::mutex mutex_;
+        std::optional<usb::Device> device_;
+        Listener listener_;
+        std::unique_ptr<usb::Hotplug> hotplug_;
+    };
 }
@@ -0,0 +1,47 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace plug::com
+{
+    // Log-linear buckets (eight per power of two), the percentiles are exact up to the bucket width of 12.5 %
+    class LatencyHistogram
+    {
+    public:
+        void record(std::chrono::nanoseconds latency);
+
+        std::uint64_t count() const;
+        std::chrono::nanoseconds percentile(double p) const;
+        std::chrono::nanoseconds max() const;
+
+    private:
+        // Eight buckets for each of the 61 powers of two above the eight linear buckets
+        static constexpr std::size_t numberOfBuckets{8 + 61 * 8};
+
+        std::array<std::uint64_t, numberOfBuckets> buckets{};
+        std::uint64_t count_{0};
+        std::uint64_t max_{0};
+    };
+}
@@ -0,0 +1,228 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "effects_enum.h"
+#include "com/Packet.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace plug::com
+{
+    struct AmpModel
+    {
+        amps amp;
+        std::uint8_t id;
+        std::array<std::uint8_t, 5> unknownAmpSpecific;
+        std::uint8_t unknown;
+    };
+
+    struct EffectModel
+    {
+        effects effect;
+        std::uint16_t id;
+        std::uint16_t fileId;
+        DSP dsp;
+        bool extraKnob;
+        std::array<std::uint8_t, 3> unknown;
+    };
+
+
+    // One row per model, in the order of the enum
+    inline constexpr std::array ampModels{
+        AmpModel{amps::FENDER_57_DELUXE, 0x67, {{0x01, 0x01, 0x01, 0x01, 0x53}}, 0x80},
+        AmpModel{amps::FENDER_59_BASSMAN, 0x64, {{0x02, 0x02, 0x02, 0x02, 0x67}}, 0x80},
+        AmpModel{amps::FENDER_57_CHAMP, 0x7c, {{0x0c, 0x0c, 0x0c, 0x0c, 0x00}}, 0x80},
+        AmpModel{amps::FENDER_65_DELUXE_REVERB, 0x53, {{0x03, 0x03, 0x03, 0x03, 0x6a}}, 0x00},
+        AmpModel{amps::FENDER_65_PRINCETON, 0x6a, {{0x04, 0x04, 0x04, 0x04, 0x61}}, 0x80},
+        AmpModel{amps::FENDER_65_TWIN_REVERB, 0x75, {{0x05, 0x05, 0x05, 0x05, 0x72}}, 0x80},
+        AmpModel{amps::FENDER_SUPER_SONIC, 0x72, {{0x06, 0x06, 0x06, 0x06, 0x79}}, 0x80},
+        AmpModel{amps::BRITISH_60S, 0x61, {{0x07, 0x07, 0x07, 0x07, 0x5e}}, 0x80},
+        AmpModel{amps::BRITISH_70S, 0x79, {{0x0b, 0x0b, 0x0b, 0x0b, 0x7c}}, 0x80},
+        AmpModel{amps::BRITISH_80S, 0x5e, {{0x09, 0x09, 0x09, 0x09, 0x5d}}, 0x80},
+        AmpModel{amps::AMERICAN_90S, 0x5d, {{0x0a, 0x0a, 0x0a, 0x0a, 0x6d}}, 0x80},
+        AmpModel{amps::METAL_2000, 0x6d, {{0x08, 0x08, 0x08, 0x08, 0x75}}, 0x80},
+        AmpModel{amps::STUDIO_PREAMP, 0xf1, {{0x0d, 0x0d, 0x0d, 0x0d, 0xf6}}, 0x80},
+        AmpModel{amps::FENDER_57_TWIN, 0xf6, {{0x0e, 0x0e, 0x0e, 0x0e, 0xf9}}, 0x80},
+        AmpModel{amps::FENDER_60_THRIFT, 0xf9, {{0x0f, 0x0f, 0x0f, 0x0f, 0xfc}}, 0x80},
+        AmpModel{amps::BRITISH_COLOUR, 0xfc, {{0x10, 0x10, 0x10, 0x10, 0xff}}, 0x80},
+        AmpModel{amps::BRITISH_WATTS, 0xff, {{0x11, 0x11, 0x11, 0x11, 0x00}}, 0x80}};
+
+    // One row per model, in the order of the enum; fileId is the id used by FUSE preset files
+    inline constexpr std::array effectModels{
+        EffectModel{effects::EMPTY, 0x00, 0x00, DSP::none, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::OVERDRIVE, 0x3c, 0x3c, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::WAH, 0x49, 0x49, DSP::effect0, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::TOUCH_WAH, 0x4a, 0x4a, DSP::effect0, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::FUZZ, 0x1a, 0x1a, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::FUZZ_TOUCH_WAH, 0x1c, 0x1c, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::SIMPLE_COMP, 0x88, 0x88, DSP::effect0, false, {{0x08, 0x08, 0x01}}},
+        EffectModel{effects::COMPRESSOR, 0x07, 0x07, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::RANGER_BOOST, 0x103, 0x103, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::GREENBOX, 0xba, 0xba, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::ORANGEBOX, 0x110, 0x110, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::BLACKBOX, 0x111, 0x111, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::BIG_FUZZ, 0x10f, 0x10f, DSP::effect0, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::SINE_CHORUS, 0x12, 0x12, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::TRIANGLE_CHORUS, 0x13, 0x13, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::SINE_FLANGER, 0x18, 0x18, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::TRIANGLE_FLANGER, 0x19, 0x19, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::VIBRATONE, 0x2d, 0x2d, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::VINTAGE_TREMOLO, 0x40, 0x40, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::SINE_TREMOLO, 0x41, 0x41, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::RING_MODULATOR, 0x22, 0x22, DSP::effect1, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::STEP_FILTER, 0x29, 0x29, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::PHASER, 0x4f, 0x4f, DSP::effect1, false, {{0x01, 0x01, 0x01}}},
+        EffectModel{effects::PITCH_SHIFTER, 0x1f, 0x1f, DSP::effect1, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::WAH_MOD, 0xf4, 0xf4, DSP::effect1, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::TOUCH_WAH_MOD, 0xf5, 0xf5, DSP::effect1, false, {{0x01, 0x08, 0x01}}},
+        EffectModel{effects::DIATONIC_PITCH_SHIFTER, 0x101f, 0x11f, DSP::effect1, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::MONO_DELAY, 0x16, 0x16, DSP::effect2, false, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::MONO_ECHO_FILTER, 0x43, 0x43, DSP::effect2, true, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::STEREO_ECHO_FILTER, 0x48, 0x48, DSP::effect2, true, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::MULTITAP_DELAY, 0x44, 0x44, DSP::effect2, false, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::PING_PONG_DELAY, 0x45, 0x45, DSP::effect2, false, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::DUCKING_DELAY, 0x15, 0x15, DSP::effect2, false, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::REVERSE_DELAY, 0x46, 0x46, DSP::effect2, false, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::TAPE_DELAY, 0x2b, 0x2b, DSP::effect2, true, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::STEREO_TAPE_DELAY, 0x2a, 0x2a, DSP::effect2, true, {{0x02, 0x01, 0x01}}},
+        EffectModel{effects::SMALL_HALL_REVERB, 0x24, 0x24, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::LARGE_HALL_REVERB, 0x3a, 0x3a, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::SMALL_ROOM_REVERB, 0x26, 0x26, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::LARGE_ROOM_REVERB, 0x3b, 0x3b, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::SMALL_PLATE_REVERB, 0x4e, 0x4e, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::LARGE_PLATE_REVERB, 0x4b, 0x4b, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::AMBIENT_REVERB, 0x4c, 0x4c, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::ARENA_REVERB, 0x4d, 0x4d, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::FENDER_63_SPRING_REVERB, 0x21, 0x21, DSP::effect3, false, {{0x00, 0x08, 0x01}}},
+        EffectModel{effects::FENDER_65_SPRING_REVERB, 0x0b, 0x0b, DSP::effect3, false, {{0x00, 0x08, 0x01}}}};
+
+
+    namespace detail
+    {
+        template <class Models, class Enum>
+        constexpr bool isInEnumOrder(const Models& models, Enum Models::value_type::* key)
+        {
+            std::size_t i{0};
+            return std::all_of(models.cbegin(), models.cend(), [&i, key](const auto& model)
+                               { return static_cast<std::size_t>(std::invoke(key, model)) == i++; });
+        }
+
+        template <class Models, class Id>
+        constexpr std::size_t maxId(const Models& models, Id Models::value_type::* key)
+        {
+            return std::invoke(key, *std::max_element(models.cbegin(), models.cend(), [key](const auto& lhs, const auto& rhs)
+                                                      { return std::invoke(key, lhs) < std::invoke(key, rhs); }));
+        }
+
+        // Maps each id to the index of its row, -1 if there is none
+        template <std::size_t Size, class Models, class Id>
+        constexpr std::array<std::int16_t, Size> makeIdIndex(const Models& models, Id Models::value_type::* key)
+        {
+            std::array<std::int16_t, Size> index{};
+            index.fill(-1);
+
+            for (std::size_t i = 0; i < models.size(); ++i)
+            {
+                index[std::invoke(key, models[i])] = static_cast<std::int16_t>(i);
+            }
+            return index;
+        }
+
+        template <class Models, class Id>
+        constexpr bool hasUniqueIds(const Models& models, Id Models::value_type::* key)
+        {
+            return std::all_of(models.cbegin(), models.cend(), [&models, key](const auto& model)
+                               { return std::count_if(models.cbegin(), models.cend(), [&model, key](const auto& other)
+                                                      { return std::invoke(key, other) == std::invoke(key, model); }) == 1; });
+        }
+
+        template <class Index, class Models>
+        constexpr std::optional<typename Models::value_type> findById(const Index& index, const Models& models, std::size_t id)
+        {
+            if ((id >= index.size()) || (index[id] < 0))
+            {
+                return std::nullopt;
+            }
+            return models[static_cast<std::size_t>(index[id])];
+        }
+
+
+        inline constexpr auto ampIdIndex = makeIdIndex<maxId(ampModels, &AmpModel::id) + 1>(ampModels, &AmpModel::id);
+        inline constexpr auto effectIdIndex = makeIdIndex<maxId(effectModels, &EffectModel::id) + 1>(effectModels, &EffectModel::id);
+        inline constexpr auto effectFileIdIndex = makeIdIndex<maxId(effectModels, &EffectModel::fileId) + 1>(effectModels, &EffectModel::fileId);
+    }
+
+    static_assert(detail::isInEnumOrder(ampModels, &AmpModel::amp), "Amp models have to be in enum order");
+    static_assert(detail::isInEnumOrder(effectModels, &EffectModel::effect), "Effect models have to be in enum order");
+    static_assert(detail::hasUniqueIds(ampModels, &AmpModel::id), "Amp ids have to be unique");
+    static_assert(detail::hasUniqueIds(effectModels, &EffectModel::id), "Effect ids have to be unique");
+    static_assert(detail::hasUniqueIds(effectModels, &EffectModel::fileId), "Effect file ids have to be unique");
+
+
+    constexpr bool isKnownAmp(amps amp)
+    {
+        return static_cast<std::size_t>(amp) < ampModels.size();
+    }
+
+    constexpr bool isKnownEffect(effects effect)
+    {
+        return static_cast<std::size_t>(effect) < effectModels.size();
+    }
+
+    constexpr const AmpModel& ampModel(amps amp)
+    {
+        if (!isKnownAmp(amp))
+        {
+            throw std::invalid_argument{"Invalid amp: " + std::to_string(static_cast<std::size_t>(amp))};
+        }
+        return ampModels[static_cast<std::size_t>(amp)];
+    }
+
+    constexpr const EffectModel& effectModel(effects effect)
+    {
+        if (!isKnownEffect(effect))
+        {
+            throw std::invalid_argument{"Invalid effect: " + std::to_string(static_cast<std::size_t>(effect))};
+        }
+        return effectModels[static_cast<std::size_t>(effect)];
+    }
+
+    constexpr std::optional<AmpModel> findAmpById(std::size_t id)
+    {
+        return detail::findById(detail::ampIdIndex, ampModels, id);
+    }
+
+    constexpr std::optional<EffectModel> findEffectById(std::size_t id)
+    {
+        return detail::findById(detail::effectIdIndex, effectModels, id);
+    }
+
+    constexpr std::optional<EffectModel> findEffectByFileId(std::size_t id)
+    {
+        return detail::findById(detail::effectFileIdIndex, effectModels, id);
+    }
+}
@@ -23,10 +23,17 @@
 
 #include "SignalChain.h"
 #include "DeviceModel.h"
+#include "com/AmpBackup.h"
 #include "com/Connection.h"
+#include "com/OperationObserver.h"
+#include "com/Packet.h"
+#include <ostream>
+#include <span>
 #include <string_view>
 #include <vector>
+#include <map>
 #include <memory>
+#include <optional>
 #include <cstdint>
 
 namespace plug::com
@@ -40,7 +47,7 @@ namespace plug::com
     class Mustang
     {
     public:
-        Mustang(DeviceModel deviceModel, std::shared_ptr<Connection> connection);
+        Mustang(DeviceModel deviceModel, std::shared_ptr<Connection> connection, std::shared_ptr<OperationObserver> observer = nullptr);
         Mustang(const Mustang&) = delete;
 
         InitialData start_amp();
@@ -49,7 +56,10 @@ namespace plug::com
         void set_amplifier(amp_settings value);
         void save_on_amp(std::string_view name, std::uint8_t slot);
         SignalChain load_memory_bank(std::uint8_t slot);
+        void select_memory_bank(std::uint8_t slot);
         void save_effects(std::uint8_t slot, std::string_view name, const std::vector<fx_pedal_settings>& effects);
+        void backupAll(std::ostream& out);
+        void restoreAll(const AmpBackup& backup);
 
         DeviceModel getDeviceModel() const;
 
@@ -58,10 +68,28 @@ namespace plug::com
 
 
     private:
+        struct Dump
+        {
+            std::vector<PacketRawType> packets;
+            std::size_t numberOfPresetPackets;
+        };
+
         InitialData loadData();
+        Dump receiveDump();
+        void restoreKnobPresets(std::span<const PacketRawType> packets);
         void initializeAmp();
+        void resetShadowState();
 
         const DeviceModel model;
         const std::shared_ptr<Connection> conn;
+        const std::shared_ptr<OperationObserver> observer;
+
+        // Last settings packets confirmed by the device; unchanged packets are not sent again
+        std::optional<PacketRawType> ampShadow;
+        std::optional<PacketRawType> usbGainShadow;
+        std::map<std::uint8_t, std::optional<PacketRawType>> effectShadows;
+
+        // Preset selected on the amp as reported by start_amp() and changed by the bank operations
+        std::optional<std::uint8_t> selectedSlot;
     };
 }
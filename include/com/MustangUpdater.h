@@ -19,9 +19,33 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #pragma once
 
+#include "com/Connection.h"
+#include "com/Packet.h"
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stop_token>
+#include <string>
+
 namespace plug::com
 {
-    int updateFirmware(const char* filename);
+    enum class UpdateStatus
+    {
+        finished,
+        cancelled
+    };
+
+    // Called with the number of packets sent and the total number of packets
+    using UpdateProgress = std::function<void(std::size_t, std::size_t)>;
+
+    // Date, firmware data chunks and the finished packet
+    std::size_t numberOfFirmwarePackets(std::span<const std::uint8_t> firmware);
+    PacketRawType serializeFirmwarePacket(std::span<const std::uint8_t> firmware, std::size_t index);
+
+    // Streams the firmware, each packet is sent as soon as the previous one is acknowledged; a cancelled update leaves the amp in update mode
+    UpdateStatus updateFirmware(Connection& conn, std::span<const std::uint8_t> firmware, const UpdateProgress& progress, std::stop_token stopToken);
+    UpdateStatus updateFirmware(const std::string& filename, const UpdateProgress& progress, std::stop_token stopToken);
 }
@@ -0,0 +1,80 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <exception>
+
+namespace plug::com
+{
+    enum class Operation
+    {
+        startAmp,
+        setEffect,
+        setAmplifier,
+        loadMemoryBank,
+        saveOnAmp
+    };
+
+
+    // Notified of the amp operations; operations may be nested, each begin is followed by its end in reverse order
+    class OperationObserver
+    {
+    public:
+        virtual ~OperationObserver() = default;
+
+        virtual void beginOperation(Operation operation) = 0;
+        virtual void endOperation(Operation operation, std::chrono::steady_clock::duration duration, bool failed) = 0;
+    };
+
+
+    // Reports the operation to the observer (if any) on destruction, operations left by an exception count as failed
+    class OperationScope
+    {
+    public:
+        OperationScope(OperationObserver* observer, Operation operation)
+            : observer_(observer), operation_(operation), start_(std::chrono::steady_clock::now()), uncaughtExceptions_(std::uncaught_exceptions())
+        {
+            if (observer_ != nullptr)
+            {
+                observer_->beginOperation(operation_);
+            }
+        }
+
+        OperationScope(const OperationScope&) = delete;
+
+        ~OperationScope()
+        {
+            if (observer_ != nullptr)
+            {
+                observer_->endOperation(operation_, std::chrono::steady_clock::now() - start_, std::uncaught_exceptions() > uncaughtExceptions_);
+            }
+        }
+
+        OperationScope& operator=(const OperationScope&) = delete;
+
+    private:
+        OperationObserver* observer_;
+        Operation operation_;
+        std::chrono::steady_clock::time_point start_;
+        int uncaughtExceptions_;
+    };
+}
@@ -24,9 +24,11 @@
 #include "data_structs.h"
 #include "effects_enum.h"
 #include "com/Packet.h"
+#include "com/PacketView.h"
 #include <string>
 #include <vector>
 #include <array>
+#include <span>
 #include <cstdint>
 
 namespace plug::com
@@ -40,10 +42,14 @@ namespace plug::com
     }
 
     std::string decodeNameFromData(const Packet<NamePayload>& packet);
+    std::string decodeNameFromData(const PacketView<NamePayload>& packet);
     amp_settings decodeAmpFromData(const Packet<AmpPayload>& packet, const Packet<AmpPayload>& packetUsbGain);
+    amp_settings decodeAmpFromData(const PacketView<AmpPayload>& packet, const PacketView<AmpPayload>& packetUsbGain);
 
     std::vector<fx_pedal_settings> decodeEffectsFromData(const std::array<Packet<EffectPayload>, 4>& packet);
+    std::vector<fx_pedal_settings> decodeEffectsFromData(const std::array<PacketView<EffectPayload>, 4>& packet);
     std::vector<std::string> decodePresetListFromData(const std::vector<Packet<NamePayload>>& packet);
+    std::vector<std::string> decodePresetListFromData(std::span<const PacketRawType> packets);
 
     Packet<AmpPayload> serializeAmpSettings(const amp_settings& value);
     Packet<AmpPayload> serializeAmpSettingsUsbGain(const amp_settings& value);
@@ -0,0 +1,317 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Packet.h"
+#include <span>
+#include <string>
+#include <cstdint>
+
+namespace plug::com
+{
+    namespace layout
+    {
+        inline constexpr std::size_t headerSize{16};
+        inline constexpr std::size_t payloadSize{packetRawTypeSize - headerSize};
+
+        // Offsets relative to the header
+        namespace header
+        {
+            inline constexpr std::size_t stage{0};
+            inline constexpr std::size_t type{1};
+            inline constexpr std::size_t dsp{2};
+            inline constexpr std::size_t slot{4};
+        }
+
+        // Offsets relative to the payload
+        namespace name
+        {
+            inline constexpr std::size_t name{0};
+            inline constexpr std::size_t length{32};
+        }
+
+        namespace effect
+        {
+            inline constexpr std::size_t modelLow{0};
+            inline constexpr std::size_t modelHigh{1};
+            inline constexpr std::size_t slot{2};
+            inline constexpr std::size_t knob1{16};
+            inline constexpr std::size_t knob2{17};
+            inline constexpr std::size_t knob3{18};
+            inline constexpr std::size_t knob4{19};
+            inline constexpr std::size_t knob5{20};
+            inline constexpr std::size_t knob6{21};
+        }
+
+        namespace amp
+        {
+            inline constexpr std::size_t model{0};
+            inline constexpr std::size_t usbGain{0};
+            inline constexpr std::size_t volume{16};
+            inline constexpr std::size_t gain{17};
+            inline constexpr std::size_t gain2{18};
+            inline constexpr std::size_t masterVolume{19};
+            inline constexpr std::size_t treble{20};
+            inline constexpr std::size_t middle{21};
+            inline constexpr std::size_t bass{22};
+            inline constexpr std::size_t presence{23};
+            inline constexpr std::size_t depth{25};
+            inline constexpr std::size_t bias{26};
+            inline constexpr std::size_t noiseGate{31};
+            inline constexpr std::size_t threshold{32};
+            inline constexpr std::size_t cabinet{33};
+            inline constexpr std::size_t sag{35};
+            inline constexpr std::size_t brightness{36};
+        }
+    }
+
+
+    // Non-owning views, the fields are read in place from the viewed bytes; the viewed data has to outlive the view
+
+    class HeaderView
+    {
+    public:
+        constexpr explicit HeaderView(std::span<const std::uint8_t, layout::headerSize> data)
+            : bytes(data)
+        {
+        }
+
+        Stage getStage() const;
+        Type getType() const;
+        DSP getDSP() const;
+
+        constexpr std::uint8_t getSlot() const
+        {
+            return bytes[layout::header::slot];
+        }
+
+    private:
+        std::span<const std::uint8_t, layout::headerSize> bytes;
+    };
+
+
+    class PayloadView
+    {
+    public:
+        constexpr explicit PayloadView(std::span<const std::uint8_t, layout::payloadSize> data)
+            : bytes(data)
+        {
+        }
+
+    protected:
+        std::span<const std::uint8_t, layout::payloadSize> bytes;
+    };
+
+    class NamePayloadView : public PayloadView
+    {
+    public:
+        using PayloadView::PayloadView;
+
+        std::string getName() const;
+    };
+
+    class EffectPayloadView : public PayloadView
+    {
+    public:
+        using PayloadView::PayloadView;
+
+        constexpr std::uint8_t getKnob1() const
+        {
+            return bytes[layout::effect::knob1];
+        }
+
+        constexpr std::uint8_t getKnob2() const
+        {
+            return bytes[layout::effect::knob2];
+        }
+
+        constexpr std::uint8_t getKnob3() const
+        {
+            return bytes[layout::effect::knob3];
+        }
+
+        constexpr std::uint8_t getKnob4() const
+        {
+            return bytes[layout::effect::knob4];
+        }
+
+        constexpr std::uint8_t getKnob5() const
+        {
+            return bytes[layout::effect::knob5];
+        }
+
+        constexpr std::uint8_t getKnob6() const
+        {
+            return bytes[layout::effect::knob6];
+        }
+
+        constexpr std::uint8_t getSlot() const
+        {
+            return bytes[layout::effect::slot];
+        }
+
+        constexpr std::uint16_t getModel() const
+        {
+            return static_cast<std::uint16_t>(bytes[layout::effect::modelHigh] << 8 | bytes[layout::effect::modelLow]);
+        }
+    };
+
+    class AmpPayloadView : public PayloadView
+    {
+    public:
+        using PayloadView::PayloadView;
+
+        constexpr std::uint8_t getModel() const
+        {
+            return bytes[layout::amp::model];
+        }
+
+        constexpr std::uint8_t getVolume() const
+        {
+            return bytes[layout::amp::volume];
+        }
+
+        constexpr std::uint8_t getGain() const
+        {
+            return bytes[layout::amp::gain];
+        }
+
+        constexpr std::uint8_t getGain2() const
+        {
+            return bytes[layout::amp::gain2];
+        }
+
+        constexpr std::uint8_t getMasterVolume() const
+        {
+            return bytes[layout::amp::masterVolume];
+        }
+
+        constexpr std::uint8_t getTreble() const
+        {
+            return bytes[layout::amp::treble];
+        }
+
+        constexpr std::uint8_t getMiddle() const
+        {
+            return bytes[layout::amp::middle];
+        }
+
+        constexpr std::uint8_t getBass() const
+        {
+            return bytes[layout::amp::bass];
+        }
+
+        constexpr std::uint8_t getPresence() const
+        {
+            return bytes[layout::amp::presence];
+        }
+
+        constexpr std::uint8_t getDepth() const
+        {
+            return bytes[layout::amp::depth];
+        }
+
+        constexpr std::uint8_t getBias() const
+        {
+            return bytes[layout::amp::bias];
+        }
+
+        constexpr std::uint8_t getNoiseGate() const
+        {
+            return bytes[layout::amp::noiseGate];
+        }
+
+        constexpr std::uint8_t getThreshold() const
+        {
+            return bytes[layout::amp::threshold];
+        }
+
+        constexpr std::uint8_t getCabinet() const
+        {
+            return bytes[layout::amp::cabinet];
+        }
+
+        constexpr std::uint8_t getSag() const
+        {
+            return bytes[layout::amp::sag];
+        }
+
+        constexpr std::uint8_t getBrightness() const
+        {
+            return bytes[layout::amp::brightness];
+        }
+
+        constexpr std::uint8_t getUsbGain() const
+        {
+            return bytes[layout::amp::usbGain];
+        }
+    };
+
+
+    template <class Payload>
+    struct PayloadViewType;
+
+    template <>
+    struct PayloadViewType<NamePayload>
+    {
+        using type = NamePayloadView;
+    };
+
+    template <>
+    struct PayloadViewType<EffectPayload>
+    {
+        using type = EffectPayloadView;
+    };
+
+    template <>
+    struct PayloadViewType<AmpPayload>
+    {
+        using type = AmpPayloadView;
+    };
+
+
+    template <class Payload>
+    class PacketView
+    {
+    public:
+        using View = typename PayloadViewType<Payload>::type;
+
+        constexpr explicit PacketView(const PacketRawType& data)
+            : bytes(data)
+        {
+        }
+
+        PacketView(PacketRawType&&) = delete;
+
+        constexpr HeaderView getHeader() const
+        {
+            return HeaderView{bytes.template first<layout::headerSize>()};
+        }
+
+        constexpr View getPayload() const
+        {
+            return View{bytes.template subspan<layout::headerSize>()};
+        }
+
+    private:
+        std::span<const std::uint8_t, packetRawTypeSize> bytes;
+    };
+}
@@ -0,0 +1,50 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include "com/MappedFile.h"
+#include "com/PresetRecord.h"
+#include <ostream>
+#include <span>
+#include <string>
+
+namespace plug::com
+{
+    void writePresetBank(std::ostream& out, std::span<const SignalChain> presets);
+
+    // Read-only, memory mapped bank of fixed size preset records; a preset is decoded on access without parsing the whole file
+    class PresetBank
+    {
+    public:
+        explicit PresetBank(const std::string& path);
+
+        std::size_t size() const;
+        std::string name(std::size_t index) const;
+        SignalChain at(std::size_t index) const;
+
+    private:
+        std::span<const std::uint8_t, presetRecordSize> record(std::size_t index) const;
+
+        MappedFile file_;
+        std::size_t size_;
+    };
+}
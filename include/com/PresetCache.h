@@ -0,0 +1,43 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace plug::com
+{
+    // Decoded memory banks by slot, valid as long as the banks aren't changed on the amp
+    class PresetCache
+    {
+    public:
+        std::optional<SignalChain> get(std::uint8_t slot) const;
+        void put(std::uint8_t slot, const SignalChain& signalChain);
+
+        void invalidate(std::uint8_t slot);
+        void clear();
+
+    private:
+        std::map<std::uint8_t, SignalChain> presets;
+    };
+}
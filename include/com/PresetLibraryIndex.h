@@ -0,0 +1,62 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include "com/BulkPresetLoader.h"
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace plug::com
+{
+    // Decoded preset files of a library directory, keyed by path, modification time and size; only new or changed files are loaded (in parallel) on refresh
+    class PresetLibraryIndex
+    {
+    public:
+        using Loader = PresetLoader;
+
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::int64_t modified;
+            std::uintmax_t size;
+            SignalChain signalChain;
+        };
+
+        bool refresh(const std::filesystem::path& directory, const Loader& loader);
+        std::optional<SignalChain> refreshFile(const std::filesystem::path& file, const Loader& loader);
+
+        std::optional<SignalChain> get(const std::filesystem::path& file) const;
+        std::vector<Entry> entries() const;
+        std::size_t size() const;
+
+        void save(std::ostream& out) const;
+        bool load(std::istream& in);
+
+    private:
+        std::map<std::filesystem::path, Entry> entries_;
+    };
+}
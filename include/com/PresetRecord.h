@@ -0,0 +1,50 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SignalChain.h"
+#include "data_structs.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace plug::com
+{
+    // Fixed size, position independent encoding of presets; shared by preset banks and the daemon protocol
+    inline constexpr std::size_t presetNameSize{32};
+    inline constexpr std::size_t ampRecordSize{17};
+    inline constexpr std::size_t effectRecordSize{9};
+    inline constexpr std::size_t presetRecordSize{128};
+
+    using AmpRecord = std::array<std::uint8_t, ampRecordSize>;
+    using EffectRecord = std::array<std::uint8_t, effectRecordSize>;
+    using PresetRecord = std::array<std::uint8_t, presetRecordSize>;
+
+    AmpRecord encodeAmpRecord(const amp_settings& amp);
+    amp_settings decodeAmpRecord(std::span<const std::uint8_t, ampRecordSize> data);
+
+    EffectRecord encodeEffectRecord(const fx_pedal_settings& effect);
+    fx_pedal_settings decodeEffectRecord(std::span<const std::uint8_t, effectRecordSize> data);
+
+    PresetRecord encodePresetRecord(const SignalChain& preset);
+    std::string decodePresetRecordName(std::span<const std::uint8_t, presetRecordSize> data);
+    SignalChain decodePresetRecord(std::span<const std::uint8_t, presetRecordSize> data);
+}
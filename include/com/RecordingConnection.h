@@ -0,0 +1,55 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Connection.h"
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <ostream>
+
+namespace plug::com
+{
+    // Writes every packet sent and received through the wrapped connection to a session recording
+    class RecordingConnection : public Connection
+    {
+    public:
+        RecordingConnection(std::shared_ptr<Connection> connection, std::unique_ptr<std::ostream> out);
+
+        void close() override;
+        bool isOpen() const override;
+        std::size_t sendBatch(std::span<const PacketRawType> packets) override;
+        std::vector<std::uint8_t> receive(std::size_t recvSize) override;
+        std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer) override;
+        std::string name() const override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override;
+
+        void record(Direction direction, std::span<const std::uint8_t> data);
+
+        const std::shared_ptr<Connection> conn;
+        const std::unique_ptr<std::ostream> out_;
+        std::optional<Clock::time_point> last_;
+    };
+}
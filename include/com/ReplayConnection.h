@@ -0,0 +1,61 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Connection.h"
+#include "com/SessionRecording.h"
+#include <vector>
+
+namespace plug::com
+{
+    enum class ReplaySpeed
+    {
+        original,
+        asFastAsPossible
+    };
+
+    // Plays a session recording back; sends consume the next recorded send, receives return the recorded
+    // responses in order and time out if the recording expects a send (or is exhausted)
+    class ReplayConnection : public Connection
+    {
+    public:
+        ReplayConnection(std::vector<RecordedPacket> recording, ReplaySpeed speed);
+
+        void close() override;
+        bool isOpen() const override;
+        std::vector<std::uint8_t> receive(std::size_t recvSize) override;
+        std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer) override;
+        std::string name() const override;
+
+        void rewind();
+        bool finished() const;
+
+    private:
+        std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override;
+
+        const RecordedPacket* next(Direction direction);
+
+        const std::vector<RecordedPacket> recording_;
+        const ReplaySpeed speed_;
+        std::size_t position_;
+        bool open_;
+    };
+}
@@ -0,0 +1,63 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "data_structs.h"
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace plug::com
+{
+    class Mustang;
+
+    // Effects are kept in the order of their first update, a later update of the same slot replaces the value in place
+    struct PendingSettings
+    {
+        std::vector<fx_pedal_settings> effects;
+        std::optional<amp_settings> amp;
+    };
+
+    void sendSettings(Mustang& mustang, const PendingSettings& settings);
+
+    // Keeps only the latest pending settings per amp / effect slot; timeUntilFlush() limits the flushes to one per interval
+    class SettingsCoalescer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit SettingsCoalescer(std::chrono::milliseconds minInterval);
+
+        void update(const amp_settings& value);
+        void update(const fx_pedal_settings& value);
+
+        bool hasPending() const;
+        Clock::duration timeUntilFlush(Clock::time_point now) const;
+
+        PendingSettings take(Clock::time_point now);
+        void discard();
+
+    private:
+        std::chrono::milliseconds minInterval_;
+        std::optional<Clock::time_point> lastFlush_;
+        PendingSettings pending_;
+    };
+}
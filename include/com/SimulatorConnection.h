@@ -0,0 +1,82 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Connection.h"
+#include "com/Packet.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace plug::com
+{
+    // Virtual amp answering the packets as described in doc/Technicalities.md; keeps the preset slots, the current
+    // state and the Mod / Dly/Rev knob presets. Each received packet is delayed by the latency.
+    class SimulatorConnection : public Connection
+    {
+    public:
+        SimulatorConnection(std::size_t numberOfPresets, std::chrono::microseconds latency);
+
+        void close() override;
+        bool isOpen() const override;
+        std::vector<std::uint8_t> receive(std::size_t recvSize) override;
+        std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer) override;
+        std::string name() const override;
+
+    private:
+        // Name, amp, four effects and USB gain
+        using Bank = std::array<PacketRawType, 7>;
+
+        struct KnobPreset
+        {
+            std::uint8_t knob;
+            std::uint8_t slot;
+            PacketRawType name;
+            std::vector<PacketRawType> effects;
+        };
+
+        std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override;
+
+        void handle(const PacketRawType& packet);
+        void sendPresets();
+        void sendBank(const Bank& bank);
+        void sendKnobPresets(std::uint8_t knob, const std::vector<KnobPreset>& presets, std::size_t numberOfEffects);
+        void selectBank(std::uint8_t slot);
+        void save(const PacketRawType& packet);
+        void apply();
+        void commitKnobPreset();
+
+        const std::chrono::microseconds latency_;
+        bool open_;
+        std::vector<Bank> presets_;
+        Bank current_;
+        std::uint8_t currentSlot_;
+        std::vector<KnobPreset> modPresets_;
+        std::vector<KnobPreset> dlyRevPresets_;
+        std::map<DSP, PacketRawType> pendingSettings_;
+        std::optional<KnobPreset> pendingKnobPreset_;
+        std::deque<PacketRawType> responses_;
+    };
+}
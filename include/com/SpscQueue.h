@@ -0,0 +1,90 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace plug::com
+{
+    // Bounded lock-free queue for exactly one producer and one consumer thread
+    template <class T, std::size_t Capacity>
+    class SpscQueue
+    {
+        static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two");
+
+    public:
+        SpscQueue() = default;
+        SpscQueue(const SpscQueue&) = delete;
+
+        bool tryPush(T value)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+
+            if ((tail - head_.load(std::memory_order_acquire)) == Capacity)
+            {
+                return false;
+            }
+
+            buffer_[tail & mask] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> tryPop()
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+
+            if (head == tail_.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+
+            std::optional<T> value{std::move(buffer_[head & mask])};
+            buffer_[head & mask] = T{};
+            head_.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        bool empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return Capacity;
+        }
+
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+    private:
+        static constexpr std::size_t mask{Capacity - 1};
+        static constexpr std::size_t cacheLineSize{64};
+
+        std::array<T, Capacity> buffer_{};
+        alignas(cacheLineSize) std::atomic<std::size_t> head_{0};
+        alignas(cacheLineSize) std::atomic<std::size_t> tail_{0};
+    };
+}
@@ -0,0 +1,125 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Connection.h"
+#include "com/LatencyHistogram.h"
+#include "com/OperationObserver.h"
+#include "com/Packet.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace plug::com
+{
+    std::string_view operationName(Operation operation);
+
+
+    struct TracedHeader
+    {
+        Stage stage;
+        std::optional<Type> type;
+        std::optional<DSP> dsp;
+        std::uint8_t slot;
+    };
+
+    struct TraceEvent
+    {
+        std::chrono::steady_clock::time_point time;
+        Direction direction;
+        std::size_t packets;
+        std::size_t bytes;
+        std::chrono::nanoseconds duration;
+        std::optional<TracedHeader> header;
+        bool timeout;
+        std::optional<Operation> operation;
+    };
+
+    struct LatencySummary
+    {
+        std::uint64_t count;
+        std::uint64_t failures;
+        std::chrono::nanoseconds p50;
+        std::chrono::nanoseconds p99;
+        std::chrono::nanoseconds max;
+    };
+
+
+    // Records the traffic of the wrapped connection and, as the observer of a Mustang, the latency of its operations;
+    // the traffic is attributed to the innermost running operation
+    class TracingConnection : public Connection, public OperationObserver
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // The last eventCapacity events are kept; the statistics are written to dumpOnExit (if set) on destruction
+        TracingConnection(std::shared_ptr<Connection> connection, std::size_t eventCapacity, std::ostream* dumpOnExit = nullptr);
+        TracingConnection(const TracingConnection&) = delete;
+        ~TracingConnection() override;
+
+        void close() override;
+        bool isOpen() const override;
+        std::size_t sendBatch(std::span<const PacketRawType> packets) override;
+        std::vector<std::uint8_t> receive(std::size_t recvSize) override;
+        std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer) override;
+        std::string name() const override;
+
+        void beginOperation(Operation operation) override;
+        void endOperation(Operation operation, Clock::duration duration, bool failed) override;
+
+        LatencySummary statistics(Operation operation) const;
+        LatencySummary statistics(Direction direction) const;
+        std::vector<TraceEvent> events() const;
+        void dump(std::ostream& out) const;
+
+        TracingConnection& operator=(const TracingConnection&) = delete;
+
+    private:
+        std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override;
+
+        void record(Direction direction, Clock::time_point start, std::span<const std::uint8_t> header, std::size_t bytes, std::size_t packets, bool timeout);
+
+        static constexpr std::size_t numberOfOperations{5};
+
+        struct Statistics
+        {
+            LatencyHistogram histogram;
+            std::uint64_t failures{0};
+        };
+
+        const std::shared_ptr<Connection> conn;
+        const std::size_t eventCapacity_;
+        std::ostream* const dumpOnExit_;
+
+        mutable std::mutex mutex_;
+        std::vector<Operation> running_;
+        std::deque<TraceEvent> events_;
+        std::array<Statistics, numberOfOperations> operations_;
+        std::array<Statistics, 2> wire_;
+    };
+}
@@ -36,11 +36,15 @@ namespace plug::com
         bool isOpen() const override;
 
         std::vector<std::uint8_t> receive(std::size_t recvSize) override;
+        std::size_t receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer) override;
+
+        // All transfers are submitted before the first result is known, so packets behind a failed one may still be sent
+        std::size_t sendBatch(std::span<const PacketRawType> packets) override;
 
         std::string name() const override;
 
     private:
-        std::size_t sendImpl(std::uint8_t* data, std::size_t size) override;
+        std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override;
 
         usb::Device device_;
         const std::string name_;
@@ -21,6 +21,10 @@
 #pragma once
 
 #include <com/UsbDevice.h>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace plug::com::usb
@@ -37,8 +41,18 @@ namespace plug::com::usb
     private:
         void init();
         void deinit();
+        void startEventHandling();
+        void stopEventHandling();
+
+        std::jthread eventThread_;
     };
 
+    using DeviceFilter = std::function<bool(std::uint16_t vendorId, std::uint16_t productId)>;
+
     std::vector<Device> listDevices();
 
+    // Only devices accepted by the filter are referenced; devices without readable descriptor are skipped
+    std::vector<Device> listDevices(const DeviceFilter& filter);
+    std::optional<Device> findDevice(const DeviceFilter& filter);
+
 }
@@ -23,13 +23,19 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <span>
 
 struct libusb_device;
+struct libusb_device_descriptor;
 struct libusb_device_handle;
 
 namespace plug::com::usb
 {
+    class ReceiveQueue;
+
+
     template <auto Fn>
     struct ReleaseFunction
     {
@@ -48,6 +54,7 @@ namespace plug::com::usb
     {
         void releaseDevice(libusb_device* device);
         void releaseHandle(libusb_device_handle* handle);
+        void releaseReceiveQueue(ReceiveQueue* queue);
     }
 
 
@@ -55,6 +62,7 @@ namespace plug::com::usb
     {
     public:
         explicit Device(libusb_device* device);
+        Device(libusb_device* device, const libusb_device_descriptor& descriptor);
         Device(Device&&) = default;
 
         void open();
@@ -65,8 +73,23 @@ namespace plug::com::usb
         std::uint16_t productId() const noexcept;
         std::string name() const;
 
-        std::size_t write(std::uint8_t endpoint, std::uint8_t* data, std::size_t dataSize);
+        // Identifies the physical device, e.g. to match removals
+        libusb_device* native() const noexcept
+        {
+            return device_.get();
+        }
+
+        std::size_t write(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize);
         std::vector<std::uint8_t> receive(std::uint8_t endpoint, std::size_t dataSize);
+        std::size_t receiveInto(std::uint8_t endpoint, std::span<std::uint8_t> buffer);
+
+        // The data is copied; the transfer completes even if the returned future is dropped
+        std::future<std::size_t> writeAsync(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize);
+        void startReceiving(std::uint8_t endpoint, std::size_t packetSize);
+        void stopReceiving();
+
+        // Packets dropped by the receive queue since receiving started
+        std::size_t droppedPackets() const;
 
         Device& operator=(Device&&) = default;
 
@@ -83,6 +106,7 @@ namespace plug::com::usb
 
         Ressource<libusb_device, detail::releaseDevice> device_;
         Ressource<libusb_device_handle, detail::releaseHandle> handle_;
+        Ressource<ReceiveQueue, detail::releaseReceiveQueue> receiveQueue_;
         Descriptor descriptor_;
     };
 }
@@ -0,0 +1,55 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/UsbDevice.h"
+#include <cstdint>
+#include <functional>
+
+namespace plug::com::usb
+{
+    enum class HotplugEvent
+    {
+        Arrived,
+        Left
+    };
+
+    bool hasHotplugSupport();
+
+
+    // Reports arrival and removal of the vendor's devices, devices already connected are reported on registration;
+    // the callback runs on the event handling thread of the Context and must not do blocking I/O on the device
+    class Hotplug
+    {
+    public:
+        using Callback = std::function<void(HotplugEvent, Device)>;
+
+        Hotplug(std::uint16_t vendorId, Callback callback);
+        Hotplug(const Hotplug&) = delete;
+        ~Hotplug();
+
+        Hotplug& operator=(const Hotplug&) = delete;
+
+    private:
+        Callback callback_;
+        int handle_;
+    };
+}
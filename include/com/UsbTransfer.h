@@ -0,0 +1,80 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <span>
+#include <vector>
+
+struct libusb_device_handle;
+struct libusb_transfer;
+
+namespace plug::com::usb
+{
+    // Keeps a ring of interrupt IN transfers submitted; completed packets are
+    // copied into a preallocated packet ring by the event handling thread and
+    // the transfers resubmitted immediately. If the ring is full the oldest
+    // packet is dropped; droppedPackets() counts them for checks after a transaction.
+    class ReceiveQueue
+    {
+    public:
+        ReceiveQueue(libusb_device_handle* handle, std::uint8_t endpoint, std::size_t packetSize, std::size_t numTransfers, std::size_t capacity);
+        ReceiveQueue(const ReceiveQueue&) = delete;
+        ~ReceiveQueue();
+
+        std::uint8_t endpoint() const noexcept;
+        std::vector<std::uint8_t> receive(std::chrono::milliseconds timeout);
+        std::size_t receiveInto(std::span<std::uint8_t> buffer, std::chrono::milliseconds timeout);
+        std::size_t droppedPackets() const;
+
+        ReceiveQueue& operator=(const ReceiveQueue&) = delete;
+
+
+    private:
+        void stop();
+        void onTransferCompleted(libusb_transfer* transfer);
+
+        static void transferCallback(libusb_transfer* transfer);
+
+        const std::uint8_t endpoint_;
+        const std::size_t packetSize_;
+        std::vector<libusb_transfer*> transfers_;
+        std::vector<std::vector<std::uint8_t>> buffers_;
+        mutable std::mutex mutex_;
+        std::condition_variable packetsAvailable_;
+        std::vector<std::uint8_t> packets_;
+        std::vector<std::size_t> packetLengths_;
+        std::size_t packetsHead_;
+        std::size_t packetsCount_;
+        std::size_t transfersInFlight_;
+        std::size_t droppedPackets_;
+        int error_;
+        bool stopping_;
+    };
+
+
+    // Submits a copy of the data, it's owned by the transfer until its completion
+    std::future<std::size_t> submitWrite(libusb_device_handle* handle, std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize, std::chrono::milliseconds timeout);
+}
@@ -0,0 +1,62 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Mustang.h"
+#include "daemon/FileDescriptor.h"
+#include "daemon/Protocol.h"
+#include <filesystem>
+#include <vector>
+
+namespace plug::daemon
+{
+    // Owns the started amp and serves the clients of the socket; requests are handled one at a time, so the amp needs no locking
+    class AmpDaemon
+    {
+    public:
+        AmpDaemon(com::Mustang& mustang, const std::filesystem::path& socketPath);
+        AmpDaemon(const AmpDaemon&) = delete;
+        ~AmpDaemon();
+
+        void run();
+        void stop();
+
+        AmpDaemon& operator=(const AmpDaemon&) = delete;
+
+    private:
+        struct Client
+        {
+            FileDescriptor socket;
+            FrameReader reader;
+        };
+
+        bool receive(Client& client);
+        std::vector<std::uint8_t> handle(const Frame& request);
+
+        com::Mustang& mustang_;
+        std::filesystem::path socketPath_;
+        com::InitialData state_;
+        FileDescriptor listener_;
+        FileDescriptor wakeupReceiver_;
+        FileDescriptor wakeupSender_;
+        std::vector<Client> clients_;
+    };
+}
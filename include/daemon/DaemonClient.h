@@ -0,0 +1,49 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Mustang.h"
+#include "daemon/FileDescriptor.h"
+#include "daemon/Protocol.h"
+#include <filesystem>
+#include <string_view>
+
+namespace plug::daemon
+{
+    // Controls the amp through a running daemon; requests are answered in order
+    class DaemonClient
+    {
+    public:
+        explicit DaemonClient(const std::filesystem::path& socketPath);
+
+        com::InitialData state();
+        SignalChain loadPreset(std::uint8_t slot);
+        void setAmp(const amp_settings& amp);
+        void setEffect(const fx_pedal_settings& effect);
+        void savePreset(std::uint8_t slot, std::string_view name);
+
+    private:
+        std::vector<std::uint8_t> request(Request type, std::span<const std::uint8_t> payload);
+
+        FileDescriptor socket_;
+        FrameReader reader_;
+    };
+}
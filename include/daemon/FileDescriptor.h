@@ -0,0 +1,57 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace plug::daemon
+{
+    // Owning wrapper of a file descriptor, used for sockets and pipes
+    class FileDescriptor
+    {
+    public:
+        FileDescriptor() noexcept;
+        explicit FileDescriptor(int fd) noexcept;
+        FileDescriptor(FileDescriptor&& other) noexcept;
+        FileDescriptor(const FileDescriptor&) = delete;
+        ~FileDescriptor();
+
+        int get() const noexcept;
+        bool isOpen() const noexcept;
+        void close() noexcept;
+
+        void writeAll(std::span<const std::uint8_t> data) const;
+        std::size_t readSome(std::span<std::uint8_t> buffer) const;
+
+        FileDescriptor& operator=(FileDescriptor&& other) noexcept;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    private:
+        int fd_;
+    };
+
+
+    FileDescriptor listenOn(const std::filesystem::path& path);
+    FileDescriptor connectTo(const std::filesystem::path& path);
+    FileDescriptor acceptFrom(const FileDescriptor& listener);
+}
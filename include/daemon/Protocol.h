@@ -0,0 +1,76 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "com/Mustang.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace plug::daemon
+{
+    // Frame: request type or response status, payload size (little endian) and payload
+    inline constexpr std::size_t frameHeaderSize{3};
+    inline constexpr std::size_t maxPayloadSize{0xffff};
+
+    enum class Request : std::uint8_t
+    {
+        State = 0x01,
+        LoadPreset = 0x02,
+        SetAmp = 0x03,
+        SetEffect = 0x04,
+        SavePreset = 0x05
+    };
+
+    enum class Status : std::uint8_t
+    {
+        Ok = 0x00,
+        Error = 0x01
+    };
+
+    struct Frame
+    {
+        std::uint8_t type;
+        std::vector<std::uint8_t> payload;
+    };
+
+
+    std::vector<std::uint8_t> encodeFrame(std::uint8_t type, std::span<const std::uint8_t> payload);
+
+    std::vector<std::uint8_t> encodeState(const com::InitialData& state);
+    com::InitialData decodeState(std::span<const std::uint8_t> payload);
+
+    std::filesystem::path defaultSocketPath();
+
+
+    // Collects received bytes and splits them into frames; a frame may arrive in several parts
+    class FrameReader
+    {
+    public:
+        void append(std::span<const std::uint8_t> data);
+        std::optional<Frame> next();
+
+    private:
+        std::vector<std::uint8_t> buffer_;
+    };
+}
@@ -0,0 +1,102 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "data_structs.h"
+#include "DeviceModel.h"
+#include "SignalChain.h"
+#include "com/ConnectionFactory.h"
+#include "com/Mustang.h"
+#include "com/SettingsCoalescer.h"
+#include "com/SpscQueue.h"
+#include <QObject>
+#include <QString>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <semaphore>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+Q_DECLARE_METATYPE(plug::DeviceModel)
+Q_DECLARE_METATYPE(plug::SignalChain)
+Q_DECLARE_METATYPE(plug::com::InitialData)
+
+namespace plug
+{
+
+    // Owns the amp connection and runs all communication on a worker thread; results are delivered as queued signals
+    class AmpWorker : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit AmpWorker(QObject* parent = nullptr);
+        AmpWorker(const AmpWorker&) = delete;
+        ~AmpWorker() override;
+
+        // Starts watching for amps on the worker thread; call after connecting to ampAvailable so the initial state isn't missed
+        void start();
+        void connectAmp();
+        void disconnectAmp();
+        void releaseAmp();
+        void sendSettings(com::PendingSettings settings);
+        void saveOnAmp(std::string name, std::uint8_t slot);
+        void loadFromAmp(std::uint8_t slot);
+        void selectMemoryBank(std::uint8_t slot);
+        void saveEffects(std::uint8_t slot, std::string name, std::vector<fx_pedal_settings> effects);
+        void updateFirmware(std::string filename);
+        void cancelFirmwareUpdate();
+        void backupAmp(std::string filename);
+        void restoreAmp(std::string filename);
+
+        AmpWorker& operator=(const AmpWorker&) = delete;
+
+    signals:
+        void connected(plug::com::InitialData data, plug::DeviceModel model);
+        void disconnected();
+        void ampAvailable(bool available);
+        void savedOnAmp(QString name, int slot);
+        void memoryBankLoaded(int slot, plug::SignalChain signalChain);
+        void failed(QString message);
+        void firmwareProgress(int sent, int total);
+        void firmwareUpdateFinished(bool completed);
+        void backupFinished(bool completed);
+        void restoreFinished(bool completed);
+
+    private:
+        using Command = std::function<void()>;
+        using CommandQueue = com::SpscQueue<Command, 64>;
+
+        void post(Command command);
+        void run(std::stop_token stopToken);
+
+        std::unique_ptr<com::AmpWatcher> watcher;
+        std::unique_ptr<com::Mustang> amp_ops;
+        std::stop_source firmwareStop;
+        CommandQueue commands;
+        std::counting_semaphore<> commandsAvailable;
+        std::counting_semaphore<CommandQueue::capacity()> freeSlots;
+        std::jthread worker;
+    };
+}
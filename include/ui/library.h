@@ -21,10 +21,13 @@
 
 #pragma once
 
+#include "com/PresetLibraryIndex.h"
 #include <QDialog>
 #include <QResizeEvent>
-#include <QFileInfoList>
 #include <memory>
+#include <vector>
+
+class QFileSystemWatcher;
 
 namespace Ui
 {
@@ -48,13 +51,20 @@ namespace plug
 
     private:
         const std::unique_ptr<Ui::Library> ui;
-        const std::unique_ptr<QFileInfoList> files;
+        QFileSystemWatcher* watcher;
+        QString directory;
+        com::PresetLibraryIndex presetIndex;
+        std::vector<com::PresetLibraryIndex::Entry> files;
         void resizeEvent(QResizeEvent*) override;
+        void loadIndex();
+        void saveIndex() const;
+        void showFiles();
 
     private slots:
         void load_slot(int slot);
         void get_directory();
         void get_files(const QString&);
+        void refresh_files();
         void load_file(int row);
         void change_font_size(int);
         void change_font_family(QFont);
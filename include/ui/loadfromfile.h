@@ -22,8 +22,10 @@
 #pragma once
 
 #include "data_structs.h"
+#include "SignalChain.h"
 #include <QFile>
 #include <QXmlStreamReader>
+#include <filesystem>
 #include <vector>
 #include <memory>
 
@@ -42,6 +44,8 @@ namespace plug
         explicit LoadFromFile(QFile* file);
 
         Settings loadfile();
+        bool hasError() const;
+        QString errorString() const;
 
     private:
         QXmlStreamReader xml;
@@ -50,4 +54,7 @@ namespace plug
         std::vector<fx_pedal_settings> parseFX();
         QString parseFUSE();
     };
+
+    // Uses a reader of its own, so files can be loaded concurrently
+    SignalChain loadPresetFile(const std::filesystem::path& path);
 }
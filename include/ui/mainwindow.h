@@ -22,10 +22,14 @@
 #pragma once
 
 #include "data_structs.h"
+#include "ui/ampworker.h"
+#include "com/PresetCache.h"
 #include <QMainWindow>
 #include <array>
 #include <memory>
 
+class QTimer;
+
 namespace Ui
 {
     class MainWindow;
@@ -41,11 +45,6 @@ namespace plug
     class LoadFromAmp;
     class Settings;
     class QuickPresets;
-
-    namespace com
-    {
-        class Mustang;
-    }
 }
 
 
@@ -75,9 +74,12 @@ namespace plug
         void save_effects(int, char*, int, bool, bool, bool);
         void set_index(int);
         void loadfile(QString filename = QString());
+        void loadSignalChain(const plug::SignalChain& signalChain);
         void get_settings(amp_settings*, std::vector<fx_pedal_settings>&);
         void change_title(const QString&);
         void update_firmware();
+        void backup_amp();
+        void restore_amp();
         void empty_other(int, Effect*);
 
     private:
@@ -86,7 +88,10 @@ namespace plug
         QString current_name;
         std::vector<std::string> presetNames;
         bool connected;
-        std::unique_ptr<com::Mustang> amp_ops;
+        AmpWorker* worker;
+        std::unique_ptr<com::SettingsCoalescer> pendingSettings;
+        QTimer* flushTimer;
+        com::PresetCache presetCache;
         Amplifier* amp;
         std::array<Effect*, 8> effectComponents;
         SaveOnAmp* save;
@@ -96,6 +101,8 @@ namespace plug
         SaveToFile* saver;
         QuickPresets* quickpres;
 
+        void loadFromBank(const QString& filename);
+
     private slots:
         void about();
         void showEffect(std::uint8_t slot);
@@ -103,6 +110,14 @@ namespace plug
         void show_library();
         void show_default_effects();
         void loadPreset(std::size_t number);
+        void scheduleSettingsFlush();
+        void flushSettings();
+        void ampConnected(const plug::com::InitialData& data, const plug::DeviceModel& model);
+        void ampDisconnected();
+        void ampAvailabilityChanged(bool available);
+        void savedOnAmp(const QString& name, int slot);
+        void memoryBankLoaded(int slot, const plug::SignalChain& signalChain);
+        void showError(const QString& message);
 
 
     signals:
@@ -0,0 +1,97 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cli/AmpControl.h"
+#include "daemon/DaemonClient.h"
+#include <stdexcept>
+
+namespace plug::cli
+{
+    MustangControl::MustangControl(com::Mustang& mustang)
+        : mustang_(mustang)
+    {
+    }
+
+    com::InitialData MustangControl::state()
+    {
+        return mustang_.start_amp();
+    }
+
+    SignalChain MustangControl::load(std::uint8_t slot)
+    {
+        return mustang_.load_memory_bank(slot);
+    }
+
+    void MustangControl::setAmp(const amp_settings& amp)
+    {
+        mustang_.set_amplifier(amp);
+    }
+
+    void MustangControl::setEffect(const fx_pedal_settings& effect)
+    {
+        mustang_.set_effect(effect);
+    }
+
+    void MustangControl::backup(std::ostream& out)
+    {
+        mustang_.backupAll(out);
+    }
+
+    void MustangControl::restore(const com::AmpBackup& backup)
+    {
+        mustang_.restoreAll(backup);
+    }
+
+
+    DaemonControl::DaemonControl(daemon::DaemonClient& client)
+        : client_(client)
+    {
+    }
+
+    com::InitialData DaemonControl::state()
+    {
+        return client_.state();
+    }
+
+    SignalChain DaemonControl::load(std::uint8_t slot)
+    {
+        return client_.loadPreset(slot);
+    }
+
+    void DaemonControl::setAmp(const amp_settings& amp)
+    {
+        client_.setAmp(amp);
+    }
+
+    void DaemonControl::setEffect(const fx_pedal_settings& effect)
+    {
+        client_.setEffect(effect);
+    }
+
+    void DaemonControl::backup([[maybe_unused]] std::ostream& out)
+    {
+        throw std::runtime_error{"Backup is not supported while plugd is running, stop it first"};
+    }
+
+    void DaemonControl::restore([[maybe_unused]] const com::AmpBackup& backup)
+    {
+        throw std::runtime_error{"Restore is not supported while plugd is running, stop it first"};
+    }
+}
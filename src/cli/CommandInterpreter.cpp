@@ -0,0 +1,364 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cli/CommandInterpreter.h"
+#include "com/AmpBackup.h"
+#include "com/PresetBank.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace plug::cli
+{
+    namespace
+    {
+        struct AmpKnob
+        {
+            std::string_view name;
+            std::uint8_t amp_settings::*member;
+        };
+
+        inline constexpr std::array ampKnobs{
+            AmpKnob{"gain", &amp_settings::gain},
+            AmpKnob{"volume", &amp_settings::volume},
+            AmpKnob{"treble", &amp_settings::treble},
+            AmpKnob{"middle", &amp_settings::middle},
+            AmpKnob{"bass", &amp_settings::bass},
+            AmpKnob{"noise-gate", &amp_settings::noise_gate},
+            AmpKnob{"master", &amp_settings::master_vol},
+            AmpKnob{"gain2", &amp_settings::gain2},
+            AmpKnob{"presence", &amp_settings::presence},
+            AmpKnob{"threshold", &amp_settings::threshold},
+            AmpKnob{"depth", &amp_settings::depth},
+            AmpKnob{"bias", &amp_settings::bias},
+            AmpKnob{"sag", &amp_settings::sag},
+            AmpKnob{"usb-gain", &amp_settings::usb_gain}};
+
+        inline constexpr std::size_t numberOfAmps{static_cast<std::size_t>(amps::BRITISH_WATTS) + 1};
+        inline constexpr std::size_t numberOfCabinets{static_cast<std::size_t>(cabinets::cabSS112) + 1};
+        inline constexpr std::size_t numberOfEffects{static_cast<std::size_t>(effects::FENDER_65_SPRING_REVERB) + 1};
+
+        std::uint8_t parseNumber(std::string_view value, std::size_t max = 0xff)
+        {
+            unsigned int number{0};
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+            if ((error != std::errc{}) || (end != value.data() + value.size()) || (number > max))
+            {
+                throw std::invalid_argument{"Invalid value: " + std::string{value}};
+            }
+            return static_cast<std::uint8_t>(number);
+        }
+
+        void requireArguments(const std::vector<std::string>& args, std::size_t min, std::size_t max)
+        {
+            // The command itself is the first argument
+            if ((args.size() < (min + 1)) || (args.size() > (max + 1)))
+            {
+                throw std::invalid_argument{"Invalid number of arguments for " + args.front() + "\n" + usage()};
+            }
+        }
+
+        std::string formatAmp(const amp_settings& amp)
+        {
+            std::ostringstream out;
+            out << "model=" << static_cast<int>(amp.amp_num) << " cabinet=" << static_cast<int>(amp.cabinet) << " brightness=" << (amp.brightness ? 1 : 0);
+
+            for (const auto& knob : ampKnobs)
+            {
+                out << ' ' << knob.name << '=' << static_cast<int>(amp.*knob.member);
+            }
+            return out.str();
+        }
+
+        std::string formatEffect(const fx_pedal_settings& effect)
+        {
+            std::ostringstream out;
+            out << "slot=" << static_cast<int>(effect.slot.id()) << " effect=" << static_cast<int>(effect.effect_num) << " knobs="
+                << static_cast<int>(effect.knob1) << ',' << static_cast<int>(effect.knob2) << ',' << static_cast<int>(effect.knob3) << ','
+                << static_cast<int>(effect.knob4) << ',' << static_cast<int>(effect.knob5) << ',' << static_cast<int>(effect.knob6);
+            return out.str();
+        }
+    }
+
+    std::string usage()
+    {
+        return "Usage: plug-cli <command> [arguments]\n"
+               "Commands:\n"
+               "  load <slot>                         load the preset of the slot (starting at 0)\n"
+               "  dump                                print the current state and the preset names\n"
+               "  apply <file.fuse | file.plugbank> [index]  apply a preset file\n"
+               "  set-amp <key=value>...              change amp settings (model, cabinet, brightness, "
+               "gain, volume, treble, middle, bass, noise-gate, master, gain2, presence, threshold, depth, bias, sag, usb-gain)\n"
+               "  set-fx <slot> <effect> [knob]...    set the effect of a slot, effect 0 clears it\n"
+               "  backup <file>                       back up all presets\n"
+               "  restore <file>                      restore all presets from a backup\n"
+               "  batch                               read commands from stdin, one per line\n";
+    }
+
+    std::vector<std::string> splitCommand(std::string_view line)
+    {
+        std::istringstream in{std::string{line}};
+        std::vector<std::string> command;
+
+        for (std::string word; in >> word;)
+        {
+            command.push_back(word);
+        }
+        return command;
+    }
+
+
+    CommandInterpreter::CommandInterpreter(AmpControl& amp, com::PresetLoader loader, std::ostream& out)
+        : amp_(amp), loader_(std::move(loader)), out_(out), current_(), presetNames_()
+    {
+    }
+
+    void CommandInterpreter::start()
+    {
+        auto [signalChain, presetNames] = amp_.state();
+        current_ = std::move(signalChain);
+        presetNames_ = std::move(presetNames);
+    }
+
+    void CommandInterpreter::execute(const std::vector<std::string>& command)
+    {
+        if (command.empty())
+        {
+            return;
+        }
+
+        const auto& name = command.front();
+
+        if (name == "load")
+        {
+            load(command);
+        }
+        else if (name == "dump")
+        {
+            requireArguments(command, 0, 0);
+            dump();
+        }
+        else if (name == "apply")
+        {
+            apply(command);
+        }
+        else if (name == "set-amp")
+        {
+            setAmp(command);
+        }
+        else if (name == "set-fx")
+        {
+            setFx(command);
+        }
+        else if (name == "backup")
+        {
+            backup(command);
+        }
+        else if (name == "restore")
+        {
+            restore(command);
+        }
+        else
+        {
+            throw std::invalid_argument{"Unknown command: " + name + "\n" + usage()};
+        }
+    }
+
+    std::size_t CommandInterpreter::runBatch(std::istream& in, std::ostream& err)
+    {
+        // A failed command doesn't end the batch; the connection is kept open for all commands
+        std::size_t failed{0};
+
+        for (std::string line; std::getline(in, line);)
+        {
+            const auto command = splitCommand(line);
+
+            if (command.empty() || command.front().starts_with('#'))
+            {
+                continue;
+            }
+
+            try
+            {
+                execute(command);
+            }
+            catch (const std::exception& ex)
+            {
+                err << "error: " << ex.what() << '\n';
+                ++failed;
+            }
+            out_.flush();
+        }
+        return failed;
+    }
+
+    void CommandInterpreter::load(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 1, 1);
+        const auto slot = parseNumber(args[1], presetNames_.empty() ? 0xff : presetNames_.size() - 1);
+
+        current_ = amp_.load(slot);
+        out_ << current_.name() << '\n';
+    }
+
+    void CommandInterpreter::dump() const
+    {
+        const auto effects = current_.effects();
+
+        out_ << "name: " << current_.name() << '\n'
+             << "amp: " << formatAmp(current_.amp()) << '\n';
+
+        for (const auto& effect : effects)
+        {
+            out_ << "fx: " << formatEffect(effect) << '\n';
+        }
+
+        for (std::size_t i = 0; i < presetNames_.size(); ++i)
+        {
+            out_ << "preset " << i << ": " << presetNames_[i] << '\n';
+        }
+    }
+
+    void CommandInterpreter::apply(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 1, 2);
+        const std::filesystem::path file{args[1]};
+
+        if (file.extension() == ".plugbank")
+        {
+            const com::PresetBank bank{file.string()};
+            applyPreset(bank.at(args.size() > 2 ? parseNumber(args[2], bank.size() - 1) : 0));
+        }
+        else
+        {
+            applyPreset(loader_(file));
+        }
+        out_ << current_.name() << '\n';
+    }
+
+    void CommandInterpreter::setAmp(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 1, ampKnobs.size() + 3);
+        auto amp = current_.amp();
+
+        for (auto itr = std::next(args.cbegin()); itr != args.cend(); ++itr)
+        {
+            const auto separator = itr->find('=');
+
+            if (separator == std::string::npos)
+            {
+                throw std::invalid_argument{"Expected key=value: " + *itr};
+            }
+
+            const std::string_view key{itr->data(), separator};
+            const std::string_view value{std::string_view{*itr}.substr(separator + 1)};
+
+            if (key == "model")
+            {
+                amp.amp_num = static_cast<amps>(parseNumber(value, numberOfAmps - 1));
+            }
+            else if (key == "cabinet")
+            {
+                amp.cabinet = static_cast<cabinets>(parseNumber(value, numberOfCabinets - 1));
+            }
+            else if (key == "brightness")
+            {
+                amp.brightness = (parseNumber(value, 1) != 0);
+            }
+            else if (const auto knob = std::find_if(ampKnobs.cbegin(), ampKnobs.cend(), [key](const auto& k)
+                                                    { return k.name == key; });
+                     knob != ampKnobs.cend())
+            {
+                amp.*(knob->member) = parseNumber(value);
+            }
+            else
+            {
+                throw std::invalid_argument{"Unknown amp setting: " + std::string{key}};
+            }
+        }
+
+        amp_.setAmp(amp);
+        current_.setAmp(amp);
+    }
+
+    void CommandInterpreter::setFx(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 2, 8);
+
+        std::array<std::uint8_t, 6> knobs{};
+        std::transform(std::next(args.cbegin(), 3), args.cend(), knobs.begin(), [](const auto& value)
+                       { return parseNumber(value); });
+
+        const fx_pedal_settings effect{FxSlot{parseNumber(args[1], 7)}, static_cast<effects>(parseNumber(args[2], numberOfEffects - 1)),
+                                       knobs[0], knobs[1], knobs[2], knobs[3], knobs[4], knobs[5], true};
+
+        amp_.setEffect(effect);
+
+        auto fxSettings = current_.effects();
+        std::erase_if(fxSettings, [&effect](const auto& e)
+                      { return e.slot.id() == effect.slot.id(); });
+        fxSettings.push_back(effect);
+        current_.setEffects(fxSettings);
+    }
+
+    void CommandInterpreter::backup(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 1, 1);
+        std::ofstream out{args[1], std::ios::binary};
+
+        if (!out)
+        {
+            throw std::runtime_error{"Could not create " + args[1]};
+        }
+        amp_.backup(out);
+    }
+
+    void CommandInterpreter::restore(const std::vector<std::string>& args)
+    {
+        requireArguments(args, 1, 1);
+        std::ifstream in{args[1], std::ios::binary};
+
+        if (!in)
+        {
+            throw std::runtime_error{"Could not open " + args[1]};
+        }
+
+        amp_.restore(com::readBackup(in));
+
+        // Preset names and the current state have changed
+        start();
+    }
+
+    void CommandInterpreter::applyPreset(const SignalChain& preset)
+    {
+        amp_.setAmp(preset.amp());
+
+        for (const auto& effect : preset.effects())
+        {
+            amp_.setEffect(effect);
+        }
+        current_ = preset;
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cli/CommandInterpreter.h"
+#include "com/ConnectionFactory.h"
+#include "com/Mustang.h"
+#include "com/UsbContext.h"
+#include "daemon/DaemonClient.h"
+#include "ui/loadfromfile.h"
+#include "Version.h"
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    std::unique_ptr<plug::daemon::DaemonClient> connectDaemon()
+    {
+        try
+        {
+            return std::make_unique<plug::daemon::DaemonClient>(plug::daemon::defaultSocketPath());
+        }
+        catch (const std::system_error&)
+        {
+            // No plugd running, the amp is connected directly
+            return nullptr;
+        }
+    }
+
+    int run(plug::cli::AmpControl& amp, const std::vector<std::string>& command)
+    {
+        plug::cli::CommandInterpreter interpreter{amp, plug::loadPresetFile, std::cout};
+        interpreter.start();
+
+        if (command.front() == "batch")
+        {
+            return (interpreter.runBatch(std::cin, std::cerr) == 0) ? 0 : 1;
+        }
+
+        interpreter.execute(command);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::vector<std::string> command(std::next(argv), std::next(argv, argc));
+
+    if (command.empty() || (command.front() == "--help") || (command.front() == "-h"))
+    {
+        std::cout << plug::cli::usage();
+        return command.empty() ? 1 : 0;
+    }
+
+    if (command.front() == "--version")
+    {
+        std::cout << "plug-cli " << plug::version() << '\n';
+        return 0;
+    }
+
+    try
+    {
+        // A running plugd owns the amp, the commands are sent to it instead
+        if (auto client = connectDaemon(); client != nullptr)
+        {
+            plug::cli::DaemonControl amp{*client};
+            return run(amp, command);
+        }
+
+        plug::com::usb::Context context{};
+
+        auto mustang = plug::com::connect();
+        plug::cli::MustangControl amp{*mustang};
+        const int result = run(amp, command);
+
+        mustang->stop_amp();
+        return result;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "error: " << ex.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/AmpBackup.h"
+#include "com/CommunicationException.h"
+#include <algorithm>
+#include <iterator>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Header: magic and version; records: type and the raw packets, the banks are in order of the slots
+        inline constexpr std::array<char, 7> magic{'P', 'L', 'U', 'G', 'B', 'A', 'K'};
+        inline constexpr std::uint8_t formatVersion{1};
+        inline constexpr char knobPresetRecord{0x00};
+        inline constexpr char bankRecord{0x01};
+
+        void writePacket(std::ostream& out, const PacketRawType& packet)
+        {
+            std::transform(packet.cbegin(), packet.cend(), std::ostreambuf_iterator<char>{out}, [](std::uint8_t value)
+                           { return static_cast<char>(value); });
+        }
+
+        PacketRawType readPacket(std::istream& in)
+        {
+            std::array<char, packetRawTypeSize> data{};
+
+            if (!in.read(data.data(), data.size()))
+            {
+                throw CommunicationException{"Truncated amp backup"};
+            }
+
+            PacketRawType packet{};
+            std::transform(data.cbegin(), data.cend(), packet.begin(), [](char value)
+                           { return static_cast<std::uint8_t>(value); });
+            return packet;
+        }
+    }
+
+    void writeBackupHeader(std::ostream& out)
+    {
+        out.write(magic.data(), magic.size());
+        out.put(static_cast<char>(formatVersion));
+    }
+
+    void writeBackupKnobPresets(std::ostream& out, std::span<const PacketRawType> packets)
+    {
+        std::for_each(packets.begin(), packets.end(), [&out](const auto& packet)
+                      {
+            out.put(knobPresetRecord);
+            writePacket(out, packet); });
+    }
+
+    void writeBackupBank(std::ostream& out, std::span<const PacketRawType, 7> bank)
+    {
+        out.put(bankRecord);
+        std::for_each(bank.begin(), bank.end(), [&out](const auto& packet)
+                      { writePacket(out, packet); });
+    }
+
+    AmpBackup readBackup(std::istream& in)
+    {
+        std::array<char, magic.size()> header{};
+        char version{};
+
+        if (!in.read(header.data(), header.size()) || (header != magic) || !in.get(version) || (static_cast<std::uint8_t>(version) != formatVersion))
+        {
+            throw CommunicationException{"Invalid amp backup"};
+        }
+
+        AmpBackup backup{};
+        char type{};
+
+        while (in.get(type))
+        {
+            switch (type)
+            {
+                case knobPresetRecord:
+                    backup.knobPresets.push_back(readPacket(in));
+                    break;
+                case bankRecord:
+                {
+                    auto& bank = backup.banks.emplace_back();
+                    std::generate(bank.begin(), bank.end(), [&in]
+                                  { return readPacket(in); });
+                    break;
+                }
+                default:
+                    throw CommunicationException{"Invalid record in amp backup"};
+            }
+        }
+        return backup;
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/AmpSession.h"
+#include "com/SettingsCoalescer.h"
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace plug::com
+{
+    namespace
+    {
+        PendingSettings toSettings(const SignalChain& signalChain)
+        {
+            PendingSettings settings{};
+            settings.amp = signalChain.amp();
+
+            settings.effects = signalChain.effects();
+            return settings;
+        }
+    }
+
+    AmpSession::AmpSession(std::unique_ptr<Mustang> mustang)
+        : mustang_(std::move(mustang)),
+          commands_(),
+          commandsAvailable_(0),
+          freeSlots_(CommandQueue::capacity()),
+          worker_([this](std::stop_token stopToken)
+                  { run(stopToken); })
+    {
+    }
+
+    AmpSession::~AmpSession()
+    {
+        worker_.request_stop();
+        commandsAvailable_.release();
+        worker_.join();
+    }
+
+    DeviceModel AmpSession::getDeviceModel() const
+    {
+        return mustang_->getDeviceModel();
+    }
+
+    std::future<InitialData> AmpSession::start()
+    {
+        return submit([](Mustang& mustang)
+                      { return mustang.start_amp(); });
+    }
+
+    std::future<void> AmpSession::stop()
+    {
+        return submit([](Mustang& mustang)
+                      { mustang.stop_amp(); });
+    }
+
+    std::future<SignalChain> AmpSession::load(std::uint8_t slot)
+    {
+        return submit([slot](Mustang& mustang)
+                      { return mustang.load_memory_bank(slot); });
+    }
+
+    std::future<void> AmpSession::apply(const SignalChain& signalChain)
+    {
+        return submit([settings = toSettings(signalChain)](Mustang& mustang)
+                      { sendSettings(mustang, settings); });
+    }
+
+    void AmpSession::post(Command command)
+    {
+        // A full queue blocks until the worker has taken a command
+        freeSlots_.acquire();
+        commands_.tryPush(std::move(command));
+        commandsAvailable_.release();
+    }
+
+    void AmpSession::run(std::stop_token stopToken)
+    {
+        while (stopToken.stop_requested() == false)
+        {
+            commandsAvailable_.acquire();
+
+            // Failures are delivered through the futures of the commands
+            if (auto command = commands_.tryPop(); command.has_value())
+            {
+                freeSlots_.release();
+                (*command)();
+            }
+        }
+    }
+
+
+    std::vector<std::unique_ptr<AmpSession>> openSessions(std::vector<std::unique_ptr<Mustang>> amps)
+    {
+        std::vector<std::unique_ptr<AmpSession>> sessions;
+        sessions.reserve(amps.size());
+
+        std::transform(std::make_move_iterator(amps.begin()), std::make_move_iterator(amps.end()), std::back_inserter(sessions), [](auto amp)
+                       { return std::make_unique<AmpSession>(std::move(amp)); });
+        return sessions;
+    }
+
+    void broadcast(std::span<const std::unique_ptr<AmpSession>> sessions, const SignalChain& signalChain)
+    {
+        std::vector<std::future<void>> results;
+        results.reserve(sessions.size());
+
+        std::transform(sessions.begin(), sessions.end(), std::back_inserter(results), [&signalChain](const auto& session)
+                       { return session->apply(signalChain); });
+
+        std::exception_ptr error;
+
+        std::for_each(results.begin(), results.end(), [&error](auto& result)
+                      {
+            try
+            {
+                result.get();
+            }
+            catch (...)
+            {
+                error = (error == nullptr) ? std::current_exception() : error;
+            } });
+
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/BulkPresetLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Files are claimed one at a time, by the owner as well as by stealing threads
+        struct alignas(64) Share
+        {
+            std::atomic<std::size_t> next;
+            std::size_t end;
+        };
+
+        PresetLoadResult loadPreset(const PresetLoader& loader, const std::filesystem::path& file)
+        {
+            try
+            {
+                return PresetLoadResult{file, loader(file), ""};
+            }
+            catch (const std::exception& ex)
+            {
+                return PresetLoadResult{file, std::nullopt, ex.what()};
+            }
+        }
+    }
+
+    std::vector<PresetLoadResult> loadPresets(std::span<const std::filesystem::path> files, const PresetLoader& loader, std::size_t numberOfThreads)
+    {
+        std::vector<PresetLoadResult> results(files.size());
+        const std::size_t numberOfWorkers = std::clamp<std::size_t>(numberOfThreads, 1, std::max<std::size_t>(files.size(), 1));
+        std::vector<Share> shares(numberOfWorkers);
+
+        for (std::size_t i = 0; i < numberOfWorkers; ++i)
+        {
+            shares[i].next = files.size() * i / numberOfWorkers;
+            shares[i].end = files.size() * (i + 1) / numberOfWorkers;
+        }
+
+        const auto work = [&files, &loader, &results, &shares, numberOfWorkers](std::size_t worker)
+        {
+            for (std::size_t offset = 0; offset < numberOfWorkers; ++offset)
+            {
+                auto& share = shares[(worker + offset) % numberOfWorkers];
+
+                for (auto i = share.next.fetch_add(1, std::memory_order_relaxed); i < share.end; i = share.next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    results[i] = loadPreset(loader, files[i]);
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(numberOfWorkers - 1);
+
+            for (std::size_t i = 1; i < numberOfWorkers; ++i)
+            {
+                threads.emplace_back(work, i);
+            }
+            work(0);
+        }
+        return results;
+    }
+}
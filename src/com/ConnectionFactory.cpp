@@ -23,8 +23,20 @@
 #include "com/Mustang.h"
 #include "com/UsbComm.h"
 #include "com/UsbContext.h"
+#include "com/UsbException.h"
 #include "DeviceModel.h"
 #include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <libusb-1.0/libusb.h>
+
+#ifdef PLUG_DIAGNOSTICS
+#include "com/RecordingConnection.h"
+#include "com/SimulatorConnection.h"
+#include "com/TracingConnection.h"
+#include <fstream>
+#include <iostream>
+#endif
 
 namespace plug::com
 {
@@ -75,21 +87,215 @@ namespace plug::com
             }
         }
 
+#ifdef PLUG_DIAGNOSTICS
+        inline constexpr std::size_t traceEventCapacity{4096};
+        inline constexpr std::size_t simulatorPresets{100};
+        inline constexpr std::size_t simulatorAmps{1};
+
+        bool useSimulator()
+        {
+            return std::getenv("PLUG_SIMULATOR") != nullptr;
+        }
+
+        std::size_t environmentValue(const char* name, std::size_t defaultValue)
+        {
+            const char* value = std::getenv(name);
+
+            if (value == nullptr)
+            {
+                return defaultValue;
+            }
+
+            char* end{nullptr};
+            const auto number = std::strtoul(value, &end, 10);
+            return ((end == value) || (*end != '\0')) ? defaultValue : number;
+        }
+
+        std::unique_ptr<Mustang> createMustang(const DeviceModel& model, std::shared_ptr<Connection> connection)
+        {
+            // The session is recorded to the file set by PLUG_RECORD, it can be played back by a ReplayConnection
+            if (const char* path = std::getenv("PLUG_RECORD"); path != nullptr)
+            {
+                connection = std::make_shared<RecordingConnection>(std::move(connection), std::make_unique<std::ofstream>(path, std::ios::binary));
+            }
+
+            // Enabled by PLUG_TRACE, the statistics are written to stderr once the connection is destroyed
+            if (std::getenv("PLUG_TRACE") != nullptr)
+            {
+                auto tracing = std::make_shared<TracingConnection>(std::move(connection), traceEventCapacity, &std::clog);
+                return std::make_unique<Mustang>(model, tracing, tracing);
+            }
+            return std::make_unique<Mustang>(model, std::move(connection));
+        }
+#else
+        // Built without PLUG_DIAGNOSTICS: no simulator, recording and tracing
+        bool useSimulator()
+        {
+            return false;
+        }
+
+        std::unique_ptr<Mustang> createMustang(const DeviceModel& model, std::shared_ptr<Connection> connection)
+        {
+            return std::make_unique<Mustang>(model, std::move(connection));
+        }
+#endif
+
+        bool isAmp(std::uint16_t vendorId, std::uint16_t productId)
+        {
+            return (vendorId == usbVID) && std::any_of(pids.begin(), pids.end(), [productId](std::uint16_t pid)
+                                                       { return productId == pid; });
+        }
+
+        std::shared_ptr<Connection> openConnection(usb::Device device)
+        {
+            try
+            {
+                return std::make_shared<UsbComm>(std::move(device));
+            }
+            catch (const usb::UsbException& ex)
+            {
+                // The interface is claimed by another process, e.g. plugd or a second plug instance
+                if (ex.code() == LIBUSB_ERROR_BUSY)
+                {
+                    throw CommunicationException{"Device is in use by another process (e.g. plugd), stop it first"};
+                }
+                throw;
+            }
+        }
+
+        std::unique_ptr<Mustang> connectDevice(usb::Device device)
+        {
+            const auto model = getModel(device.productId());
+            return createMustang(model, openConnection(std::move(device)));
+        }
     }
 
     std::unique_ptr<Mustang> connect()
     {
-        auto devices = usb::listDevices();
+#ifdef PLUG_DIAGNOSTICS
+        // PLUG_SIMULATOR selects the simulated amp with its number of presets, PLUG_SIMULATOR_LATENCY the latency per packet (us)
+        if (useSimulator())
+        {
+            const auto presets = environmentValue("PLUG_SIMULATOR", simulatorPresets);
+            const auto latency = environmentValue("PLUG_SIMULATOR_LATENCY", 0);
+            return connectSimulator(presets == 0 ? simulatorPresets : presets, std::chrono::microseconds{latency});
+        }
+#endif
 
-        auto itr = std::find_if(devices.begin(), devices.end(), [](const auto& dev)
-                                { return (dev.vendorId() == usbVID) && std::any_of(pids.begin(), pids.end(), [&dev](std::uint16_t pid)
-                                                                                   { return dev.productId() == pid; }); });
+        auto device = usb::findDevice(isAmp);
 
-        if (itr == devices.end())
+        if (!device.has_value())
         {
             throw CommunicationException{"No device found"};
         }
-        return std::make_unique<Mustang>(getModel(itr->productId()), std::make_shared<UsbComm>(std::move(*itr)));
+        return connectDevice(std::move(*device));
     }
 
+    std::vector<std::unique_ptr<Mustang>> connectAll()
+    {
+        std::vector<std::unique_ptr<Mustang>> amps;
+
+#ifdef PLUG_DIAGNOSTICS
+        // PLUG_SIMULATOR_AMPS sets the number of simulated amps
+        if (useSimulator())
+        {
+            const auto numberOfAmps = std::max(environmentValue("PLUG_SIMULATOR_AMPS", simulatorAmps), simulatorAmps);
+            std::generate_n(std::back_inserter(amps), numberOfAmps, []
+                            { return connect(); });
+            return amps;
+        }
+#endif
+
+        auto devices = usb::listDevices(isAmp);
+
+        std::transform(std::make_move_iterator(devices.begin()), std::make_move_iterator(devices.end()), std::back_inserter(amps), [](auto device)
+                       { return connectDevice(std::move(device)); });
+
+        if (amps.empty())
+        {
+            throw CommunicationException{"No device found"};
+        }
+        return amps;
+    }
+
+#ifdef PLUG_DIAGNOSTICS
+    std::unique_ptr<Mustang> connectSimulator(std::size_t numberOfPresets, std::chrono::microseconds latency)
+    {
+        return createMustang(DeviceModel{"Mustang Simulator", DeviceModel::Category::MustangV1, numberOfPresets},
+                             std::make_shared<SimulatorConnection>(numberOfPresets, latency));
+    }
+#endif
+
+
+    AmpWatcher::AmpWatcher(Listener listener)
+        : mutex_(), device_(std::nullopt), listener_(std::move(listener)), hotplug_(nullptr)
+    {
+        // The simulator and platforms without hotplug support fall back to scanning the bus on connect
+        if (!useSimulator() && usb::hasHotplugSupport())
+        {
+            hotplug_ = std::make_unique<usb::Hotplug>(usbVID, [this](usb::HotplugEvent event, usb::Device device)
+                                                      { onHotplug(event, std::move(device)); });
+        }
+    }
+
+    bool AmpWatcher::isWatching() const
+    {
+        return hotplug_ != nullptr;
+    }
+
+    bool AmpWatcher::isAvailable() const
+    {
+        std::lock_guard lock{mutex_};
+        return device_.has_value();
+    }
+
+    std::unique_ptr<Mustang> AmpWatcher::connect()
+    {
+        if (!isWatching())
+        {
+            return com::connect();
+        }
+
+        std::unique_lock lock{mutex_};
+
+        if (!device_.has_value())
+        {
+            throw CommunicationException{"No device found"};
+        }
+
+        usb::Device device{device_->native()};
+        lock.unlock();
+
+        return connectDevice(std::move(device));
+    }
+
+    void AmpWatcher::onHotplug(usb::HotplugEvent event, usb::Device device)
+    {
+        std::unique_lock lock{mutex_};
+
+        if (event == usb::HotplugEvent::Arrived)
+        {
+            if (!isAmp(device.vendorId(), device.productId()))
+            {
+                return;
+            }
+            device_.emplace(std::move(device));
+        }
+        else
+        {
+            if (!device_.has_value() || (device_->native() != device.native()))
+            {
+                return;
+            }
+            device_.reset();
+        }
+
+        const bool available = device_.has_value();
+        lock.unlock();
+
+        if (listener_)
+        {
+            listener_(available);
+        }
+    }
 }
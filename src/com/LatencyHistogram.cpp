@@ -0,0 +1,94 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace plug::com
+{
+    namespace
+    {
+        inline constexpr std::size_t subBucketBits{3};
+        inline constexpr std::uint64_t subBuckets{1 << subBucketBits};
+
+        std::size_t bucketIndex(std::uint64_t value)
+        {
+            if (value < subBuckets)
+            {
+                return static_cast<std::size_t>(value);
+            }
+            const auto shift = static_cast<std::size_t>(std::bit_width(value)) - 1 - subBucketBits;
+            return static_cast<std::size_t>(subBuckets + shift * subBuckets + ((value >> shift) & (subBuckets - 1)));
+        }
+
+        std::uint64_t bucketUpperBound(std::size_t index)
+        {
+            if (index < subBuckets)
+            {
+                return index;
+            }
+            const auto shift = (index - subBuckets) / subBuckets;
+            const auto base = (subBuckets + (index % subBuckets)) << shift;
+            return base + ((std::uint64_t{1} << shift) - 1);
+        }
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds latency)
+    {
+        const auto value = static_cast<std::uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0}));
+        ++buckets[bucketIndex(value)];
+        ++count_;
+        max_ = std::max(max_, value);
+    }
+
+    std::uint64_t LatencyHistogram::count() const
+    {
+        return count_;
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::percentile(double p) const
+    {
+        if (count_ == 0)
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+
+        const auto rank = std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_))));
+        std::uint64_t seen{0};
+
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+        {
+            seen += buckets[i];
+
+            if (seen >= rank)
+            {
+                return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(std::min(bucketUpperBound(i), max_))};
+            }
+        }
+        return max();
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::max() const
+    {
+        return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(max_)};
+    }
+}
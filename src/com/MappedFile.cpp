@@ -0,0 +1,120 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/MappedFile.h"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace plug::com
+{
+    namespace
+    {
+        class FileDescriptor
+        {
+        public:
+            explicit FileDescriptor(const std::string& path)
+                : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC))
+            {
+                if (fd < 0)
+                {
+                    throw std::system_error{errno, std::generic_category(), "Opening " + path + " failed"};
+                }
+            }
+
+            FileDescriptor(const FileDescriptor&) = delete;
+
+            ~FileDescriptor()
+            {
+                ::close(fd);
+            }
+
+            FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+            const int fd;
+        };
+    }
+
+    MappedFile::MappedFile(const std::string& path)
+        : data_(nullptr), size_(0)
+    {
+        // The mapping stays valid once the file is closed
+        const FileDescriptor file{path};
+        struct stat status{};
+
+        if (::fstat(file.fd, &status) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "Reading status of " + path + " failed"};
+        }
+
+        if (status.st_size == 0)
+        {
+            return;
+        }
+
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file.fd, 0);
+
+        if (mapping == MAP_FAILED)
+        {
+            throw std::system_error{errno, std::generic_category(), "Mapping " + path + " failed"};
+        }
+
+        data_ = static_cast<const std::uint8_t*>(mapping);
+        size_ = static_cast<std::size_t>(status.st_size);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    std::span<const std::uint8_t> MappedFile::data() const noexcept
+    {
+        return {data_, size_};
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+        if (data_ != nullptr)
+        {
+            ::munmap(const_cast<std::uint8_t*>(data_), size_);
+        }
+    }
+}
@@ -22,71 +22,263 @@
 #include "com/Mustang.h"
 #include "com/PacketSerializer.h"
 #include "com/CommunicationException.h"
+#include "com/IdLookup.h"
 #include "com/Packet.h"
+#include "com/PacketView.h"
 #include <algorithm>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
 
 namespace plug::com
 {
-    SignalChain decode_data(const std::array<PacketRawType, 7>& data)
+    namespace
     {
-        const auto name = decodeNameFromData(fromRawData<NamePayload>(data[0]));
-        const auto amp = decodeAmpFromData(fromRawData<AmpPayload>(data[1]), fromRawData<AmpPayload>(data[6]));
-        const auto effects = decodeEffectsFromData({{fromRawData<EffectPayload>(data[2]), fromRawData<EffectPayload>(data[3]),
-                                                     fromRawData<EffectPayload>(data[4]), fromRawData<EffectPayload>(data[5])}});
+        inline constexpr std::size_t numberOfBankPackets{7};
+        inline constexpr std::size_t numberOfKnobPresets{12};
+        inline constexpr std::uint8_t dlyRevKnob{0x02};
+        inline constexpr std::size_t dspPosition{2};
+        inline constexpr std::size_t numberOfKnobPresetPackets{numberOfKnobPresets * (3 + 4)};
+        inline constexpr std::size_t maxUnknownLengthPackets{300};
+        inline constexpr std::size_t backupChunkSize{8};
+        inline constexpr std::array familyEffects{effects::OVERDRIVE, effects::SINE_CHORUS, effects::MONO_DELAY, effects::SMALL_HALL_REVERB};
+
+        Header confirmationHeader()
+        {
+            Header header{};
+            header.setStage(Stage::ready);
+            header.setType(Type::operation);
+            header.setDSP(DSP::none);
+            return header;
+        }
+
+        Header lastKnobPresetConfirmationHeader()
+        {
+            Header header = confirmationHeader();
+            header.setSlot(numberOfKnobPresets - 1);
+            header.setUnknown(dlyRevKnob, 0x00, 0x00);
+            return header;
+        }
+
+        bool headerMatches(const PacketRawType& data, const Header& header, std::size_t length)
+        {
+            const auto expected = header.getBytes();
+            return std::equal(expected.cbegin(), std::next(expected.cbegin(), length), data.cbegin());
+        }
+
+        bool isConfirmationPacket(const PacketRawType& data)
+        {
+            // Stage, type and DSP
+            return headerMatches(data, confirmationHeader(), 3);
+        }
+
+        bool isEndOfTransmission(const PacketRawType& data)
+        {
+            // Stage, type, DSP, knob and slot of the last Dly/Rev knob preset
+            return headerMatches(data, lastKnobPresetConfirmationHeader(), 5);
+        }
+
+        bool isSameEffect(const std::optional<PacketRawType>& lhs, const std::optional<PacketRawType>& rhs)
+        {
+            if (!lhs.has_value() || !rhs.has_value())
+            {
+                return false;
+            }
+            const auto lhsPayload = PacketView<EffectPayload>{*lhs}.getPayload();
+            const auto rhsPayload = PacketView<EffectPayload>{*rhs}.getPayload();
+            return (lhsPayload.getModel() == rhsPayload.getModel()) && (lhsPayload.getSlot() == rhsPayload.getSlot());
+        }
+
+        PacketRawType effectSettingsPacket(const fx_pedal_settings& effect)
+        {
+            return (effect.effect_num == effects::EMPTY) ? PacketRawType{} : serializeEffectSettings(effect).getBytes();
+        }
+
+        bool isSamePreset(const SignalChain& lhs, const SignalChain& rhs)
+        {
+            const auto lhsEffects = lhs.effects();
+            const auto rhsEffects = rhs.effects();
+
+            return (lhs.name() == rhs.name())
+                && (serializeAmpSettings(lhs.amp()).getBytes() == serializeAmpSettings(rhs.amp()).getBytes())
+                && (serializeAmpSettingsUsbGain(lhs.amp()).getBytes() == serializeAmpSettingsUsbGain(rhs.amp()).getBytes())
+                && std::equal(lhsEffects.cbegin(), lhsEffects.cend(), rhsEffects.cbegin(), rhsEffects.cend(), [](const auto& a, const auto& b)
+                              { return effectSettingsPacket(a) == effectSettingsPacket(b); });
+        }
+
+        bool isSamePayload(const PacketRawType& lhs, const PacketRawType& rhs)
+        {
+            return std::equal(std::next(lhs.cbegin(), layout::headerSize), lhs.cend(), std::next(rhs.cbegin(), layout::headerSize));
+        }
+
+        // Settings of all DSPs followed by the save of the name; the effects are in order of the DSPs
+        std::vector<PacketRawType> restorePackets(std::uint8_t slot, const SignalChain& preset)
+        {
+            const auto applyCommand = serializeApplyCommand().getBytes();
+            const auto fxSettings = preset.effects();
+            std::vector<PacketRawType> packets{serializeAmpSettings(preset.amp()).getBytes(), applyCommand,
+                                               serializeAmpSettingsUsbGain(preset.amp()).getBytes(), applyCommand};
+
+            for (std::size_t i = 0; i < std::min(fxSettings.size(), familyEffects.size()); ++i)
+            {
+                const auto& effect = fxSettings[i];
+                const bool empty = (effect.effect_num == effects::EMPTY);
+
+                packets.push_back(serializeClearEffectSettings(empty ? fx_pedal_settings{FxSlot{0}, familyEffects[i], 0, 0, 0, 0, 0, 0, false} : effect).getBytes());
+                packets.push_back(applyCommand);
+
+                if (!empty)
+                {
+                    packets.push_back(serializeEffectSettings(effect).getBytes());
+                    packets.push_back(applyCommand);
+                }
+            }
+
+            packets.push_back(serializeName(slot, preset.name()).getBytes());
+            return packets;
+        }
+
+        fx_pedal_settings decodeEffect(const PacketRawType& packet)
+        {
+            const auto payload = PacketView<EffectPayload>{packet}.getPayload();
+            return fx_pedal_settings{FxSlot{payload.getSlot()}, lookupEffectById(payload.getModel()), payload.getKnob1(), payload.getKnob2(),
+                                     payload.getKnob3(), payload.getKnob4(), payload.getKnob5(), payload.getKnob6(), true};
+        }
+    }
+
+    SignalChain decode_data(std::span<const PacketRawType, 7> data)
+    {
+        const auto name = decodeNameFromData(PacketView<NamePayload>{data[0]});
+        const auto amp = decodeAmpFromData(PacketView<AmpPayload>{data[1]}, PacketView<AmpPayload>{data[6]});
+        const auto effects = decodeEffectsFromData({{PacketView<EffectPayload>{data[2]}, PacketView<EffectPayload>{data[3]},
+                                                     PacketView<EffectPayload>{data[4]}, PacketView<EffectPayload>{data[5]}}});
 
         return SignalChain{name, amp, effects};
     }
 
-    std::vector<std::uint8_t> receivePacket(Connection& conn)
+    std::size_t receivePacket(Connection& conn, PacketRawType& packet)
     {
-        return conn.receive(packetRawTypeSize);
+        return conn.receiveInto(packet);
     }
 
 
     void sendCommand(Connection& conn, const PacketRawType& packet)
     {
         conn.send(packet);
-        receivePacket(conn);
+        PacketRawType ack{};
+        receivePacket(conn, ack);
+    }
+
+    std::string sendCommandBatch(Connection& conn, std::span<const PacketRawType> packets)
+    {
+        // All commands are queued before the acknowledges are matched, so the sequence costs a single round trip
+        const auto sent = conn.sendBatch(packets);
+
+        std::string failed;
+        PacketRawType ack{};
+
+        for (std::size_t i = 0; i < packets.size(); ++i)
+        {
+            // Commands that weren't sent have no acknowledge to match
+            if ((i >= sent) || (receivePacket(conn, ack) == 0))
+            {
+                failed += (failed.empty() ? "" : ", ") + std::to_string(i + 1);
+            }
+        }
+        return failed;
     }
 
-    void sendApplyCommand(Connection& conn)
+    void sendCommandsPipelined(Connection& conn, std::span<const PacketRawType> packets)
     {
-        sendCommand(conn, serializeApplyCommand().getBytes());
+        if (const auto failed = sendCommandBatch(conn, packets); failed.empty() == false)
+        {
+            throw CommunicationException{"Command(s) " + failed + " of " + std::to_string(packets.size()) + " failed"};
+        }
     }
 
-    std::array<PacketRawType, 7> loadBankData(Connection& conn, std::uint8_t slot)
+    template <class Container>
+    std::vector<PacketRawType> toRawPackets(const Container& packets)
     {
-        std::array<PacketRawType, 7> data{{}};
+        std::vector<PacketRawType> raw;
+        raw.reserve(packets.size());
+        std::transform(packets.cbegin(), packets.cend(), std::back_inserter(raw), [](const auto& p)
+                       { return p.getBytes(); });
+        return raw;
+    }
 
-        const auto loadCommand = serializeLoadSlotCommand(slot);
-        auto n = conn.send(loadCommand.getBytes());
+    std::array<PacketRawType, 7> receiveBankData(Connection& conn)
+    {
+        std::array<PacketRawType, 7> data{{}};
+        std::size_t n{packetRawTypeSize};
+        PacketRawType packet{};
 
         for (std::size_t i = 0; n != 0; ++i)
         {
-            const auto recvData = receivePacket(conn);
-            n = recvData.size();
-
-            if (i < 7)
+            if (i < numberOfBankPackets)
             {
-                std::copy(recvData.cbegin(), recvData.cend(), data[i].begin());
+                n = receivePacket(conn, data[i]);
+            }
+            else
+            {
+                packet.fill(0x00);
+                n = receivePacket(conn, packet);
+
+                if ((n != 0) && isConfirmationPacket(packet))
+                {
+                    break;
+                }
             }
         }
         return data;
     }
 
+    std::array<PacketRawType, 7> loadBankData(Connection& conn, std::uint8_t slot)
+    {
+        const auto loadCommand = serializeLoadSlotCommand(slot);
 
-    Mustang::Mustang(DeviceModel deviceModel, std::shared_ptr<Connection> connection)
-        : model(deviceModel), conn(connection)
+        if (conn.send(loadCommand.getBytes()) == 0)
+        {
+            return {{}};
+        }
+        return receiveBankData(conn);
+    }
+
+    bool isStored(Connection& conn, std::uint8_t slot, const SignalChain& preset)
+    {
+        try
+        {
+            return isSamePreset(decode_data(loadBankData(conn, slot)), preset);
+        }
+        catch (const std::invalid_argument&)
+        {
+            // Incomplete or invalid bank received
+            return false;
+        }
+    }
+
+    std::span<const PacketRawType> knobPresetPackets(std::span<const PacketRawType> dump, std::size_t numberOfPresetPackets)
+    {
+        // Preset names, current bank and its confirmation precede the knob presets
+        return dump.subspan(std::min(dump.size(), numberOfPresetPackets + numberOfBankPackets + 1));
+    }
+
+
+    Mustang::Mustang(DeviceModel deviceModel, std::shared_ptr<Connection> connection, std::shared_ptr<OperationObserver> operationObserver)
+        : model(deviceModel), conn(connection), observer(std::move(operationObserver))
     {
     }
 
     InitialData Mustang::start_amp()
     {
+        const OperationScope scope{observer.get(), Operation::startAmp};
+
         if (conn->isOpen() == false)
         {
             throw CommunicationException{"Device not connected"};
         }
 
+        resetShadowState();
         initializeAmp();
 
         return loadData();
@@ -94,56 +286,188 @@ namespace plug::com
 
     void Mustang::stop_amp()
     {
+        resetShadowState();
         conn->close();
     }
 
     void Mustang::set_effect(fx_pedal_settings value)
     {
-        const auto clearEffectPacket = serializeClearEffectSettings(value);
-        sendCommand(*conn, clearEffectPacket.getBytes());
-        sendApplyCommand(*conn);
+        const OperationScope scope{observer.get(), Operation::setEffect};
+
+        const auto applyCommand = serializeApplyCommand().getBytes();
+        const auto clearPacket = serializeClearEffectSettings(value).getBytes();
+        const auto dsp = clearPacket[dspPosition];
+        const std::optional<PacketRawType> settingsPacket = ((value.enabled == true) && (value.effect_num != effects::EMPTY))
+                                                                ? std::optional{serializeEffectSettings(value).getBytes()}
+                                                                : std::nullopt;
+
+        const auto shadow = effectShadows.find(dsp);
 
-        if ((value.enabled == true) && (value.effect_num != effects::EMPTY))
+        if ((shadow != effectShadows.cend()) && (shadow->second == settingsPacket))
         {
-            const auto settingsPacket = serializeEffectSettings(value);
-            sendCommand(*conn, settingsPacket.getBytes());
-            sendApplyCommand(*conn);
+            return;
         }
+
+        std::vector<PacketRawType> packets;
+
+        // Changed knobs of the same effect don't require the DSP to be cleared before
+        if ((shadow == effectShadows.cend()) || !isSameEffect(shadow->second, settingsPacket))
+        {
+            packets.push_back(clearPacket);
+            packets.push_back(applyCommand);
+        }
+
+        if (settingsPacket.has_value())
+        {
+            packets.push_back(*settingsPacket);
+            packets.push_back(applyCommand);
+        }
+
+        effectShadows.erase(dsp);
+        sendCommandsPipelined(*conn, packets);
+        effectShadows.emplace(dsp, settingsPacket);
     }
 
     void Mustang::set_amplifier(amp_settings value)
     {
-        const auto settingsPacket = serializeAmpSettings(value);
-        sendCommand(*conn, settingsPacket.getBytes());
-        sendApplyCommand(*conn);
+        const OperationScope scope{observer.get(), Operation::setAmplifier};
+
+        const auto applyCommand = serializeApplyCommand().getBytes();
+        const auto settingsPacket = serializeAmpSettings(value).getBytes();
+        const auto settingsGainPacket = serializeAmpSettingsUsbGain(value).getBytes();
+        std::vector<PacketRawType> packets;
+
+        if (ampShadow != settingsPacket)
+        {
+            packets.push_back(settingsPacket);
+            packets.push_back(applyCommand);
+        }
+
+        if (usbGainShadow != settingsGainPacket)
+        {
+            packets.push_back(settingsGainPacket);
+            packets.push_back(applyCommand);
+        }
 
-        const auto settingsGainPacket = serializeAmpSettingsUsbGain(value);
-        sendCommand(*conn, settingsGainPacket.getBytes());
-        sendApplyCommand(*conn);
+        if (packets.empty() == true)
+        {
+            return;
+        }
+
+        ampShadow.reset();
+        usbGainShadow.reset();
+        sendCommandsPipelined(*conn, packets);
+        ampShadow = settingsPacket;
+        usbGainShadow = settingsGainPacket;
     }
 
     void Mustang::save_on_amp(std::string_view name, std::uint8_t slot)
     {
+        const OperationScope scope{observer.get(), Operation::saveOnAmp};
+
+        resetShadowState();
         const auto data = serializeName(slot, name).getBytes();
         sendCommand(*conn, data);
         loadBankData(*conn, slot);
+        selectedSlot = slot;
     }
 
     SignalChain Mustang::load_memory_bank(std::uint8_t slot)
     {
-        return decode_data(loadBankData(*conn, slot));
+        const OperationScope scope{observer.get(), Operation::loadMemoryBank};
+
+        resetShadowState();
+        const auto signalChain = decode_data(loadBankData(*conn, slot));
+        selectedSlot = slot;
+        return signalChain;
+    }
+
+    void Mustang::select_memory_bank(std::uint8_t slot)
+    {
+        // The amp transmits the bank anyway, it's received but not decoded
+        resetShadowState();
+        loadBankData(*conn, slot);
+        selectedSlot = slot;
     }
 
     void Mustang::save_effects(std::uint8_t slot, std::string_view name, const std::vector<fx_pedal_settings>& effects)
     {
-        const auto saveNamePacket = serializeSaveEffectName(slot, name, effects);
-        sendCommand(*conn, saveNamePacket.getBytes());
+        resetShadowState();
+        auto packets = toRawPackets(serializeSaveEffectPacket(slot, effects));
+        packets.insert(packets.cbegin(), serializeSaveEffectName(slot, name, effects).getBytes());
+        packets.push_back(serializeApplyCommand(effects[0]).getBytes());
+
+        sendCommandsPipelined(*conn, packets);
+    }
+
+    void Mustang::backupAll(std::ostream& out)
+    {
+        resetShadowState();
 
-        const auto packets = serializeSaveEffectPacket(slot, effects);
-        std::for_each(packets.cbegin(), packets.cend(), [this](const auto& p)
-                      { sendCommand(*conn, p.getBytes()); });
+        const auto dump = receiveDump();
+        const std::span<const PacketRawType> packets{dump.packets};
+        const auto presetNames = decodePresetListFromData(packets.first(std::min(packets.size(), dump.numberOfPresetPackets)));
 
-        sendCommand(*conn, serializeApplyCommand(effects[0]).getBytes());
+        writeBackupHeader(out);
+        writeBackupKnobPresets(out, knobPresetPackets(packets, dump.numberOfPresetPackets));
+
+        // Banks are requested in chunks and streamed as they arrive; the banks of a chunk fit into the receive queue
+        std::vector<PacketRawType> loadCommands;
+        loadCommands.reserve(backupChunkSize);
+
+        for (std::size_t first = 0; first < presetNames.size(); first += backupChunkSize)
+        {
+            const auto count = std::min(backupChunkSize, presetNames.size() - first);
+            loadCommands.clear();
+
+            for (std::size_t slot = first; slot < first + count; ++slot)
+            {
+                loadCommands.push_back(serializeLoadSlotCommand(static_cast<std::uint8_t>(slot)).getBytes());
+            }
+
+            const auto sent = conn->sendBatch(loadCommands);
+
+            for (std::size_t i = 0; i < sent; ++i)
+            {
+                writeBackupBank(out, receiveBankData(*conn));
+            }
+
+            if (sent != count)
+            {
+                throw CommunicationException{"Backup incomplete, " + std::to_string(first + sent) + " of " + std::to_string(presetNames.size()) + " banks received"};
+            }
+        }
+
+        // Loading the banks changes the selection, the preset active before is selected again
+        if (selectedSlot.has_value())
+        {
+            loadBankData(*conn, *selectedSlot);
+        }
+    }
+
+    void Mustang::restoreAll(const AmpBackup& backup)
+    {
+        resetShadowState();
+
+        for (std::size_t slot = 0; slot < backup.banks.size(); ++slot)
+        {
+            const auto preset = decode_data(backup.banks[slot]);
+            const auto slotId = static_cast<std::uint8_t>(slot);
+
+            // Settings, applies and the save of a slot are acknowledged in a single round trip, the stored bank is read back for verification
+            sendCommandsPipelined(*conn, restorePackets(slotId, preset));
+
+            if (!isStored(*conn, slotId, preset))
+            {
+                throw CommunicationException{"Verification of slot " + std::to_string(slot + 1) + " failed"};
+            }
+        }
+
+        if (backup.knobPresets.empty() == false)
+        {
+            restoreKnobPresets(backup.knobPresets);
+        }
+        resetShadowState();
     }
 
     DeviceModel Mustang::getDeviceModel() const
@@ -154,40 +478,109 @@ namespace plug::com
 
     InitialData Mustang::loadData()
     {
-        std::vector<std::array<std::uint8_t, 64>> recieved_data;
+        const auto dump = receiveDump();
+
+        if (dump.packets.size() < (dump.numberOfPresetPackets + numberOfBankPackets))
+        {
+            throw CommunicationException{"Incomplete dump"};
+        }
 
+        // Decoded in place from the received packets
+        const std::span<const PacketRawType> packets{dump.packets};
+        auto presetNames = decodePresetListFromData(packets.first(dump.numberOfPresetPackets));
+        const auto current = packets.subspan(dump.numberOfPresetPackets).first<numberOfBankPackets>();
+        selectedSlot = HeaderView{std::span{current.front()}.first<layout::headerSize>()}.getSlot();
+
+        return {decode_data(current), presetNames};
+    }
+
+    Mustang::Dump Mustang::receiveDump()
+    {
         const auto loadCommand = serializeLoadCommand();
         auto recieved = conn->send(loadCommand.getBytes());
 
+        // Preset names, current state and Mod / Dly/Rev knob presets; the last knob preset confirmation terminates the transmission
+        const bool knownLength = model.numberOfPresets() > 0;
+        const std::size_t knobPresetsStart = (model.numberOfPresets() * 2) + numberOfBankPackets + 1;
+
+        // Packets are received in place, the buffer is allocated once for the whole transmission
+        std::vector<PacketRawType> recieved_data;
+        recieved_data.reserve(knownLength ? (knobPresetsStart + numberOfKnobPresetPackets + 1) : maxUnknownLengthPackets);
+
         while (recieved != 0)
         {
-            const auto recvData = receivePacket(*conn);
-            recieved = recvData.size();
-            PacketRawType p{};
-            std::copy(recvData.cbegin(), recvData.cend(), p.begin());
-            recieved_data.push_back(p);
+            auto& packet = recieved_data.emplace_back();
+            recieved = receivePacket(*conn, packet);
+
+            if (knownLength && (recieved != 0) && (recieved_data.size() > knobPresetsStart) && isEndOfTransmission(packet))
+            {
+                break;
+            }
+        }
+
+        const std::size_t numPresetPackets = knownLength ? (model.numberOfPresets() * 2) : (recieved_data.size() > 143 ? 200 : 48);
+        return {std::move(recieved_data), numPresetPackets};
+    }
+
+    void Mustang::restoreKnobPresets(std::span<const PacketRawType> packets)
+    {
+        // Each knob preset is its name and effects, terminated by a confirmation
+        auto start = packets.begin();
+
+        for (auto itr = packets.begin(); itr != packets.end(); ++itr)
+        {
+            if (!isConfirmationPacket(*itr))
+            {
+                continue;
+            }
+
+            const std::span<const PacketRawType> preset{start, itr};
+            start = std::next(itr);
+
+            if (preset.empty())
+            {
+                continue;
+            }
+
+            const auto slot = HeaderView{std::span{*itr}.first<layout::headerSize>()}.getSlot();
+            std::vector<fx_pedal_settings> fxSettings;
+
+            for (const auto& packet : preset.subspan(1))
+            {
+                if (const auto effect = decodeEffect(packet); effect.effect_num != effects::EMPTY)
+                {
+                    fxSettings.push_back(effect);
+                }
+            }
+
+            if (fxSettings.empty() == false)
+            {
+                auto commands = toRawPackets(serializeSaveEffectPacket(slot, fxSettings));
+                commands.insert(commands.cbegin(), serializeSaveEffectName(slot, decodeNameFromData(PacketView<NamePayload>{preset.front()}), fxSettings).getBytes());
+                commands.push_back(serializeApplyCommand(fxSettings[0]).getBytes());
+                sendCommandsPipelined(*conn, commands);
+            }
         }
 
-        const std::size_t numPresetPackets = model.numberOfPresets() > 0 ? (model.numberOfPresets() * 2) : (recieved_data.size() > 143 ? 200 : 48);
-        std::vector<Packet<NamePayload>> presetListData;
-        presetListData.reserve(numPresetPackets);
-        std::transform(recieved_data.cbegin(), std::next(recieved_data.cbegin(), numPresetPackets), std::back_inserter(presetListData), [](const auto& p)
-                       {
-            Packet<NamePayload> packet{};
-            packet.fromBytes(p);
-            return packet; });
-        auto presetNames = decodePresetListFromData(presetListData);
+        // The knob presets are read back for verification
+        const auto dump = receiveDump();
+        const auto restored = knobPresetPackets(dump.packets, dump.numberOfPresetPackets);
 
-        std::array<PacketRawType, 7> presetData{{}};
-        std::copy(std::next(recieved_data.cbegin(), numPresetPackets), std::next(recieved_data.cbegin(), numPresetPackets + 7), presetData.begin());
+        if (!std::equal(packets.begin(), packets.end(), restored.begin(), restored.end(), isSamePayload))
+        {
+            throw CommunicationException{"Verification of the knob presets failed"};
+        }
+    }
 
-        return {decode_data(presetData), presetNames};
+    void Mustang::resetShadowState()
+    {
+        ampShadow.reset();
+        usbGainShadow.reset();
+        effectShadows.clear();
     }
 
     void Mustang::initializeAmp()
     {
-        const auto packets = serializeInitCommand();
-        std::for_each(packets.cbegin(), packets.cend(), [this](const auto& p)
-                      { sendCommand(*conn, p.getBytes()); });
+        sendCommandsPipelined(*conn, toRawPackets(serializeInitCommand()));
     }
 }
@@ -19,14 +19,17 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "com/MustangUpdater.h"
-#include "com/Mustang.h"
-#include "com/Packet.h"
-#include <chrono>
-#include <cstdio>
-#include <cstring>
-#include <unistd.h>
-#include <libusb-1.0/libusb.h>
+#include "com/CommunicationException.h"
+#include "com/MappedFile.h"
+#include "com/UsbContext.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace plug::com
 {
@@ -40,134 +43,159 @@ namespace plug::com
         inline constexpr std::uint16_t FLOOR_USB_UPDATE_PID{0x0013};         // Mustang Floor
         inline constexpr std::uint16_t SMALL_AMPS_V2_USB_UPDATE_PID{0x0015}; // Mustang I & II V2
         inline constexpr std::uint16_t BIG_AMPS_V2_USB_UPDATE_PID{0x0017};   // Mustang III+ V2
-    }
 
-    namespace
-    {
-        void closeUsb(libusb_device_handle* handle)
+        inline constexpr std::array updatePids{SMALL_AMPS_USB_UPDATE_PID, BIG_AMPS_USB_UPDATE_PID, SMALL_AMPS_V2_USB_UPDATE_PID,
+                                               BIG_AMPS_V2_USB_UPDATE_PID, MINI_USB_UPDATE_PID, FLOOR_USB_UPDATE_PID};
+
+        inline constexpr std::uint8_t endpointSend{0x01};
+        inline constexpr std::uint8_t endpointRecv{0x81};
+
+
+        // The bootloader answers each packet with one acknowledge, which is read synchronously; no receive ring and name lookup as in UsbComm
+        class UpdateConnection : public Connection
         {
-            if (handle != nullptr)
+        public:
+            explicit UpdateConnection(usb::Device device)
+                : device_(std::move(device))
             {
-                const int ret = libusb_release_interface(handle, 0);
+                device_.open();
+            }
 
-                if (ret != LIBUSB_ERROR_NO_DEVICE)
-                {
-                    libusb_attach_kernel_driver(handle, 0);
-                }
+            void close() override
+            {
+                device_.close();
+            }
 
-                libusb_close(handle);
-                libusb_exit(nullptr);
+            bool isOpen() const override
+            {
+                return device_.isOpen();
+            }
+
+            std::vector<std::uint8_t> receive(std::size_t recvSize) override
+            {
+                return device_.receive(endpointRecv, recvSize);
             }
-        }
 
+            std::string name() const override
+            {
+                return "Mustang (update mode)";
+            }
 
-        inline constexpr std::chrono::milliseconds timeout{500};
-        inline constexpr std::size_t sizeOfPacket = packetRawTypeSize;
-    }
+        private:
+            std::size_t sendImpl(const std::uint8_t* data, std::size_t size) override
+            {
+                return device_.write(endpointSend, data, size);
+            }
 
+            usb::Device device_;
+        };
+    }
 
-    int updateFirmware(const char* filename)
+    namespace
     {
-        // initialize libusb
-        int ret = libusb_init(nullptr);
-        if (ret != 0)
+        inline constexpr std::size_t dateOffset{0x1a};
+        inline constexpr std::size_t dateSize{11};
+        inline constexpr std::size_t dataOffset{0x110};
+        inline constexpr std::size_t chunkHeaderSize{4};
+        inline constexpr std::size_t chunkSize{packetRawTypeSize - 8};
+
+        // Chunks are sent until a short one; data of a multiple of the chunk size ends with an empty chunk
+        std::size_t numberOfChunks(std::span<const std::uint8_t> firmware)
         {
-            return ret;
+            return ((firmware.size() - dataOffset) / chunkSize) + 1;
         }
+    }
 
-        // get handle for the device
-        libusb_device_handle* amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, SMALL_AMPS_USB_UPDATE_PID);
-        if (amp_hand == nullptr)
+
+    std::size_t numberOfFirmwarePackets(std::span<const std::uint8_t> firmware)
+    {
+        if (firmware.size() < dataOffset)
         {
-            amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, BIG_AMPS_USB_UPDATE_PID);
-            if (amp_hand == nullptr)
-            {
-                amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, SMALL_AMPS_V2_USB_UPDATE_PID);
-                if (amp_hand == nullptr)
-                {
-                    amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, BIG_AMPS_V2_USB_UPDATE_PID);
-                    if (amp_hand == nullptr)
-                    {
-                        amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, MINI_USB_UPDATE_PID);
-                        if (amp_hand == nullptr)
-                        {
-                            amp_hand = libusb_open_device_with_vid_pid(nullptr, USB_UPDATE_VID, FLOOR_USB_UPDATE_PID);
-                            if (amp_hand == nullptr)
-                            {
-                                libusb_exit(nullptr);
-                                return -100;
-                            }
-                        }
-                    }
-                }
-            }
+            throw CommunicationException{"Invalid firmware file"};
         }
+        return numberOfChunks(firmware) + 2;
+    }
+
+    PacketRawType serializeFirmwarePacket(std::span<const std::uint8_t> firmware, std::size_t index)
+    {
+        const auto total = numberOfFirmwarePackets(firmware);
+        PacketRawType packet{};
 
-        // detach kernel driver
-        ret = libusb_kernel_driver_active(amp_hand, 0);
-        if (ret != 0)
+        if (index == 0)
         {
-            ret = libusb_detach_kernel_driver(amp_hand, 0);
-            if (ret != 0)
-            {
-                closeUsb(amp_hand);
-                return ret;
-            }
+            // Date when the firmware was created
+            packet[0] = 0x02;
+            packet[1] = 0x03;
+            packet[2] = 0x01;
+            packet[3] = 0x06;
+            const auto date = firmware.subspan(dateOffset, dateSize);
+            std::copy(date.begin(), date.end(), std::next(packet.begin(), chunkHeaderSize));
         }
-
-        // claim the device
-        ret = libusb_claim_interface(amp_hand, 0);
-        if (ret != 0)
+        else if (index < (total - 1))
         {
-            closeUsb(amp_hand);
-            return ret;
+            const auto data = firmware.subspan(dataOffset);
+            const auto offset = (index - 1) * chunkSize;
+            const auto chunk = data.subspan(offset, std::min(chunkSize, data.size() - offset));
+
+            packet[0] = 0x03;
+            packet[1] = 0x03;
+            packet[3] = static_cast<std::uint8_t>(chunk.size());
+            std::copy(chunk.begin(), chunk.end(), std::next(packet.begin(), chunkHeaderSize));
         }
+        else if (index == (total - 1))
+        {
+            packet[0] = 0x04;
+            packet[1] = 0x03;
+        }
+        else
+        {
+            throw std::out_of_range{"Invalid firmware packet index: " + std::to_string(index)};
+        }
+        return packet;
+    }
 
-        FILE* file = fopen(filename, "rb");
-        // send date when firmware was created
-        fseek(file, 0x1a, SEEK_SET);
-        unsigned char array[sizeOfPacket];
-        memset(array, 0x00, sizeOfPacket);
-        array[0] = 0x02;
-        array[1] = 0x03;
-        array[2] = 0x01;
-        array[3] = 0x06;
-        [[maybe_unused]] const auto n = fread(array + 4, 1, 11, file);
-        int recieved{0};
-        ret = libusb_interrupt_transfer(amp_hand, 0x01, array, sizeOfPacket, &recieved, timeout.count());
-        libusb_interrupt_transfer(amp_hand, 0x81, array, sizeOfPacket, &recieved, timeout.count());
-        usleep(10000);
-
-        // send firmware
-        fseek(file, 0x110, SEEK_SET);
-        for (;;)
+    UpdateStatus updateFirmware(Connection& conn, std::span<const std::uint8_t> firmware, const UpdateProgress& progress, std::stop_token stopToken)
+    {
+        const auto total = numberOfFirmwarePackets(firmware);
+        PacketRawType ack{};
+
+        for (std::size_t i = 0; i < total; ++i)
         {
-            memset(array, 0x00, sizeOfPacket);
-            unsigned char number{0};
-            array[0] = array[1] = 0x03;
-            array[2] = number;
-            ++number;
-            array[3] = static_cast<std::uint8_t>(fread(array + 4, 1, sizeOfPacket - 8, file));
-            ret = libusb_interrupt_transfer(amp_hand, 0x01, array, sizeOfPacket, &recieved, timeout.count());
-            libusb_interrupt_transfer(amp_hand, 0x81, array, sizeOfPacket, &recieved, timeout.count());
-            usleep(10000);
-
-            if (feof(file) != 0) // if reached end of the file
+            if (stopToken.stop_requested())
+            {
+                return UpdateStatus::cancelled;
+            }
+
+            const auto packet = serializeFirmwarePacket(firmware, i);
+
+            if ((conn.send(packet) != packet.size()) || (conn.receiveInto(ack) == 0))
+            {
+                throw CommunicationException{"Firmware packet " + std::to_string(i + 1) + " of " + std::to_string(total) + " not acknowledged"};
+            }
+
+            if (progress)
             {
-                break; // exit loop
+                progress(i + 1, total);
             }
         }
-        fclose(file);
+        return UpdateStatus::finished;
+    }
 
-        // send "finished" packet
-        memset(array, 0x00, sizeOfPacket);
-        array[0] = 0x04;
-        array[1] = 0x03;
-        libusb_interrupt_transfer(amp_hand, 0x01, array, sizeOfPacket, &recieved, timeout.count());
-        libusb_interrupt_transfer(amp_hand, 0x81, array, sizeOfPacket, &recieved, timeout.count());
+    UpdateStatus updateFirmware(const std::string& filename, const UpdateProgress& progress, std::stop_token stopToken)
+    {
+        const MappedFile file{filename};
+        auto device = usb::findDevice([](std::uint16_t vendorId, std::uint16_t productId)
+                                      { return (vendorId == USB_UPDATE_VID) && std::any_of(updatePids.cbegin(), updatePids.cend(), [productId](std::uint16_t pid)
+                                                                                          { return productId == pid; }); });
 
-        closeUsb(amp_hand);
+        if (!device.has_value())
+        {
+            throw CommunicationException{"Suitable device not found"};
+        }
 
-        return 0;
+        UpdateConnection conn{std::move(*device)};
+        const auto status = updateFirmware(conn, file.data(), progress, stopToken);
+        conn.close();
+        return status;
     }
 }
@@ -19,13 +19,14 @@
  */
 
 #include "com/Packet.h"
+#include "com/PacketView.h"
 #include <stdexcept>
 
 namespace plug::com
 {
     void Header::setStage(Stage stage)
     {
-        bytes[0] = [stage]() -> std::uint8_t
+        bytes[layout::header::stage] = [stage]() -> std::uint8_t
         {
             switch (stage)
             {
@@ -43,22 +44,12 @@ namespace plug::com
 
     Stage Header::getStage() const
     {
-        switch (bytes[0])
-        {
-            case 0x00:
-                return Stage::init0;
-            case 0x1a:
-                return Stage::init1;
-            case 0x1c:
-                return Stage::ready;
-            default:
-                return Stage::unknown;
-        }
+        return HeaderView{bytes}.getStage();
     }
 
     void Header::setType(Type type)
     {
-        bytes[1] = [type]() -> std::uint8_t
+        bytes[layout::header::type] = [type]() -> std::uint8_t
         {
             switch (type)
             {
@@ -80,24 +71,12 @@ namespace plug::com
 
     Type Header::getType() const
     {
-        switch (bytes[1])
-        {
-            case 0x01:
-                return Type::operation;
-            case 0x03:
-                return Type::data; // Same value as Type::init1
-            case 0xc3:
-                return Type::init0;
-            case 0xc1:
-                return Type::load;
-            default:
-                throw std::domain_error("Invalid Type: " + std::to_string(bytes[1]));
-        }
+        return HeaderView{bytes}.getType();
     }
 
     void Header::setDSP(DSP dsp)
     {
-        bytes[2] = [dsp]() -> std::uint8_t
+        bytes[layout::header::dsp] = [dsp]() -> std::uint8_t
         {
             switch (dsp)
             {
@@ -129,41 +108,17 @@ namespace plug::com
 
     DSP Header::getDSP() const
     {
-        switch (bytes[2])
-        {
-            case 0x00:
-                return DSP::none;
-            case 0x05:
-                return DSP::amp;
-            case 0x0d:
-                return DSP::usbGain;
-            case 0x06:
-                return DSP::effect0;
-            case 0x07:
-                return DSP::effect1;
-            case 0x08:
-                return DSP::effect2;
-            case 0x09:
-                return DSP::effect3;
-            case 0x03:
-                return DSP::opSave;
-            case 0x04:
-                return DSP::opSaveEffectName;
-            case 0x01:
-                return DSP::opSelectMemBank;
-            default:
-                throw std::domain_error("Invalid DSP: " + std::to_string(bytes[2]));
-        }
+        return HeaderView{bytes}.getDSP();
     }
 
     void Header::setSlot(std::uint8_t slot)
     {
-        bytes[4] = slot;
+        bytes[layout::header::slot] = slot;
     }
 
     std::uint8_t Header::getSlot() const
     {
-        return bytes[4];
+        return HeaderView{bytes}.getSlot();
     }
 
     void Header::setUnknown(std::uint8_t value0, std::uint8_t value1, std::uint8_t value2)
@@ -197,100 +152,95 @@ namespace plug::com
 
     void NamePayload::setName(std::string_view name)
     {
-        constexpr std::size_t nameLength{32};
-        const auto n = std::min(name.length(), nameLength);
-        std::copy_n(name.cbegin(), n, bytes.begin());
+        const auto n = std::min(name.length(), layout::name::length);
+        std::copy_n(name.cbegin(), n, std::next(bytes.begin(), layout::name::name));
     }
 
     std::string NamePayload::getName() const
     {
-        constexpr std::size_t nameLength{32};
-        const auto end = std::find(bytes.cbegin(), bytes.cend(), '\0');
-        const auto maxEnd = std::next(bytes.cbegin(), nameLength);
-
-        return std::string(bytes.cbegin(), std::min(end, maxEnd));
+        return NamePayloadView{bytes}.getName();
     }
 
 
     void EffectPayload::setKnob1(std::uint8_t value)
     {
-        bytes[16] = value;
+        bytes[layout::effect::knob1] = value;
     }
 
     std::uint8_t EffectPayload::getKnob1() const
     {
-        return bytes[16];
+        return EffectPayloadView{bytes}.getKnob1();
     }
 
     void EffectPayload::setKnob2(std::uint8_t value)
     {
-        bytes[17] = value;
+        bytes[layout::effect::knob2] = value;
     }
 
     std::uint8_t EffectPayload::getKnob2() const
     {
-        return bytes[17];
+        return EffectPayloadView{bytes}.getKnob2();
     }
 
     void EffectPayload::setKnob3(std::uint8_t value)
     {
-        bytes[18] = value;
+        bytes[layout::effect::knob3] = value;
     }
 
     std::uint8_t EffectPayload::getKnob3() const
     {
-        return bytes[18];
+        return EffectPayloadView{bytes}.getKnob3();
     }
 
     void EffectPayload::setKnob4(std::uint8_t value)
     {
-        bytes[19] = value;
+        bytes[layout::effect::knob4] = value;
     }
 
     std::uint8_t EffectPayload::getKnob4() const
     {
-        return bytes[19];
+        return EffectPayloadView{bytes}.getKnob4();
     }
 
     void EffectPayload::setKnob5(std::uint8_t value)
     {
-        bytes[20] = value;
+        bytes[layout::effect::knob5] = value;
     }
 
     std::uint8_t EffectPayload::getKnob5() const
     {
-        return bytes[20];
+        return EffectPayloadView{bytes}.getKnob5();
     }
 
     void EffectPayload::setKnob6(std::uint8_t value)
     {
-        bytes[21] = value;
+        bytes[layout::effect::knob6] = value;
     }
 
     std::uint8_t EffectPayload::getKnob6() const
     {
-        return bytes[21];
+        return EffectPayloadView{bytes}.getKnob6();
     }
 
     void EffectPayload::setSlot(std::uint8_t slot)
     {
-        bytes[2] = slot;
+        bytes[layout::effect::slot] = slot;
     }
 
     std::uint8_t EffectPayload::getSlot() const
     {
-        return bytes[2];
+        return EffectPayloadView{bytes}.getSlot();
     }
 
     void EffectPayload::setModel(std::uint16_t model)
     {
-        bytes[0] = model & 0xFF;
-        bytes[1] = (model >> 8) & 0xFF;
+        bytes[layout::effect::modelLow] = model & 0xFF;
+        bytes[layout::effect::modelHigh] = (model >> 8) & 0xFF;
     }
 
     std::uint16_t EffectPayload::getModel() const
     {
-        return (bytes[1] << 8 | bytes[0]);
+        return EffectPayloadView{bytes}.getModel();
     }
 
     void EffectPayload::setUnknown(std::uint8_t value0, std::uint8_t value1, std::uint8_t value2)
@@ -303,162 +253,162 @@ namespace plug::com
 
     void AmpPayload::setModel(std::uint8_t value)
     {
-        bytes[0] = value;
+        bytes[layout::amp::model] = value;
     }
 
     std::uint8_t AmpPayload::getModel() const
     {
-        return bytes[0];
+        return AmpPayloadView{bytes}.getModel();
     }
 
     void AmpPayload::setVolume(std::uint8_t value)
     {
-        bytes[16] = value;
+        bytes[layout::amp::volume] = value;
     }
 
     std::uint8_t AmpPayload::getVolume() const
     {
-        return bytes[16];
+        return AmpPayloadView{bytes}.getVolume();
     }
 
     void AmpPayload::setGain(std::uint8_t value)
     {
-        bytes[17] = value;
+        bytes[layout::amp::gain] = value;
     }
 
     std::uint8_t AmpPayload::getGain() const
     {
-        return bytes[17];
+        return AmpPayloadView{bytes}.getGain();
     }
 
     void AmpPayload::setGain2(std::uint8_t value)
     {
-        bytes[18] = value;
+        bytes[layout::amp::gain2] = value;
     }
 
     std::uint8_t AmpPayload::getGain2() const
     {
-        return bytes[18];
+        return AmpPayloadView{bytes}.getGain2();
     }
 
     void AmpPayload::setMasterVolume(std::uint8_t value)
     {
-        bytes[19] = value;
+        bytes[layout::amp::masterVolume] = value;
     }
 
     std::uint8_t AmpPayload::getMasterVolume() const
     {
-        return bytes[19];
+        return AmpPayloadView{bytes}.getMasterVolume();
     }
 
     void AmpPayload::setTreble(std::uint8_t value)
     {
-        bytes[20] = value;
+        bytes[layout::amp::treble] = value;
     }
 
     std::uint8_t AmpPayload::getTreble() const
     {
-        return bytes[20];
+        return AmpPayloadView{bytes}.getTreble();
     }
 
     void AmpPayload::setMiddle(std::uint8_t value)
     {
-        bytes[21] = value;
+        bytes[layout::amp::middle] = value;
     }
 
     std::uint8_t AmpPayload::getMiddle() const
     {
-        return bytes[21];
+        return AmpPayloadView{bytes}.getMiddle();
     }
 
     void AmpPayload::setBass(std::uint8_t value)
     {
-        bytes[22] = value;
+        bytes[layout::amp::bass] = value;
     }
 
     std::uint8_t AmpPayload::getBass() const
     {
-        return bytes[22];
+        return AmpPayloadView{bytes}.getBass();
     }
 
     void AmpPayload::setPresence(std::uint8_t value)
     {
-        bytes[23] = value;
+        bytes[layout::amp::presence] = value;
     }
 
     std::uint8_t AmpPayload::getPresence() const
     {
-        return bytes[23];
+        return AmpPayloadView{bytes}.getPresence();
     }
 
     void AmpPayload::setDepth(std::uint8_t value)
     {
-        bytes[25] = value;
+        bytes[layout::amp::depth] = value;
     }
 
     std::uint8_t AmpPayload::getDepth() const
     {
-        return bytes[25];
+        return AmpPayloadView{bytes}.getDepth();
     }
 
     void AmpPayload::setBias(std::uint8_t value)
     {
-        bytes[26] = value;
+        bytes[layout::amp::bias] = value;
     }
 
     std::uint8_t AmpPayload::getBias() const
     {
-        return bytes[26];
+        return AmpPayloadView{bytes}.getBias();
     }
 
     void AmpPayload::setNoiseGate(std::uint8_t value)
     {
-        bytes[31] = value;
+        bytes[layout::amp::noiseGate] = value;
     }
 
     std::uint8_t AmpPayload::getNoiseGate() const
     {
-        return bytes[31];
+        return AmpPayloadView{bytes}.getNoiseGate();
     }
 
     void AmpPayload::setThreshold(std::uint8_t value)
     {
-        bytes[32] = value;
+        bytes[layout::amp::threshold] = value;
     }
 
     std::uint8_t AmpPayload::getThreshold() const
     {
-        return bytes[32];
+        return AmpPayloadView{bytes}.getThreshold();
     }
 
     void AmpPayload::setCabinet(std::uint8_t value)
     {
-        bytes[33] = value;
+        bytes[layout::amp::cabinet] = value;
     }
 
     std::uint8_t AmpPayload::getCabinet() const
     {
-        return bytes[33];
+        return AmpPayloadView{bytes}.getCabinet();
     }
 
     void AmpPayload::setSag(std::uint8_t value)
     {
-        bytes[35] = value;
+        bytes[layout::amp::sag] = value;
     }
 
     std::uint8_t AmpPayload::getSag() const
     {
-        return bytes[35];
+        return AmpPayloadView{bytes}.getSag();
     }
 
     void AmpPayload::setBrightness(std::uint8_t value)
     {
-        bytes[36] = value;
+        bytes[layout::amp::brightness] = value;
     }
 
     std::uint8_t AmpPayload::getBrightness() const
     {
-        return bytes[36];
+        return AmpPayloadView{bytes}.getBrightness();
     }
 
     void AmpPayload::setUnknown(std::uint8_t value0, std::uint8_t value1, std::uint8_t value2)
@@ -479,11 +429,80 @@ namespace plug::com
 
     void AmpPayload::setUsbGain(std::uint8_t value)
     {
-        bytes[0] = value;
+        bytes[layout::amp::usbGain] = value;
     }
 
     std::uint8_t AmpPayload::getUsbGain() const
     {
-        return bytes[0];
+        return AmpPayloadView{bytes}.getUsbGain();
+    }
+
+
+    Stage HeaderView::getStage() const
+    {
+        switch (bytes[layout::header::stage])
+        {
+            case 0x00:
+                return Stage::init0;
+            case 0x1a:
+                return Stage::init1;
+            case 0x1c:
+                return Stage::ready;
+            default:
+                return Stage::unknown;
+        }
+    }
+
+    Type HeaderView::getType() const
+    {
+        switch (bytes[layout::header::type])
+        {
+            case 0x01:
+                return Type::operation;
+            case 0x03:
+                return Type::data; // Same value as Type::init1
+            case 0xc3:
+                return Type::init0;
+            case 0xc1:
+                return Type::load;
+            default:
+                throw std::domain_error("Invalid Type: " + std::to_string(bytes[layout::header::type]));
+        }
+    }
+
+    DSP HeaderView::getDSP() const
+    {
+        switch (bytes[layout::header::dsp])
+        {
+            case 0x00:
+                return DSP::none;
+            case 0x05:
+                return DSP::amp;
+            case 0x0d:
+                return DSP::usbGain;
+            case 0x06:
+                return DSP::effect0;
+            case 0x07:
+                return DSP::effect1;
+            case 0x08:
+                return DSP::effect2;
+            case 0x09:
+                return DSP::effect3;
+            case 0x03:
+                return DSP::opSave;
+            case 0x04:
+                return DSP::opSaveEffectName;
+            case 0x01:
+                return DSP::opSelectMemBank;
+            default:
+                throw std::domain_error("Invalid DSP: " + std::to_string(bytes[layout::header::dsp]));
+        }
+    }
+
+    std::string NamePayloadView::getName() const
+    {
+        const auto begin = std::next(bytes.begin(), layout::name::name);
+        const auto maxEnd = std::next(begin, layout::name::length);
+        return std::string(begin, std::find(begin, maxEnd, '\0'));
     }
 }
@@ -21,6 +21,7 @@
 
 #include "com/PacketSerializer.h"
 #include "com/IdLookup.h"
+#include "com/ModelRegistry.h"
 #include "effects_enum.h"
 #include <algorithm>
 
@@ -44,21 +45,6 @@ namespace plug::com
         }
 
 
-        constexpr bool hasExtraKnob(effects e)
-        {
-            switch (e)
-            {
-                case effects::MONO_ECHO_FILTER:
-                case effects::STEREO_ECHO_FILTER:
-                case effects::TAPE_DELAY:
-                case effects::STEREO_TAPE_DELAY:
-                    return true;
-                default:
-                    return false;
-            }
-        }
-
-
         std::size_t getSaveEffectsRepeats(const std::vector<fx_pedal_settings>& effects)
         {
             const auto size = effects.size();
@@ -75,78 +61,28 @@ namespace plug::com
             }
             return size;
         }
-
-
-        constexpr DSP dspFromEffect(effects effect)
-        {
-            switch (effect)
-            {
-                case effects::OVERDRIVE:
-                case effects::WAH:
-                case effects::TOUCH_WAH:
-                case effects::FUZZ:
-                case effects::FUZZ_TOUCH_WAH:
-                case effects::SIMPLE_COMP:
-                case effects::COMPRESSOR:
-                case effects::RANGER_BOOST:
-                case effects::GREENBOX:
-                case effects::ORANGEBOX:
-                case effects::BLACKBOX:
-                case effects::BIG_FUZZ:
-                    return DSP::effect0;
-
-                case effects::SINE_CHORUS:
-                case effects::TRIANGLE_CHORUS:
-                case effects::SINE_FLANGER:
-                case effects::TRIANGLE_FLANGER:
-                case effects::VIBRATONE:
-                case effects::VINTAGE_TREMOLO:
-                case effects::SINE_TREMOLO:
-                case effects::RING_MODULATOR:
-                case effects::STEP_FILTER:
-                case effects::PHASER:
-                case effects::PITCH_SHIFTER:
-                case effects::WAH_MOD:
-                case effects::TOUCH_WAH_MOD:
-                case effects::DIATONIC_PITCH_SHIFTER:
-                    return DSP::effect1;
-
-                case effects::MONO_DELAY:
-                case effects::MONO_ECHO_FILTER:
-                case effects::STEREO_ECHO_FILTER:
-                case effects::MULTITAP_DELAY:
-                case effects::PING_PONG_DELAY:
-                case effects::DUCKING_DELAY:
-                case effects::REVERSE_DELAY:
-                case effects::TAPE_DELAY:
-                case effects::STEREO_TAPE_DELAY:
-                    return DSP::effect2;
-
-                case effects::SMALL_HALL_REVERB:
-                case effects::LARGE_HALL_REVERB:
-                case effects::SMALL_ROOM_REVERB:
-                case effects::LARGE_ROOM_REVERB:
-                case effects::SMALL_PLATE_REVERB:
-                case effects::LARGE_PLATE_REVERB:
-                case effects::AMBIENT_REVERB:
-                case effects::ARENA_REVERB:
-                case effects::FENDER_63_SPRING_REVERB:
-                case effects::FENDER_65_SPRING_REVERB:
-                    return DSP::effect3;
-
-                default:
-                    return DSP::none;
-            }
-        }
     }
 
 
     std::string decodeNameFromData(const Packet<NamePayload>& packet)
+    {
+        const auto bytes = packet.getBytes();
+        return decodeNameFromData(PacketView<NamePayload>{bytes});
+    }
+
+    std::string decodeNameFromData(const PacketView<NamePayload>& packet)
     {
         return packet.getPayload().getName();
     }
 
     amp_settings decodeAmpFromData(const Packet<AmpPayload>& packet, const Packet<AmpPayload>& packetUsbGain)
+    {
+        const auto bytes = packet.getBytes();
+        const auto bytesUsbGain = packetUsbGain.getBytes();
+        return decodeAmpFromData(PacketView<AmpPayload>{bytes}, PacketView<AmpPayload>{bytesUsbGain});
+    }
+
+    amp_settings decodeAmpFromData(const PacketView<AmpPayload>& packet, const PacketView<AmpPayload>& packetUsbGain)
     {
         const auto payload = packet.getPayload();
 
@@ -172,8 +108,18 @@ namespace plug::com
     }
 
     std::vector<fx_pedal_settings> decodeEffectsFromData(const std::array<Packet<EffectPayload>, 4>& packet)
+    {
+        std::array<PacketRawType, 4> bytes{};
+        std::transform(packet.cbegin(), packet.cend(), bytes.begin(), [](const auto& p)
+                       { return p.getBytes(); });
+        return decodeEffectsFromData({{PacketView<EffectPayload>{bytes[0]}, PacketView<EffectPayload>{bytes[1]},
+                                       PacketView<EffectPayload>{bytes[2]}, PacketView<EffectPayload>{bytes[3]}}});
+    }
+
+    std::vector<fx_pedal_settings> decodeEffectsFromData(const std::array<PacketView<EffectPayload>, 4>& packet)
     {
         std::vector<fx_pedal_settings> effects;
+        effects.reserve(packet.size());
 
         std::transform(packet.cbegin(), packet.cend(), std::back_inserter(effects), [](const auto& p)
                        {
@@ -192,6 +138,15 @@ namespace plug::com
     }
 
     std::vector<std::string> decodePresetListFromData(const std::vector<Packet<NamePayload>>& packets)
+    {
+        std::vector<PacketRawType> bytes;
+        bytes.reserve(packets.size());
+        std::transform(packets.cbegin(), packets.cend(), std::back_inserter(bytes), [](const auto& p)
+                       { return p.getBytes(); });
+        return decodePresetListFromData(std::span<const PacketRawType>{bytes});
+    }
+
+    std::vector<std::string> decodePresetListFromData(std::span<const PacketRawType> packets)
     {
         const auto max_to_receive = std::min<std::size_t>(packets.size(), (packets.size() > 143 ? 200 : 48));
         std::vector<std::string> presetNames;
@@ -199,7 +154,7 @@ namespace plug::com
 
         for (std::size_t i = 0; i < max_to_receive; i += 2)
         {
-            presetNames.push_back(packets[i].getPayload().getName());
+            presetNames.push_back(PacketView<NamePayload>{packets[i]}.getPayload().getName());
         }
 
         return presetNames;
@@ -227,7 +182,6 @@ namespace plug::com
         payload.setCabinet(plug::value(value.cabinet));
         payload.setSag(clampToRange<std::uint8_t, 0x02>(value.sag));
         payload.setBrightness(value.brightness);
-        payload.setUnknown(0x80, 0x80, 0x01);
 
         if (value.noise_gate == 0x05)
         {
@@ -239,94 +193,11 @@ namespace plug::com
             payload.setDepth(0x80);
         }
 
-        switch (value.amp_num)
-        {
-            case amps::FENDER_57_DELUXE:
-                payload.setModel(0x67);
-                payload.setUnknownAmpSpecific(0x01, 0x01, 0x01, 0x01, 0x53);
-                break;
-
-            case amps::FENDER_59_BASSMAN:
-                payload.setModel(0x64);
-                payload.setUnknownAmpSpecific(0x02, 0x02, 0x02, 0x02, 0x67);
-                break;
-
-            case amps::FENDER_57_CHAMP:
-                payload.setModel(0x7c);
-                payload.setUnknownAmpSpecific(0x0c, 0x0c, 0x0c, 0x0c, 0x00);
-                break;
-
-            case amps::FENDER_65_DELUXE_REVERB:
-                payload.setModel(0x53);
-                payload.setUnknownAmpSpecific(0x03, 0x03, 0x03, 0x03, 0x6a);
-                payload.setUnknown(0x00, 0x00, 0x01);
-                break;
-
-            case amps::FENDER_65_PRINCETON:
-                payload.setModel(0x6a);
-                payload.setUnknownAmpSpecific(0x04, 0x04, 0x04, 0x04, 0x61);
-                break;
-
-            case amps::FENDER_65_TWIN_REVERB:
-                payload.setModel(0x75);
-                payload.setUnknownAmpSpecific(0x05, 0x05, 0x05, 0x05, 0x72);
-                break;
-
-            case amps::FENDER_SUPER_SONIC:
-                payload.setModel(0x72);
-                payload.setUnknownAmpSpecific(0x06, 0x06, 0x06, 0x06, 0x79);
-                break;
-
-            case amps::BRITISH_60S:
-                payload.setModel(0x61);
-                payload.setUnknownAmpSpecific(0x07, 0x07, 0x07, 0x07, 0x5e);
-                break;
-
-            case amps::BRITISH_70S:
-                payload.setModel(0x79);
-                payload.setUnknownAmpSpecific(0x0b, 0x0b, 0x0b, 0x0b, 0x7c);
-                break;
-
-            case amps::BRITISH_80S:
-                payload.setModel(0x5e);
-                payload.setUnknownAmpSpecific(0x09, 0x09, 0x09, 0x09, 0x5d);
-                break;
-
-            case amps::AMERICAN_90S:
-                payload.setModel(0x5d);
-                payload.setUnknownAmpSpecific(0x0a, 0x0a, 0x0a, 0x0a, 0x6d);
-                break;
-
-            case amps::METAL_2000:
-                payload.setModel(0x6d);
-                payload.setUnknownAmpSpecific(0x08, 0x08, 0x08, 0x08, 0x75);
-                break;
-
-            case amps::STUDIO_PREAMP:
-                payload.setModel(0xf1);
-                payload.setUnknownAmpSpecific(0x0d, 0x0d, 0x0d, 0x0d, 0xf6);
-                break;
-
-            case amps::FENDER_57_TWIN:
-                payload.setModel(0xf6);
-                payload.setUnknownAmpSpecific(0x0e, 0x0e, 0x0e, 0x0e, 0xf9);
-                break;
-
-            case amps::FENDER_60_THRIFT:
-                payload.setModel(0xf9);
-                payload.setUnknownAmpSpecific(0x0f, 0x0f, 0x0f, 0x0f, 0xfc);
-                break;
-
-            case amps::BRITISH_COLOUR:
-                payload.setModel(0xfc);
-                payload.setUnknownAmpSpecific(0x10, 0x10, 0x10, 0x10, 0xff);
-                break;
-
-            case amps::BRITISH_WATTS:
-                payload.setModel(0xff);
-                payload.setUnknownAmpSpecific(0x11, 0x11, 0x11, 0x11, 0x00);
-                break;
-        }
+        const auto& model = ampModel(value.amp_num);
+        const auto& specific = model.unknownAmpSpecific;
+        payload.setModel(model.id);
+        payload.setUnknownAmpSpecific(specific[0], specific[1], specific[2], specific[3], specific[4]);
+        payload.setUnknown(model.unknown, model.unknown, 0x01);
 
         return Packet<AmpPayload>{header, payload};
     }
@@ -366,240 +237,46 @@ namespace plug::com
         header.setStage(Stage::ready);
         header.setType(Type::data);
         header.setUnknown(0x00, 0x01, 0x01);
-        header.setDSP(dspFromEffect(value.effect_num));
+        const auto& model = effectModel(value.effect_num);
+        header.setDSP(model.dsp);
 
         EffectPayload payload{};
+        payload.setModel(model.id);
         payload.setSlot(value.slot.id());
-        payload.setUnknown(0x00, 0x08, 0x01);
+        payload.setUnknown(model.unknown[0], model.unknown[1], model.unknown[2]);
         payload.setKnob1(value.knob1);
         payload.setKnob2(value.knob2);
         payload.setKnob3(value.knob3);
         payload.setKnob4(value.knob4);
         payload.setKnob5(value.knob5);
 
-        if (hasExtraKnob(value.effect_num) == true)
+        if (model.extraKnob == true)
         {
             payload.setKnob6(value.knob6);
         }
 
         switch (value.effect_num)
         {
-            case effects::OVERDRIVE:
-                payload.setModel(0x3c);
-                break;
-
-            case effects::WAH:
-                payload.setModel(0x49);
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::TOUCH_WAH:
-                payload.setModel(0x4a);
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::FUZZ:
-                payload.setModel(0x1a);
-                break;
-
-            case effects::FUZZ_TOUCH_WAH:
-                payload.setModel(0x1c);
-                break;
-
             case effects::SIMPLE_COMP:
-                payload.setModel(0x88);
                 payload.setKnob1(clampToRange<std::uint8_t, 0x03>(value.knob1));
                 payload.setKnob2(0x00);
                 payload.setKnob3(0x00);
                 payload.setKnob4(0x00);
                 payload.setKnob5(0x00);
-                payload.setUnknown(0x08, 0x08, 0x01);
-                break;
-
-            case effects::COMPRESSOR:
-                payload.setModel(0x07);
-                break;
-
-            case effects::SINE_CHORUS:
-                payload.setModel(0x12);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::TRIANGLE_CHORUS:
-                payload.setModel(0x13);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::SINE_FLANGER:
-                payload.setModel(0x18);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::TRIANGLE_FLANGER:
-                payload.setModel(0x19);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::VIBRATONE:
-                payload.setModel(0x2d);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::VINTAGE_TREMOLO:
-                payload.setModel(0x40);
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::SINE_TREMOLO:
-                payload.setModel(0x41);
-                payload.setUnknown(0x01, 0x01, 0x01);
                 break;
 
             case effects::RING_MODULATOR:
-                payload.setModel(0x22);
                 payload.setKnob4(clampToRange<std::uint8_t, 0x01>(value.knob4));
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::STEP_FILTER:
-                payload.setModel(0x29);
-                payload.setUnknown(0x01, 0x01, 0x01);
                 break;
 
             case effects::PHASER:
-                payload.setModel(0x4f);
                 payload.setKnob5(clampToRange<std::uint8_t, 0x01>(value.knob5));
-                payload.setUnknown(0x01, 0x01, 0x01);
-                break;
-
-            case effects::PITCH_SHIFTER:
-                payload.setModel(0x1f);
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::MONO_DELAY:
-                payload.setModel(0x16);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::MONO_ECHO_FILTER:
-                payload.setModel(0x43);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::STEREO_ECHO_FILTER:
-                payload.setModel(0x48);
-                payload.setUnknown(0x02, 0x01, 0x01);
                 break;
 
             case effects::MULTITAP_DELAY:
-                payload.setModel(0x44);
                 payload.setKnob5(clampToRange<std::uint8_t, 0x03>(value.knob5));
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::PING_PONG_DELAY:
-                payload.setModel(0x45);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::DUCKING_DELAY:
-                payload.setModel(0x15);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::REVERSE_DELAY:
-                payload.setModel(0x46);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::TAPE_DELAY:
-                payload.setModel(0x2b);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::STEREO_TAPE_DELAY:
-                payload.setModel(0x2a);
-                payload.setUnknown(0x02, 0x01, 0x01);
-                break;
-
-            case effects::SMALL_HALL_REVERB:
-                payload.setModel(0x24);
                 break;
 
-            case effects::LARGE_HALL_REVERB:
-                payload.setModel(0x3a);
-                break;
-
-            case effects::SMALL_ROOM_REVERB:
-                payload.setModel(0x26);
-                break;
-
-            case effects::LARGE_ROOM_REVERB:
-                payload.setModel(0x3b);
-                break;
-
-            case effects::SMALL_PLATE_REVERB:
-                payload.setModel(0x4e);
-                break;
-
-            case effects::LARGE_PLATE_REVERB:
-                payload.setModel(0x4b);
-                break;
-
-            case effects::AMBIENT_REVERB:
-                payload.setModel(0x4c);
-                break;
-
-            case effects::ARENA_REVERB:
-                payload.setModel(0x4d);
-                break;
-
-            case effects::FENDER_63_SPRING_REVERB:
-                payload.setModel(0x21);
-                break;
-
-            case effects::FENDER_65_SPRING_REVERB:
-                payload.setModel(0x0b);
-                break;
-
-            // Mustang I V2
-            case effects::RANGER_BOOST:
-                payload.setModel(0x0103);
-                break;
-
-            case effects::GREENBOX:
-                payload.setModel(0xba);
-                break;
-
-            case effects::ORANGEBOX:
-                payload.setModel(0x0110);
-                break;
-
-            case effects::BLACKBOX:
-                payload.setModel(0x0111);
-                break;
-
-            case effects::BIG_FUZZ:
-                payload.setModel(0x010f);
-                break;
-
-            case effects::WAH_MOD:
-                payload.setModel(0xf4);
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::TOUCH_WAH_MOD:
-                payload.setModel(0xf5);
-                payload.setUnknown(0x01, 0x08, 0x01);
-                break;
-
-            case effects::DIATONIC_PITCH_SHIFTER:
-                payload.setModel(0x101f);
-                payload.setUnknown(0x00, 0x08, 0x01);
-                break;
-
-
             default:
                 break;
         }
@@ -612,7 +289,7 @@ namespace plug::com
         Header header{};
         header.setStage(Stage::ready);
         header.setType(Type::data);
-        header.setDSP(dspFromEffect(effect.effect_num));
+        header.setDSP(effectModel(effect.effect_num).dsp);
         header.setUnknown(0x00, 0x01, 0x01);
         EffectPayload payload{};
         payload.setUnknown(0x00, 0x08, 0x01);
@@ -0,0 +1,107 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetBank.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Header: magic, version, number of records (little endian) and record size; followed by the preset records
+        inline constexpr std::array<std::uint8_t, 7> magic{'P', 'L', 'U', 'G', 'B', 'N', 'K'};
+        inline constexpr std::uint8_t formatVersion{1};
+        inline constexpr std::size_t headerSize{16};
+        inline constexpr std::size_t recordSize{presetRecordSize};
+
+        std::size_t validate(std::span<const std::uint8_t> data)
+        {
+            if ((data.size() < headerSize) || !std::equal(magic.cbegin(), magic.cend(), data.begin()) || (data[magic.size()] != formatVersion))
+            {
+                throw std::runtime_error{"Invalid preset bank"};
+            }
+
+            const std::size_t count = data[8] | (data[9] << 8) | (data[10] << 16) | (static_cast<std::size_t>(data[11]) << 24);
+            const std::size_t size = data[12] | (data[13] << 8);
+
+            if ((size != recordSize) || (((data.size() - headerSize) / recordSize) < count))
+            {
+                throw std::runtime_error{"Invalid or truncated preset bank"};
+            }
+            return count;
+        }
+    }
+
+    void writePresetBank(std::ostream& out, std::span<const SignalChain> presets)
+    {
+        const auto count = static_cast<std::uint32_t>(presets.size());
+        std::array<std::uint8_t, headerSize> header{};
+
+        std::copy(magic.cbegin(), magic.cend(), header.begin());
+        header[magic.size()] = formatVersion;
+        header[8] = static_cast<std::uint8_t>(count & 0xff);
+        header[9] = static_cast<std::uint8_t>((count >> 8) & 0xff);
+        header[10] = static_cast<std::uint8_t>((count >> 16) & 0xff);
+        header[11] = static_cast<std::uint8_t>((count >> 24) & 0xff);
+        header[12] = static_cast<std::uint8_t>(recordSize & 0xff);
+        header[13] = static_cast<std::uint8_t>((recordSize >> 8) & 0xff);
+
+        out.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+        for (const auto& preset : presets)
+        {
+            const auto record = encodePresetRecord(preset);
+            out.write(reinterpret_cast<const char*>(record.data()), record.size());
+        }
+    }
+
+
+    PresetBank::PresetBank(const std::string& path)
+        : file_(path), size_(validate(file_.data()))
+    {
+    }
+
+    std::size_t PresetBank::size() const
+    {
+        return size_;
+    }
+
+    std::string PresetBank::name(std::size_t index) const
+    {
+        return decodePresetRecordName(record(index));
+    }
+
+    SignalChain PresetBank::at(std::size_t index) const
+    {
+        return decodePresetRecord(record(index));
+    }
+
+    std::span<const std::uint8_t, presetRecordSize> PresetBank::record(std::size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range{"Preset " + std::to_string(index) + " out of range"};
+        }
+        return file_.data().subspan(headerSize + (index * recordSize)).first<recordSize>();
+    }
+}
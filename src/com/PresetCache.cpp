@@ -0,0 +1,48 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetCache.h"
+
+namespace plug::com
+{
+    std::optional<SignalChain> PresetCache::get(std::uint8_t slot) const
+    {
+        if (const auto itr = presets.find(slot); itr != presets.cend())
+        {
+            return itr->second;
+        }
+        return std::nullopt;
+    }
+
+    void PresetCache::put(std::uint8_t slot, const SignalChain& signalChain)
+    {
+        presets.insert_or_assign(slot, signalChain);
+    }
+
+    void PresetCache::invalidate(std::uint8_t slot)
+    {
+        presets.erase(slot);
+    }
+
+    void PresetCache::clear()
+    {
+        presets.clear();
+    }
+}
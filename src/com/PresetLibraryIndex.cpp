@@ -0,0 +1,376 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetLibraryIndex.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Header: magic and version; entries: path, modification time, size and the signal chain (all little endian)
+        inline constexpr std::array<char, 7> magic{'P', 'L', 'U', 'G', 'I', 'D', 'X'};
+        inline constexpr std::uint8_t formatVersion{1};
+        inline constexpr std::uint32_t maxStringLength{4096};
+
+        struct FileStatus
+        {
+            std::int64_t modified;
+            std::uintmax_t size;
+        };
+
+        std::optional<FileStatus> fileStatus(const std::filesystem::path& file)
+        {
+            std::error_code error;
+            const auto modified = std::filesystem::last_write_time(file, error);
+
+            if (error)
+            {
+                return std::nullopt;
+            }
+
+            const auto size = std::filesystem::file_size(file, error);
+
+            if (error)
+            {
+                return std::nullopt;
+            }
+            return FileStatus{static_cast<std::int64_t>(modified.time_since_epoch().count()), size};
+        }
+
+        bool isPresetFile(const std::filesystem::directory_entry& entry)
+        {
+            std::error_code error;
+            auto extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+
+            return (extension == ".fuse") && entry.is_regular_file(error);
+        }
+
+        bool isUnchanged(const PresetLibraryIndex::Entry& entry, const FileStatus& status)
+        {
+            return (entry.modified == status.modified) && (entry.size == status.size);
+        }
+
+        std::optional<SignalChain> loadPreset(const PresetLibraryIndex::Loader& loader, const std::filesystem::path& file)
+        {
+            // Unreadable or malformed files aren't part of the library
+            try
+            {
+                return loader(file);
+            }
+            catch (const std::exception&)
+            {
+                return std::nullopt;
+            }
+        }
+
+        bool lessIgnoreCase(const std::string& lhs, const std::string& rhs)
+        {
+            return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), [](unsigned char a, unsigned char b)
+                                                { return std::tolower(a) < std::tolower(b); });
+        }
+
+
+        template <class T>
+        void writeInteger(std::ostream& out, T value)
+        {
+            const auto raw = static_cast<std::uint64_t>(value);
+
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                out.put(static_cast<char>((raw >> (i * 8)) & 0xff));
+            }
+        }
+
+        void writeString(std::ostream& out, const std::string& value)
+        {
+            writeInteger(out, static_cast<std::uint32_t>(value.size()));
+            out.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        template <class T>
+        T readInteger(std::istream& in)
+        {
+            std::uint64_t raw{0};
+
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                char value{};
+
+                if (!in.get(value))
+                {
+                    throw std::runtime_error{"Truncated library index"};
+                }
+                raw |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(value)) << (i * 8);
+            }
+            return static_cast<T>(raw);
+        }
+
+        std::string readString(std::istream& in)
+        {
+            const auto length = readInteger<std::uint32_t>(in);
+
+            if (length > maxStringLength)
+            {
+                throw std::runtime_error{"Invalid string length in library index"};
+            }
+
+            std::string value(length, '\0');
+
+            if (!in.read(value.data(), static_cast<std::streamsize>(value.size())))
+            {
+                throw std::runtime_error{"Truncated library index"};
+            }
+            return value;
+        }
+
+        void writeSignalChain(std::ostream& out, const SignalChain& signalChain)
+        {
+            const auto amp = signalChain.amp();
+            const auto effects = signalChain.effects();
+
+            writeString(out, signalChain.name());
+
+            for (const auto value : {static_cast<std::uint8_t>(amp.amp_num), amp.gain, amp.volume, amp.treble, amp.middle, amp.bass,
+                                     static_cast<std::uint8_t>(amp.cabinet), amp.noise_gate, amp.master_vol, amp.gain2, amp.presence,
+                                     amp.threshold, amp.depth, amp.bias, amp.sag, static_cast<std::uint8_t>(amp.brightness), amp.usb_gain})
+            {
+                writeInteger(out, value);
+            }
+
+            writeInteger(out, static_cast<std::uint8_t>(effects.size()));
+
+            for (const auto& effect : effects)
+            {
+                for (const auto value : {effect.slot.id(), static_cast<std::uint8_t>(effect.effect_num), effect.knob1, effect.knob2,
+                                         effect.knob3, effect.knob4, effect.knob5, effect.knob6, static_cast<std::uint8_t>(effect.enabled)})
+                {
+                    writeInteger(out, value);
+                }
+            }
+        }
+
+        SignalChain readSignalChain(std::istream& in)
+        {
+            const auto name = readString(in);
+            const auto byte = [&in]
+            { return readInteger<std::uint8_t>(in); };
+
+            amp_settings amp{};
+            amp.amp_num = static_cast<amps>(byte());
+            amp.gain = byte();
+            amp.volume = byte();
+            amp.treble = byte();
+            amp.middle = byte();
+            amp.bass = byte();
+            amp.cabinet = static_cast<cabinets>(byte());
+            amp.noise_gate = byte();
+            amp.master_vol = byte();
+            amp.gain2 = byte();
+            amp.presence = byte();
+            amp.threshold = byte();
+            amp.depth = byte();
+            amp.bias = byte();
+            amp.sag = byte();
+            amp.brightness = (byte() != 0);
+            amp.usb_gain = byte();
+
+            const std::size_t numberOfEffects = byte();
+            std::vector<fx_pedal_settings> effects;
+            effects.reserve(numberOfEffects);
+
+            for (std::size_t i = 0; i < numberOfEffects; ++i)
+            {
+                const FxSlot slot{byte()};
+                const auto effect = static_cast<plug::effects>(byte());
+                const auto knob1 = byte();
+                const auto knob2 = byte();
+                const auto knob3 = byte();
+                const auto knob4 = byte();
+                const auto knob5 = byte();
+                const auto knob6 = byte();
+                const bool enabled = (byte() != 0);
+                effects.push_back(fx_pedal_settings{slot, effect, knob1, knob2, knob3, knob4, knob5, knob6, enabled});
+            }
+            return SignalChain{name, amp, effects};
+        }
+    }
+
+    bool PresetLibraryIndex::refresh(const std::filesystem::path& directory, const Loader& loader)
+    {
+        std::map<std::filesystem::path, Entry> refreshed;
+        std::vector<std::filesystem::path> pending;
+        std::vector<FileStatus> pendingStatus;
+        std::error_code error;
+
+        for (std::filesystem::directory_iterator itr{directory, error}, end; !error && (itr != end); itr.increment(error))
+        {
+            if (!isPresetFile(*itr))
+            {
+                continue;
+            }
+
+            const auto& file = itr->path();
+            const auto status = fileStatus(file);
+
+            if (!status.has_value())
+            {
+                continue;
+            }
+
+            // Unchanged files are taken over without loading them again
+            if (auto existing = entries_.find(file); (existing != entries_.end()) && isUnchanged(existing->second, *status))
+            {
+                refreshed.insert(entries_.extract(existing));
+            }
+            else
+            {
+                pending.push_back(file);
+                pendingStatus.push_back(*status);
+            }
+        }
+
+        // Whatever is left wasn't found anymore
+        bool changed = !entries_.empty();
+        const auto results = loadPresets(pending, loader);
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            // Unreadable or malformed files aren't part of the library
+            if (results[i].signalChain.has_value())
+            {
+                refreshed.insert_or_assign(pending[i], Entry{pending[i], pendingStatus[i].modified, pendingStatus[i].size, *results[i].signalChain});
+                changed = true;
+            }
+        }
+
+        entries_ = std::move(refreshed);
+        return changed;
+    }
+
+    std::optional<SignalChain> PresetLibraryIndex::refreshFile(const std::filesystem::path& file, const Loader& loader)
+    {
+        const auto status = fileStatus(file);
+
+        if (!status.has_value())
+        {
+            entries_.erase(file);
+            return std::nullopt;
+        }
+
+        if (const auto existing = entries_.find(file); (existing != entries_.cend()) && isUnchanged(existing->second, *status))
+        {
+            return existing->second.signalChain;
+        }
+
+        auto signalChain = loadPreset(loader, file);
+
+        if (signalChain.has_value())
+        {
+            entries_.insert_or_assign(file, Entry{file, status->modified, status->size, *signalChain});
+        }
+        else
+        {
+            entries_.erase(file);
+        }
+        return signalChain;
+    }
+
+    std::optional<SignalChain> PresetLibraryIndex::get(const std::filesystem::path& file) const
+    {
+        if (const auto itr = entries_.find(file); itr != entries_.cend())
+        {
+            return itr->second.signalChain;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<PresetLibraryIndex::Entry> PresetLibraryIndex::entries() const
+    {
+        std::vector<Entry> sorted;
+        sorted.reserve(entries_.size());
+        std::transform(entries_.cbegin(), entries_.cend(), std::back_inserter(sorted), [](const auto& entry)
+                       { return entry.second; });
+        std::stable_sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs)
+                         { return lessIgnoreCase(lhs.path.filename().string(), rhs.path.filename().string()); });
+        return sorted;
+    }
+
+    std::size_t PresetLibraryIndex::size() const
+    {
+        return entries_.size();
+    }
+
+    void PresetLibraryIndex::save(std::ostream& out) const
+    {
+        out.write(magic.data(), magic.size());
+        out.put(static_cast<char>(formatVersion));
+        writeInteger(out, static_cast<std::uint32_t>(entries_.size()));
+
+        for (const auto& [path, entry] : entries_)
+        {
+            writeString(out, path.string());
+            writeInteger(out, entry.modified);
+            writeInteger(out, static_cast<std::uint64_t>(entry.size));
+            writeSignalChain(out, entry.signalChain);
+        }
+    }
+
+    bool PresetLibraryIndex::load(std::istream& in)
+    {
+        // An invalid index is discarded; the next refresh rebuilds it from the files
+        std::map<std::filesystem::path, Entry> loaded;
+
+        try
+        {
+            std::array<char, magic.size()> header{};
+
+            if (!in.read(header.data(), header.size()) || (header != magic) || (readInteger<std::uint8_t>(in) != formatVersion))
+            {
+                return false;
+            }
+
+            const auto count = readInteger<std::uint32_t>(in);
+
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const std::filesystem::path path{readString(in)};
+                const auto modified = readInteger<std::int64_t>(in);
+                const auto size = static_cast<std::uintmax_t>(readInteger<std::uint64_t>(in));
+                loaded.insert_or_assign(path, Entry{path, modified, size, readSignalChain(in)});
+            }
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        entries_ = std::move(loaded);
+        return true;
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetRecord.h"
+#include "com/ModelRegistry.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Record: name (zero padded), amp, number of effects and the effects
+        inline constexpr std::size_t maxEffects{8};
+        inline constexpr std::size_t ampPosition{presetNameSize};
+        inline constexpr std::size_t effectCountPosition{ampPosition + ampRecordSize};
+        inline constexpr std::size_t effectsPosition{effectCountPosition + 1};
+
+        static_assert(effectsPosition + (maxEffects * effectRecordSize) <= presetRecordSize);
+
+        amps toAmp(std::uint8_t value)
+        {
+            const auto amp = static_cast<amps>(value);
+
+            if (!isKnownAmp(amp))
+            {
+                throw std::invalid_argument{"Amp ID out of range: " + std::to_string(value)};
+            }
+            return amp;
+        }
+
+        effects toEffect(std::uint8_t value)
+        {
+            const auto effect = static_cast<effects>(value);
+
+            if (!isKnownEffect(effect))
+            {
+                throw std::invalid_argument{"Effect ID out of range: " + std::to_string(value)};
+            }
+            return effect;
+        }
+    }
+
+    AmpRecord encodeAmpRecord(const amp_settings& amp)
+    {
+        return {static_cast<std::uint8_t>(amp.amp_num), amp.gain, amp.volume, amp.treble, amp.middle, amp.bass,
+                static_cast<std::uint8_t>(amp.cabinet), amp.noise_gate, amp.master_vol, amp.gain2, amp.presence,
+                amp.threshold, amp.depth, amp.bias, amp.sag, static_cast<std::uint8_t>(amp.brightness), amp.usb_gain};
+    }
+
+    amp_settings decodeAmpRecord(std::span<const std::uint8_t, ampRecordSize> data)
+    {
+        return {toAmp(data[0]), data[1], data[2], data[3], data[4], data[5],
+                static_cast<cabinets>(data[6]), data[7], data[8], data[9], data[10],
+                data[11], data[12], data[13], data[14], (data[15] != 0), data[16]};
+    }
+
+    EffectRecord encodeEffectRecord(const fx_pedal_settings& effect)
+    {
+        return {effect.slot.id(), static_cast<std::uint8_t>(effect.effect_num), effect.knob1, effect.knob2,
+                effect.knob3, effect.knob4, effect.knob5, effect.knob6, static_cast<std::uint8_t>(effect.enabled)};
+    }
+
+    fx_pedal_settings decodeEffectRecord(std::span<const std::uint8_t, effectRecordSize> data)
+    {
+        return {FxSlot{data[0]}, toEffect(data[1]), data[2], data[3],
+                data[4], data[5], data[6], data[7], (data[8] != 0)};
+    }
+
+    PresetRecord encodePresetRecord(const SignalChain& preset)
+    {
+        PresetRecord record{};
+        const auto name = preset.name();
+        const auto amp = encodeAmpRecord(preset.amp());
+        const auto effects = preset.effects();
+        const auto numberOfEffects = std::min(effects.size(), maxEffects);
+
+        std::copy_n(name.cbegin(), std::min(name.size(), presetNameSize), record.begin());
+        std::copy(amp.cbegin(), amp.cend(), std::next(record.begin(), ampPosition));
+        record[effectCountPosition] = static_cast<std::uint8_t>(numberOfEffects);
+
+        for (std::size_t i = 0; i < numberOfEffects; ++i)
+        {
+            const auto effect = encodeEffectRecord(effects[i]);
+            std::copy(effect.cbegin(), effect.cend(), std::next(record.begin(), static_cast<std::ptrdiff_t>(effectsPosition + (i * effectRecordSize))));
+        }
+        return record;
+    }
+
+    std::string decodePresetRecordName(std::span<const std::uint8_t, presetRecordSize> data)
+    {
+        const auto name = data.first<presetNameSize>();
+        return std::string{name.begin(), std::find(name.begin(), name.end(), 0x00)};
+    }
+
+    SignalChain decodePresetRecord(std::span<const std::uint8_t, presetRecordSize> data)
+    {
+        const std::size_t numberOfEffects = std::min<std::size_t>(data[effectCountPosition], maxEffects);
+        std::vector<fx_pedal_settings> effects;
+        effects.reserve(numberOfEffects);
+
+        for (std::size_t i = 0; i < numberOfEffects; ++i)
+        {
+            effects.push_back(decodeEffectRecord(data.subspan(effectsPosition + (i * effectRecordSize)).first<effectRecordSize>()));
+        }
+        return SignalChain{decodePresetRecordName(data), decodeAmpRecord(data.subspan<ampPosition, ampRecordSize>()), effects};
+    }
+}
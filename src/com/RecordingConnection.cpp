@@ -0,0 +1,87 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/RecordingConnection.h"
+#include "com/SessionRecording.h"
+#include <algorithm>
+#include <utility>
+
+namespace plug::com
+{
+    RecordingConnection::RecordingConnection(std::shared_ptr<Connection> connection, std::unique_ptr<std::ostream> out)
+        : conn(std::move(connection)), out_(std::move(out)), last_(std::nullopt)
+    {
+        writeRecordingHeader(*out_);
+    }
+
+    void RecordingConnection::close()
+    {
+        out_->flush();
+        conn->close();
+    }
+
+    bool RecordingConnection::isOpen() const
+    {
+        return conn->isOpen();
+    }
+
+    std::size_t RecordingConnection::sendBatch(std::span<const PacketRawType> packets)
+    {
+        const auto sent = conn->sendBatch(packets);
+        std::for_each(packets.begin(), std::next(packets.begin(), static_cast<std::ptrdiff_t>(sent)), [this](const auto& packet)
+                      { record(Direction::send, packet); });
+        return sent;
+    }
+
+    std::vector<std::uint8_t> RecordingConnection::receive(std::size_t recvSize)
+    {
+        auto data = conn->receive(recvSize);
+        record(Direction::receive, data);
+        return data;
+    }
+
+    std::size_t RecordingConnection::receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+    {
+        const auto received = conn->receiveInto(buffer);
+        record(Direction::receive, std::span<const std::uint8_t>{buffer}.first(received));
+        return received;
+    }
+
+    std::string RecordingConnection::name() const
+    {
+        return conn->name();
+    }
+
+    std::size_t RecordingConnection::sendImpl(const std::uint8_t* data, std::size_t size)
+    {
+        const auto sent = conn->send({data, size});
+        record(Direction::send, {data, sent});
+        return sent;
+    }
+
+    void RecordingConnection::record(Direction direction, std::span<const std::uint8_t> data)
+    {
+        const auto now = Clock::now();
+        const auto delay = last_.has_value() ? std::chrono::duration_cast<std::chrono::microseconds>(now - *last_) : std::chrono::microseconds::zero();
+        last_ = now;
+
+        writeRecordedPacket(*out_, RecordedPacket{direction, delay, {data.begin(), data.end()}});
+    }
+}
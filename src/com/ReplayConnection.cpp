@@ -0,0 +1,114 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/ReplayConnection.h"
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace plug::com
+{
+    ReplayConnection::ReplayConnection(std::vector<RecordedPacket> recording, ReplaySpeed speed)
+        : recording_(std::move(recording)), speed_(speed), position_(0), open_(true)
+    {
+    }
+
+    void ReplayConnection::close()
+    {
+        open_ = false;
+    }
+
+    bool ReplayConnection::isOpen() const
+    {
+        return open_;
+    }
+
+    std::vector<std::uint8_t> ReplayConnection::receive(std::size_t recvSize)
+    {
+        const auto packet = next(Direction::receive);
+
+        if (packet == nullptr)
+        {
+            return {};
+        }
+        const auto size = std::min(packet->data.size(), recvSize);
+        return {packet->data.cbegin(), std::next(packet->data.cbegin(), static_cast<std::ptrdiff_t>(size))};
+    }
+
+    std::size_t ReplayConnection::receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+    {
+        const auto packet = next(Direction::receive);
+
+        if (packet == nullptr)
+        {
+            return 0;
+        }
+        const auto size = std::min(packet->data.size(), buffer.size());
+        std::copy_n(packet->data.cbegin(), size, buffer.begin());
+        return size;
+    }
+
+    std::string ReplayConnection::name() const
+    {
+        return "Replay";
+    }
+
+    void ReplayConnection::rewind()
+    {
+        position_ = 0;
+        open_ = true;
+    }
+
+    bool ReplayConnection::finished() const
+    {
+        return position_ >= recording_.size();
+    }
+
+    std::size_t ReplayConnection::sendImpl([[maybe_unused]] const std::uint8_t* data, std::size_t size)
+    {
+        // Responses the caller didn't receive are stale once the next command is sent
+        const auto send = std::find_if(std::next(recording_.cbegin(), static_cast<std::ptrdiff_t>(position_)), recording_.cend(), [](const auto& packet)
+                                       { return packet.direction == Direction::send; });
+        position_ = static_cast<std::size_t>(std::distance(recording_.cbegin(), send));
+
+        if (next(Direction::send) == nullptr)
+        {
+            return 0;
+        }
+        return size;
+    }
+
+    const RecordedPacket* ReplayConnection::next(Direction direction)
+    {
+        if (finished() || (recording_[position_].direction != direction))
+        {
+            return nullptr;
+        }
+
+        const auto& packet = recording_[position_++];
+
+        if (speed_ == ReplaySpeed::original)
+        {
+            std::this_thread::sleep_for(packet.delay);
+        }
+        return &packet;
+    }
+}
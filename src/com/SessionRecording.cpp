@@ -0,0 +1,115 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SessionRecording.h"
+#include "com/CommunicationException.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace plug::com
+{
+    namespace
+    {
+        // Header: magic and version; packet: direction, delay (us, little endian), length and the data
+        inline constexpr std::array<char, 7> magic{'P', 'L', 'U', 'G', 'R', 'E', 'C'};
+        inline constexpr std::uint8_t formatVersion{1};
+        inline constexpr std::size_t delaySize{4};
+
+        std::uint8_t readByte(std::istream& in)
+        {
+            char value{};
+
+            if (!in.get(value))
+            {
+                throw CommunicationException{"Truncated session recording"};
+            }
+            return static_cast<std::uint8_t>(value);
+        }
+    }
+
+    void writeRecordingHeader(std::ostream& out)
+    {
+        out.write(magic.data(), magic.size());
+        out.put(static_cast<char>(formatVersion));
+    }
+
+    void writeRecordedPacket(std::ostream& out, const RecordedPacket& packet)
+    {
+        const auto delay = static_cast<std::uint32_t>(std::clamp<std::chrono::microseconds::rep>(packet.delay.count(), 0, std::numeric_limits<std::uint32_t>::max()));
+        const auto size = std::min(packet.data.size(), packetRawTypeSize);
+
+        out.put(static_cast<char>(packet.direction == Direction::send ? 0x00 : 0x01));
+
+        for (std::size_t i = 0; i < delaySize; ++i)
+        {
+            out.put(static_cast<char>((delay >> (i * 8)) & 0xff));
+        }
+
+        out.put(static_cast<char>(size));
+        std::transform(packet.data.cbegin(), std::next(packet.data.cbegin(), static_cast<std::ptrdiff_t>(size)), std::ostreambuf_iterator<char>{out}, [](std::uint8_t value)
+                       { return static_cast<char>(value); });
+    }
+
+    std::vector<RecordedPacket> readRecording(std::istream& in)
+    {
+        std::array<char, magic.size()> header{};
+
+        if (!in.read(header.data(), header.size()) || (header != magic) || (readByte(in) != formatVersion))
+        {
+            throw CommunicationException{"Invalid session recording"};
+        }
+
+        std::vector<RecordedPacket> packets;
+
+        while (in.peek() != std::istream::traits_type::eof())
+        {
+            const auto direction = readByte(in);
+
+            if (direction > 0x01)
+            {
+                throw CommunicationException{"Invalid packet direction in session recording"};
+            }
+
+            std::uint32_t delay{0};
+
+            for (std::size_t i = 0; i < delaySize; ++i)
+            {
+                delay |= static_cast<std::uint32_t>(readByte(in)) << (i * 8);
+            }
+
+            const std::size_t size = readByte(in);
+
+            if (size > packetRawTypeSize)
+            {
+                throw CommunicationException{"Invalid packet size in session recording"};
+            }
+
+            std::vector<std::uint8_t> data(size);
+            std::generate(data.begin(), data.end(), [&in]
+                          { return readByte(in); });
+
+            packets.push_back(RecordedPacket{direction == 0x00 ? Direction::send : Direction::receive, std::chrono::microseconds{delay}, std::move(data)});
+        }
+        return packets;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SettingsCoalescer.h"
+#include "com/Mustang.h"
+#include <algorithm>
+#include <utility>
+
+namespace plug::com
+{
+    void sendSettings(Mustang& mustang, const PendingSettings& settings)
+    {
+        // Each effect clears its DSP first, so a moved effect requires the order of the updates
+        std::for_each(settings.effects.cbegin(), settings.effects.cend(), [&mustang](const auto& effect)
+                      { mustang.set_effect(effect); });
+
+        if (settings.amp.has_value())
+        {
+            mustang.set_amplifier(*settings.amp);
+        }
+    }
+
+
+    SettingsCoalescer::SettingsCoalescer(std::chrono::milliseconds minInterval)
+        : minInterval_(minInterval), lastFlush_(std::nullopt), pending_{}
+    {
+    }
+
+    void SettingsCoalescer::update(const amp_settings& value)
+    {
+        pending_.amp = value;
+    }
+
+    void SettingsCoalescer::update(const fx_pedal_settings& value)
+    {
+        auto itr = std::find_if(pending_.effects.begin(), pending_.effects.end(), [&value](const auto& effect)
+                                { return effect.slot.id() == value.slot.id(); });
+
+        if (itr != pending_.effects.end())
+        {
+            *itr = value;
+        }
+        else
+        {
+            pending_.effects.push_back(value);
+        }
+    }
+
+    bool SettingsCoalescer::hasPending() const
+    {
+        return pending_.amp.has_value() || !pending_.effects.empty();
+    }
+
+    SettingsCoalescer::Clock::duration SettingsCoalescer::timeUntilFlush(Clock::time_point now) const
+    {
+        if (lastFlush_.has_value() == false)
+        {
+            return Clock::duration::zero();
+        }
+        return std::max(Clock::duration::zero(), (*lastFlush_ + minInterval_) - now);
+    }
+
+    PendingSettings SettingsCoalescer::take(Clock::time_point now)
+    {
+        lastFlush_ = now;
+        return std::exchange(pending_, {});
+    }
+
+    void SettingsCoalescer::discard()
+    {
+        pending_ = {};
+    }
+}
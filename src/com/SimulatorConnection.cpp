@@ -0,0 +1,403 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SimulatorConnection.h"
+#include "com/ModelRegistry.h"
+#include "com/PacketSerializer.h"
+#include "com/PacketView.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace plug::com
+{
+    namespace
+    {
+        inline constexpr std::size_t numberOfKnobPresets{12};
+        inline constexpr std::size_t knobPosition{3};
+        inline constexpr std::uint8_t modKnob{0x01};
+        inline constexpr std::uint8_t dlyRevKnob{0x02};
+        inline constexpr std::array familyEffects{effects::OVERDRIVE, effects::SINE_CHORUS, effects::MONO_DELAY, effects::SMALL_HALL_REVERB};
+
+        enum class Command
+        {
+            init,
+            load,
+            selectBank,
+            save,
+            saveEffectName,
+            settings,
+            apply,
+            unknown
+        };
+
+        Command classify(const PacketRawType& packet)
+        {
+            const HeaderView header{std::span{packet}.first<layout::headerSize>()};
+
+            try
+            {
+                const auto stage = header.getStage();
+                const auto type = header.getType();
+
+                if ((stage == Stage::init0) || (stage == Stage::init1))
+                {
+                    return Command::init;
+                }
+                if (type == Type::load)
+                {
+                    return Command::load;
+                }
+                if (stage != Stage::ready)
+                {
+                    return Command::unknown;
+                }
+
+                const auto dsp = header.getDSP();
+
+                if (type == Type::data)
+                {
+                    return dsp == DSP::none ? Command::apply : Command::settings;
+                }
+
+                switch (dsp)
+                {
+                    case DSP::opSelectMemBank:
+                        return Command::selectBank;
+                    case DSP::opSave:
+                        return Command::save;
+                    case DSP::opSaveEffectName:
+                        return Command::saveEffectName;
+                    default:
+                        return Command::unknown;
+                }
+            }
+            catch (const std::domain_error&)
+            {
+                return Command::unknown;
+            }
+        }
+
+        std::optional<std::size_t> bankIndex(DSP dsp)
+        {
+            switch (dsp)
+            {
+                case DSP::amp:
+                    return 1;
+                case DSP::effect0:
+                case DSP::effect1:
+                case DSP::effect2:
+                case DSP::effect3:
+                    return 2 + static_cast<std::size_t>(dsp) - static_cast<std::size_t>(DSP::effect0);
+                case DSP::usbGain:
+                    return 6;
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        // Confirmation; with knob and slot it terminates a knob preset, with slot only it follows a preset name
+        PacketRawType confirmation(std::uint8_t knob = 0x00, std::uint8_t slot = 0x00)
+        {
+            Header header{};
+            header.setStage(Stage::ready);
+            header.setType(Type::operation);
+            header.setDSP(DSP::none);
+            header.setSlot(slot);
+            header.setUnknown(knob, 0x00, 0x00);
+            return Packet<EmptyPayload>{header, EmptyPayload{}}.getBytes();
+        }
+
+        // Packets sent by the amp have the operation type and the slot of the preset
+        PacketRawType asStored(const PacketRawType& packet, std::uint8_t slot)
+        {
+            Packet<EmptyPayload> stored{};
+            stored.fromBytes(packet);
+            auto header = stored.getHeader();
+            header.setType(Type::operation);
+            header.setSlot(slot);
+            stored.setHeader(header);
+            return stored.getBytes();
+        }
+
+        template <class Container>
+        std::vector<PacketRawType> asStored(const Container& packets, std::uint8_t slot)
+        {
+            std::vector<PacketRawType> stored;
+            std::transform(packets.cbegin(), packets.cend(), std::back_inserter(stored), [slot](const auto& p)
+                           { return asStored(p.getBytes(), slot); });
+            return stored;
+        }
+
+        PacketRawType clearedEffect(std::size_t family)
+        {
+            return serializeClearEffectSettings(fx_pedal_settings{FxSlot{0}, familyEffects[family], 0, 0, 0, 0, 0, 0, false}).getBytes();
+        }
+
+        std::string presetName(std::string_view prefix, std::size_t slot)
+        {
+            return std::string{prefix} + " " + std::to_string(slot + 1);
+        }
+    }
+
+    SimulatorConnection::SimulatorConnection(std::size_t numberOfPresets, std::chrono::microseconds latency)
+        : latency_(latency), open_(true), presets_(), current_(), currentSlot_(0), modPresets_(), dlyRevPresets_(), pendingSettings_(), pendingKnobPreset_(std::nullopt), responses_()
+    {
+        presets_.reserve(numberOfPresets);
+
+        for (std::size_t i = 0; i < numberOfPresets; ++i)
+        {
+            const auto slot = static_cast<std::uint8_t>(i);
+            amp_settings amp{};
+            amp.amp_num = ampModels[i % ampModels.size()].amp;
+            amp.volume = 0x80;
+            amp.gain = static_cast<std::uint8_t>(i);
+
+            Bank bank{};
+            bank[0] = asStored(serializeName(slot, presetName("Preset", i)).getBytes(), slot);
+            bank[1] = asStored(serializeAmpSettings(amp).getBytes(), slot);
+
+            for (std::size_t family = 0; family < familyEffects.size(); ++family)
+            {
+                bank[2 + family] = asStored(clearedEffect(family), slot);
+            }
+
+            // Every other preset uses a stomp box
+            if ((i % 2) == 0)
+            {
+                bank[2] = asStored(serializeEffectSettings(fx_pedal_settings{FxSlot{0}, effects::OVERDRIVE, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, true}).getBytes(), slot);
+            }
+
+            bank[6] = asStored(serializeAmpSettingsUsbGain(amp).getBytes(), slot);
+            presets_.push_back(bank);
+        }
+
+        if (presets_.empty() == false)
+        {
+            current_ = presets_.front();
+        }
+
+        for (std::size_t i = 0; i < numberOfKnobPresets; ++i)
+        {
+            const auto slot = static_cast<std::uint8_t>(i);
+            const std::vector mod{fx_pedal_settings{FxSlot{1}, effects::SINE_CHORUS, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, true}};
+            const std::vector dlyRev{fx_pedal_settings{FxSlot{2}, effects::MONO_DELAY, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, true},
+                                     fx_pedal_settings{FxSlot{3}, effects::SMALL_HALL_REVERB, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, true}};
+
+            modPresets_.push_back(KnobPreset{modKnob, slot, asStored(serializeSaveEffectName(slot, presetName("Mod", i), mod).getBytes(), slot),
+                                             asStored(serializeSaveEffectPacket(slot, mod), slot)});
+            dlyRevPresets_.push_back(KnobPreset{dlyRevKnob, slot, asStored(serializeSaveEffectName(slot, presetName("Dly/Rev", i), dlyRev).getBytes(), slot),
+                                                asStored(serializeSaveEffectPacket(slot, dlyRev), slot)});
+        }
+    }
+
+    void SimulatorConnection::close()
+    {
+        open_ = false;
+    }
+
+    bool SimulatorConnection::isOpen() const
+    {
+        return open_;
+    }
+
+    std::vector<std::uint8_t> SimulatorConnection::receive(std::size_t recvSize)
+    {
+        PacketRawType packet{};
+        const auto size = std::min(receiveInto(packet), recvSize);
+        return std::vector<std::uint8_t>(packet.cbegin(), std::next(packet.cbegin(), static_cast<std::ptrdiff_t>(size)));
+    }
+
+    std::size_t SimulatorConnection::receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+    {
+        if (responses_.empty())
+        {
+            return 0;
+        }
+
+        std::this_thread::sleep_for(latency_);
+        std::copy(responses_.front().cbegin(), responses_.front().cend(), buffer.begin());
+        responses_.pop_front();
+        return buffer.size();
+    }
+
+    std::string SimulatorConnection::name() const
+    {
+        return "Mustang Simulator";
+    }
+
+    std::size_t SimulatorConnection::sendImpl(const std::uint8_t* data, std::size_t size)
+    {
+        if ((open_ == false) || (size != packetRawTypeSize))
+        {
+            return 0;
+        }
+
+        PacketRawType packet{};
+        std::copy_n(data, size, packet.begin());
+        handle(packet);
+        return size;
+    }
+
+    void SimulatorConnection::handle(const PacketRawType& packet)
+    {
+        const HeaderView header{std::span{packet}.first<layout::headerSize>()};
+        const auto knob = packet[knobPosition];
+
+        switch (classify(packet))
+        {
+            case Command::init:
+                responses_.push_back(confirmation());
+                break;
+            case Command::load:
+                sendPresets();
+                break;
+            case Command::selectBank:
+                selectBank(header.getSlot());
+                break;
+            case Command::save:
+                save(packet);
+                responses_.push_back(confirmation());
+                break;
+            case Command::saveEffectName:
+                pendingKnobPreset_ = KnobPreset{knob, header.getSlot(), asStored(packet, header.getSlot()), {}};
+                responses_.push_back(confirmation());
+                break;
+            case Command::settings:
+                if ((knob != 0x00) && pendingKnobPreset_.has_value())
+                {
+                    pendingKnobPreset_->effects.push_back(asStored(packet, pendingKnobPreset_->slot));
+                }
+                else
+                {
+                    pendingSettings_.insert_or_assign(header.getDSP(), packet);
+                }
+                responses_.push_back(confirmation());
+                break;
+            case Command::apply:
+                if (knob != 0x00)
+                {
+                    commitKnobPreset();
+                }
+                else
+                {
+                    apply();
+                }
+                responses_.push_back(confirmation());
+                break;
+            default:
+                break;
+        }
+    }
+
+    void SimulatorConnection::sendPresets()
+    {
+        for (std::size_t i = 0; i < presets_.size(); ++i)
+        {
+            responses_.push_back(presets_[i][0]);
+            responses_.push_back(confirmation(0x00, static_cast<std::uint8_t>(i)));
+        }
+
+        sendBank(current_);
+        sendKnobPresets(modKnob, modPresets_, 1);
+        sendKnobPresets(dlyRevKnob, dlyRevPresets_, 2);
+    }
+
+    void SimulatorConnection::sendBank(const Bank& bank)
+    {
+        responses_.insert(responses_.cend(), bank.cbegin(), bank.cend());
+        responses_.push_back(confirmation());
+    }
+
+    void SimulatorConnection::sendKnobPresets(std::uint8_t knob, const std::vector<KnobPreset>& presets, std::size_t numberOfEffects)
+    {
+        std::for_each(presets.cbegin(), presets.cend(), [this, knob, numberOfEffects](const auto& preset)
+                      {
+            responses_.push_back(preset.name);
+            std::copy_n(preset.effects.cbegin(), std::min(numberOfEffects, preset.effects.size()), std::back_inserter(responses_));
+
+            // Unused effects of a knob preset are sent as cleared effect
+            for (std::size_t i = preset.effects.size(); i < numberOfEffects; ++i)
+            {
+                responses_.push_back(asStored(clearedEffect(familyEffects.size() - 1), preset.slot));
+            }
+            responses_.push_back(confirmation(knob, preset.slot)); });
+    }
+
+    void SimulatorConnection::selectBank(std::uint8_t slot)
+    {
+        if (slot >= presets_.size())
+        {
+            responses_.push_back(confirmation());
+            return;
+        }
+
+        pendingSettings_.clear();
+        current_ = presets_[slot];
+        currentSlot_ = slot;
+        sendBank(current_);
+    }
+
+    void SimulatorConnection::save(const PacketRawType& packet)
+    {
+        const auto slot = HeaderView{std::span{packet}.first<layout::headerSize>()}.getSlot();
+
+        if (slot >= presets_.size())
+        {
+            return;
+        }
+
+        // Settings are taken from the DSPs, only the name is transmitted
+        current_[0] = packet;
+        std::transform(current_.cbegin(), current_.cend(), current_.begin(), [slot](const auto& p)
+                       { return asStored(p, slot); });
+        presets_[slot] = current_;
+        currentSlot_ = slot;
+    }
+
+    void SimulatorConnection::apply()
+    {
+        std::for_each(pendingSettings_.cbegin(), pendingSettings_.cend(), [this](const auto& pending)
+                      {
+            if (const auto index = bankIndex(pending.first); index.has_value())
+            {
+                current_[*index] = asStored(pending.second, currentSlot_);
+            } });
+        pendingSettings_.clear();
+    }
+
+    void SimulatorConnection::commitKnobPreset()
+    {
+        if (pendingKnobPreset_.has_value() == false)
+        {
+            return;
+        }
+
+        auto& presets = (pendingKnobPreset_->knob == modKnob ? modPresets_ : dlyRevPresets_);
+
+        if (pendingKnobPreset_->slot < presets.size())
+        {
+            presets[pendingKnobPreset_->slot] = *pendingKnobPreset_;
+        }
+        pendingKnobPreset_.reset();
+    }
+}
@@ -0,0 +1,266 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/TracingConnection.h"
+#include "com/PacketView.h"
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+namespace plug::com
+{
+    namespace
+    {
+        inline constexpr std::array operations{Operation::startAmp, Operation::setEffect, Operation::setAmplifier,
+                                               Operation::loadMemoryBank, Operation::saveOnAmp};
+
+        template <class Getter>
+        auto decodeOrNone(Getter getter) -> std::optional<decltype(getter())>
+        {
+            try
+            {
+                return getter();
+            }
+            catch (const std::domain_error&)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<TracedHeader> decodeHeader(std::span<const std::uint8_t> data)
+        {
+            if (data.size() < layout::headerSize)
+            {
+                return std::nullopt;
+            }
+
+            const HeaderView header{data.first<layout::headerSize>()};
+            return TracedHeader{header.getStage(),
+                                decodeOrNone([&header]
+                                             { return header.getType(); }),
+                                decodeOrNone([&header]
+                                             { return header.getDSP(); }),
+                                header.getSlot()};
+        }
+
+        LatencySummary summarize(const LatencyHistogram& histogram, std::uint64_t failures)
+        {
+            return LatencySummary{histogram.count(), failures, histogram.percentile(50.0), histogram.percentile(99.0), histogram.max()};
+        }
+
+        void dumpSummary(std::ostream& out, std::string_view name, const LatencySummary& summary)
+        {
+            const auto micros = [](std::chrono::nanoseconds value)
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+            };
+
+            out << std::left << std::setw(16) << name << std::right
+                << std::setw(8) << summary.count
+                << std::setw(10) << summary.failures
+                << std::setw(12) << micros(summary.p50)
+                << std::setw(12) << micros(summary.p99)
+                << std::setw(12) << micros(summary.max) << '\n';
+        }
+    }
+
+    std::string_view operationName(Operation operation)
+    {
+        switch (operation)
+        {
+            case Operation::startAmp:
+                return "start_amp";
+            case Operation::setEffect:
+                return "set_effect";
+            case Operation::setAmplifier:
+                return "set_amplifier";
+            case Operation::loadMemoryBank:
+                return "load_memory_bank";
+            case Operation::saveOnAmp:
+                return "save_on_amp";
+            default:
+                return "unknown";
+        }
+    }
+
+
+    TracingConnection::TracingConnection(std::shared_ptr<Connection> connection, std::size_t eventCapacity, std::ostream* dumpOnExit)
+        : conn(std::move(connection)), eventCapacity_(eventCapacity), dumpOnExit_(dumpOnExit)
+    {
+    }
+
+    TracingConnection::~TracingConnection()
+    {
+        if (dumpOnExit_ != nullptr)
+        {
+            dump(*dumpOnExit_);
+        }
+    }
+
+    void TracingConnection::close()
+    {
+        conn->close();
+    }
+
+    bool TracingConnection::isOpen() const
+    {
+        return conn->isOpen();
+    }
+
+    std::size_t TracingConnection::sendBatch(std::span<const PacketRawType> packets)
+    {
+        const auto start = Clock::now();
+        std::size_t sent{0};
+
+        try
+        {
+            sent = conn->sendBatch(packets);
+        }
+        catch (...)
+        {
+            record(Direction::send, start, {}, 0, packets.size(), true);
+            throw;
+        }
+
+        // Recorded as a single event, the packets are in flight concurrently
+        const auto first = packets.empty() ? std::span<const std::uint8_t>{} : std::span<const std::uint8_t>{packets.front()};
+        record(Direction::send, start, first, sent * packetRawTypeSize, packets.size(), sent != packets.size());
+        return sent;
+    }
+
+    std::vector<std::uint8_t> TracingConnection::receive(std::size_t recvSize)
+    {
+        const auto start = Clock::now();
+        auto data = conn->receive(recvSize);
+        record(Direction::receive, start, data, data.size(), 1, data.empty());
+        return data;
+    }
+
+    std::size_t TracingConnection::receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+    {
+        const auto start = Clock::now();
+        const auto received = conn->receiveInto(buffer);
+        record(Direction::receive, start, std::span<const std::uint8_t>{buffer}.first(received), received, 1, received == 0);
+        return received;
+    }
+
+    std::string TracingConnection::name() const
+    {
+        return conn->name();
+    }
+
+    LatencySummary TracingConnection::statistics(Operation operation) const
+    {
+        const std::lock_guard lock{mutex_};
+        const auto& stats = operations_[static_cast<std::size_t>(operation)];
+        return summarize(stats.histogram, stats.failures);
+    }
+
+    LatencySummary TracingConnection::statistics(Direction direction) const
+    {
+        const std::lock_guard lock{mutex_};
+        const auto& stats = wire_[static_cast<std::size_t>(direction)];
+        return summarize(stats.histogram, stats.failures);
+    }
+
+    std::vector<TraceEvent> TracingConnection::events() const
+    {
+        const std::lock_guard lock{mutex_};
+        return {events_.cbegin(), events_.cend()};
+    }
+
+    void TracingConnection::dump(std::ostream& out) const
+    {
+        out << "Connection trace (" << name() << "), latencies in us\n"
+            << std::left << std::setw(16) << "operation" << std::right
+            << std::setw(8) << "count"
+            << std::setw(10) << "failures"
+            << std::setw(12) << "p50"
+            << std::setw(12) << "p99"
+            << std::setw(12) << "max" << '\n';
+
+        for (const auto operation : operations)
+        {
+            dumpSummary(out, operationName(operation), statistics(operation));
+        }
+        dumpSummary(out, "send", statistics(Direction::send));
+        dumpSummary(out, "receive", statistics(Direction::receive));
+    }
+
+    std::size_t TracingConnection::sendImpl(const std::uint8_t* data, std::size_t size)
+    {
+        const std::span<const std::uint8_t> packet{data, size};
+        const auto start = Clock::now();
+        std::size_t sent{0};
+
+        try
+        {
+            sent = conn->send(packet);
+        }
+        catch (...)
+        {
+            record(Direction::send, start, packet, 0, 1, true);
+            throw;
+        }
+
+        record(Direction::send, start, packet, sent, 1, sent != size);
+        return sent;
+    }
+
+    void TracingConnection::record(Direction direction, Clock::time_point start, std::span<const std::uint8_t> header, std::size_t bytes, std::size_t packets, bool timeout)
+    {
+        const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        const std::lock_guard lock{mutex_};
+
+        auto& stats = wire_[static_cast<std::size_t>(direction)];
+        stats.histogram.record(duration);
+        stats.failures += timeout ? 1 : 0;
+
+        if (eventCapacity_ == 0)
+        {
+            return;
+        }
+        if (events_.size() == eventCapacity_)
+        {
+            events_.pop_front();
+        }
+        const auto operation = running_.empty() ? std::nullopt : std::optional{running_.back()};
+        events_.push_back(TraceEvent{start, direction, packets, bytes, duration, decodeHeader(header), timeout, operation});
+    }
+
+    void TracingConnection::beginOperation(Operation operation)
+    {
+        const std::lock_guard lock{mutex_};
+        running_.push_back(operation);
+    }
+
+    void TracingConnection::endOperation(Operation operation, Clock::duration duration, bool failed)
+    {
+        const std::lock_guard lock{mutex_};
+        auto& stats = operations_[static_cast<std::size_t>(operation)];
+        stats.histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+        stats.failures += failed ? 1 : 0;
+
+        if (!running_.empty())
+        {
+            running_.pop_back();
+        }
+    }
+}
@@ -22,6 +22,8 @@
 #include "com/CommunicationException.h"
 #include <algorithm>
 #include <chrono>
+#include <exception>
+#include <future>
 
 namespace plug::com
 {
@@ -29,10 +31,12 @@ namespace plug::com
     {
         inline constexpr std::uint8_t endpointSend{0x01};
         inline constexpr std::uint8_t endpointRecv{0x81};
+        inline constexpr std::size_t maxPacketSize{64};
 
         usb::Device openDevice(usb::Device&& device)
         {
             device.open();
+            device.startReceiving(endpointRecv, maxPacketSize);
             return std::move(device);
         }
     }
@@ -57,13 +61,51 @@ namespace plug::com
         return device_.receive(endpointRecv, recvSize);
     }
 
+    std::size_t UsbComm::receiveInto(std::span<std::uint8_t, packetRawTypeSize> buffer)
+    {
+        return device_.receiveInto(endpointRecv, buffer);
+    }
+
     std::string UsbComm::name() const
     {
         return name_;
     }
 
-    std::size_t UsbComm::sendImpl(std::uint8_t* data, std::size_t size)
+    std::size_t UsbComm::sendBatch(std::span<const PacketRawType> packets)
+    {
+        // All packets are in flight at once; the transfers own a copy of their packet
+        std::vector<std::future<std::size_t>> transfers;
+        transfers.reserve(packets.size());
+
+        std::for_each(packets.begin(), packets.end(), [this, &transfers](const auto& packet)
+                      { transfers.push_back(device_.writeAsync(endpointSend, packet.data(), packet.size())); });
+
+        std::size_t sent{0};
+        bool complete{true};
+        std::exception_ptr error;
+
+        std::for_each(transfers.begin(), transfers.end(), [&sent, &complete, &error](auto& transfer)
+                      {
+            try
+            {
+                complete = complete && (transfer.get() == packetRawTypeSize);
+                sent += complete ? 1 : 0;
+            }
+            catch (...)
+            {
+                complete = false;
+                error = (error == nullptr) ? std::current_exception() : error;
+            } });
+
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+        return sent;
+    }
+
+    std::size_t UsbComm::sendImpl(const std::uint8_t* data, std::size_t size)
     {
-        return device_.write(endpointSend, data, size);
+        return device_.writeAsync(endpointSend, data, size).get();
     }
 }
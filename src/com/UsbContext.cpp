@@ -21,17 +21,64 @@
 #include "com/UsbContext.h"
 #include "com/UsbException.h"
 #include <algorithm>
+#include <chrono>
+#include <span>
 #include <libusb-1.0/libusb.h>
 
 namespace plug::com::usb
 {
+    namespace
+    {
+        inline constexpr std::chrono::milliseconds eventTimeout{100};
+
+        void freeDeviceList(libusb_device** devices)
+        {
+            libusb_free_device_list(devices, 1);
+        }
+
+        using DeviceList = Ressource<libusb_device*, freeDeviceList>;
+
+        // Calls onMatch with the devices accepted by the filter and their descriptor as long as it returns true
+        template <class Fn>
+        void scanDevices(const DeviceFilter& filter, Fn onMatch)
+        {
+            libusb_device** devices{nullptr};
+            const auto n = libusb_get_device_list(nullptr, &devices);
+
+            if (n < 0)
+            {
+                throw UsbException(n);
+            }
+
+            const DeviceList list{devices};
+
+            for (auto* device : std::span{devices, static_cast<std::size_t>(n)})
+            {
+                libusb_device_descriptor descriptor{};
+
+                if ((libusb_get_device_descriptor(device, &descriptor) != LIBUSB_SUCCESS) || !filter(descriptor.idVendor, descriptor.idProduct))
+                {
+                    continue;
+                }
+
+                if (!onMatch(device, descriptor))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+
     Context::Context()
     {
         init();
+        startEventHandling();
     }
 
     Context::~Context()
     {
+        stopEventHandling();
         deinit();
     }
 
@@ -48,6 +95,25 @@ namespace plug::com::usb
         libusb_exit(nullptr);
     }
 
+    void Context::startEventHandling()
+    {
+        eventThread_ = std::jthread{[](std::stop_token stopToken)
+                                    {
+                                        while (stopToken.stop_requested() == false)
+                                        {
+                                            timeval tv{0, std::chrono::duration_cast<std::chrono::microseconds>(eventTimeout).count()};
+                                            libusb_handle_events_timeout_completed(nullptr, &tv, nullptr);
+                                        }
+                                    }};
+    }
+
+    void Context::stopEventHandling()
+    {
+        eventThread_.request_stop();
+        libusb_interrupt_event_handler(nullptr);
+        eventThread_.join();
+    }
+
 
     std::vector<Device> listDevices()
     {
@@ -75,4 +141,26 @@ namespace plug::com::usb
         libusb_free_device_list(devices, 1);
         return devicesFound;
     }
+
+    std::vector<Device> listDevices(const DeviceFilter& filter)
+    {
+        std::vector<Device> devicesFound;
+
+        scanDevices(filter, [&devicesFound](libusb_device* device, const libusb_device_descriptor& descriptor)
+                    {
+            devicesFound.emplace_back(device, descriptor);
+            return true; });
+        return devicesFound;
+    }
+
+    std::optional<Device> findDevice(const DeviceFilter& filter)
+    {
+        std::optional<Device> deviceFound;
+
+        scanDevices(filter, [&deviceFound](libusb_device* device, const libusb_device_descriptor& descriptor)
+                    {
+            deviceFound.emplace(device, descriptor);
+            return false; });
+        return deviceFound;
+    }
 }
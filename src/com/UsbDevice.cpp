@@ -20,6 +20,8 @@
 
 #include "com/UsbDevice.h"
 #include "com/UsbException.h"
+#include "com/UsbTransfer.h"
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <libusb-1.0/libusb.h>
@@ -29,6 +31,11 @@ namespace plug::com::usb
     namespace
     {
         inline constexpr std::chrono::milliseconds usbTimeout{500};
+        inline constexpr std::size_t numberOfReceiveTransfers{4};
+        inline constexpr std::size_t receiveQueueCapacity{512};
+
+        // The longest transmission is the dump of an amp with 100 presets: names, current preset, knob presets and the terminating packet
+        static_assert(receiveQueueCapacity >= (100 * 2) + 7 + (12 * 7) + 1);
     }
 
     namespace detail
@@ -43,11 +50,21 @@ namespace plug::com::usb
             libusb_release_interface(handle, 0);
             libusb_close(handle);
         }
+
+        void releaseReceiveQueue(ReceiveQueue* queue)
+        {
+            delete queue;
+        }
     }
 
 
     Device::Device(libusb_device* device)
-        : device_(libusb_ref_device(device)), handle_(nullptr), descriptor_(getDeviceDescriptor(device))
+        : device_(libusb_ref_device(device)), handle_(nullptr), receiveQueue_(nullptr), descriptor_(getDeviceDescriptor(device))
+    {
+    }
+
+    Device::Device(libusb_device* device, const libusb_device_descriptor& descriptor)
+        : device_(libusb_ref_device(device)), handle_(nullptr), receiveQueue_(nullptr), descriptor_({descriptor.idVendor, descriptor.idProduct, descriptor.iProduct})
     {
     }
 
@@ -74,6 +91,7 @@ namespace plug::com::usb
 
     void Device::close()
     {
+        stopReceiving();
         handle_ = nullptr;
     }
 
@@ -104,11 +122,12 @@ namespace plug::com::usb
         return std::string{buffer.cbegin(), std::next(buffer.cbegin(), n)};
     }
 
-    std::size_t Device::write(std::uint8_t endpoint, std::uint8_t* data, std::size_t dataSize)
+    std::size_t Device::write(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize)
     {
         int transfered{0};
 
-        if (const auto result = libusb_interrupt_transfer(handle_.get(), endpoint, data, dataSize, &transfered, usbTimeout.count()); result != LIBUSB_SUCCESS)
+        // The buffer of an OUT transfer is read only
+        if (const auto result = libusb_interrupt_transfer(handle_.get(), endpoint, const_cast<std::uint8_t*>(data), dataSize, &transfered, usbTimeout.count()); result != LIBUSB_SUCCESS)
         {
             throw UsbException{result};
         }
@@ -118,14 +137,45 @@ namespace plug::com::usb
     std::vector<std::uint8_t> Device::receive(std::uint8_t endpoint, std::size_t dataSize)
     {
         std::vector<std::uint8_t> buffer(dataSize);
+        buffer.resize(receiveInto(endpoint, buffer));
+        return buffer;
+    }
+
+    std::size_t Device::receiveInto(std::uint8_t endpoint, std::span<std::uint8_t> buffer)
+    {
+        if ((receiveQueue_ != nullptr) && (receiveQueue_->endpoint() == endpoint))
+        {
+            return receiveQueue_->receiveInto(buffer, usbTimeout);
+        }
+
         int transfered{0};
 
-        if (const auto result = libusb_interrupt_transfer(handle_.get(), endpoint, buffer.data(), dataSize, &transfered, usbTimeout.count()); (result != LIBUSB_SUCCESS) && (result != LIBUSB_ERROR_TIMEOUT))
+        if (const auto result = libusb_interrupt_transfer(handle_.get(), endpoint, buffer.data(), static_cast<int>(buffer.size()), &transfered, usbTimeout.count()); (result != LIBUSB_SUCCESS) && (result != LIBUSB_ERROR_TIMEOUT))
         {
             throw UsbException{result};
         }
-        buffer.resize(transfered);
-        return buffer;
+        return static_cast<std::size_t>(transfered);
+    }
+
+    std::future<std::size_t> Device::writeAsync(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize)
+    {
+        return submitWrite(handle_.get(), endpoint, data, dataSize, usbTimeout);
+    }
+
+    void Device::startReceiving(std::uint8_t endpoint, std::size_t packetSize)
+    {
+        receiveQueue_ = nullptr;
+        receiveQueue_.reset(new ReceiveQueue{handle_.get(), endpoint, packetSize, numberOfReceiveTransfers, receiveQueueCapacity});
+    }
+
+    void Device::stopReceiving()
+    {
+        receiveQueue_ = nullptr;
+    }
+
+    std::size_t Device::droppedPackets() const
+    {
+        return (receiveQueue_ != nullptr) ? receiveQueue_->droppedPackets() : 0;
     }
 
     Device::Descriptor Device::getDeviceDescriptor(libusb_device* device) const
@@ -0,0 +1,71 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/UsbHotplug.h"
+#include "com/UsbException.h"
+#include <libusb-1.0/libusb.h>
+
+namespace plug::com::usb
+{
+    namespace
+    {
+        int LIBUSB_CALL onHotplugEvent([[maybe_unused]] libusb_context* ctx, libusb_device* device, libusb_hotplug_event event, void* userData)
+        {
+            const auto* callback = static_cast<const Hotplug::Callback*>(userData);
+
+            // Exceptions must not pass the libusb event handling
+            try
+            {
+                (*callback)(event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED ? HotplugEvent::Arrived : HotplugEvent::Left, Device{device});
+            }
+            catch (...)
+            {
+            }
+
+            // Stay registered
+            return 0;
+        }
+    }
+
+    bool hasHotplugSupport()
+    {
+        return libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG) != 0;
+    }
+
+
+    Hotplug::Hotplug(std::uint16_t vendorId, Callback callback)
+        : callback_(std::move(callback)), handle_(0)
+    {
+        // The callback is already called for connected devices while registering
+        const auto events = static_cast<libusb_hotplug_event>(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT);
+
+        if (const int result = libusb_hotplug_register_callback(nullptr, events, LIBUSB_HOTPLUG_ENUMERATE, vendorId, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                                LIBUSB_HOTPLUG_MATCH_ANY, onHotplugEvent, &callback_, &handle_);
+            result != LIBUSB_SUCCESS)
+        {
+            throw UsbException{result};
+        }
+    }
+
+    Hotplug::~Hotplug()
+    {
+        libusb_hotplug_deregister_callback(nullptr, handle_);
+    }
+}
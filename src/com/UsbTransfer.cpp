@@ -0,0 +1,267 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/UsbTransfer.h"
+#include "com/UsbException.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <libusb-1.0/libusb.h>
+
+namespace plug::com::usb
+{
+    namespace
+    {
+        inline constexpr std::chrono::milliseconds eventTimeout{100};
+
+
+        int toErrorCode(libusb_transfer_status status)
+        {
+            switch (status)
+            {
+                case LIBUSB_TRANSFER_COMPLETED:
+                    return LIBUSB_SUCCESS;
+                case LIBUSB_TRANSFER_TIMED_OUT:
+                    return LIBUSB_ERROR_TIMEOUT;
+                case LIBUSB_TRANSFER_CANCELLED:
+                    return LIBUSB_ERROR_INTERRUPTED;
+                case LIBUSB_TRANSFER_STALL:
+                    return LIBUSB_ERROR_PIPE;
+                case LIBUSB_TRANSFER_NO_DEVICE:
+                    return LIBUSB_ERROR_NO_DEVICE;
+                case LIBUSB_TRANSFER_OVERFLOW:
+                    return LIBUSB_ERROR_OVERFLOW;
+                default:
+                    return LIBUSB_ERROR_IO;
+            }
+        }
+
+        libusb_transfer* allocateTransfer()
+        {
+            libusb_transfer* transfer = libusb_alloc_transfer(0);
+
+            if (transfer == nullptr)
+            {
+                throw UsbException{LIBUSB_ERROR_NO_MEM};
+            }
+            return transfer;
+        }
+
+
+        struct WriteRequest
+        {
+            std::vector<std::uint8_t> data;
+            std::promise<std::size_t> result;
+        };
+
+        void writeCallback(libusb_transfer* transfer)
+        {
+            const std::unique_ptr<WriteRequest> request{static_cast<WriteRequest*>(transfer->user_data)};
+
+            if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+            {
+                request->result.set_value(static_cast<std::size_t>(transfer->actual_length));
+            }
+            else
+            {
+                request->result.set_exception(std::make_exception_ptr(UsbException{toErrorCode(transfer->status)}));
+            }
+            libusb_free_transfer(transfer);
+        }
+    }
+
+
+    ReceiveQueue::ReceiveQueue(libusb_device_handle* handle, std::uint8_t endpoint, std::size_t packetSize, std::size_t numTransfers, std::size_t capacity)
+        : endpoint_(endpoint), packetSize_(packetSize), buffers_(numTransfers, std::vector<std::uint8_t>(packetSize)),
+          packets_(capacity * packetSize), packetLengths_(capacity), packetsHead_(0), packetsCount_(0),
+          transfersInFlight_(0), droppedPackets_(0), error_(LIBUSB_SUCCESS), stopping_(false)
+    {
+        transfers_.reserve(numTransfers);
+
+        try
+        {
+            std::for_each(buffers_.begin(), buffers_.end(), [this, handle](auto& buffer)
+                          {
+                libusb_transfer* transfer = allocateTransfer();
+                transfers_.push_back(transfer);
+                libusb_fill_interrupt_transfer(transfer, handle, endpoint_, buffer.data(), static_cast<int>(buffer.size()), &ReceiveQueue::transferCallback, this, 0);
+
+                if (const int result = libusb_submit_transfer(transfer); result != LIBUSB_SUCCESS)
+                {
+                    throw UsbException{result};
+                }
+
+                std::lock_guard lock{mutex_};
+                ++transfersInFlight_; });
+        }
+        catch (const UsbException&)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ReceiveQueue::~ReceiveQueue()
+    {
+        stop();
+    }
+
+    std::uint8_t ReceiveQueue::endpoint() const noexcept
+    {
+        return endpoint_;
+    }
+
+    std::vector<std::uint8_t> ReceiveQueue::receive(std::chrono::milliseconds timeout)
+    {
+        std::vector<std::uint8_t> packet(packetSize_);
+        packet.resize(receiveInto(packet, timeout));
+        return packet;
+    }
+
+    std::size_t ReceiveQueue::receiveInto(std::span<std::uint8_t> buffer, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock{mutex_};
+        packetsAvailable_.wait_for(lock, timeout, [this]
+                                   { return (packetsCount_ > 0) || (error_ != LIBUSB_SUCCESS); });
+
+        if (packetsCount_ > 0)
+        {
+            const auto packet = std::next(packets_.cbegin(), static_cast<std::ptrdiff_t>(packetsHead_ * packetSize_));
+            const auto size = std::min(packetLengths_[packetsHead_], buffer.size());
+            std::copy_n(packet, size, buffer.begin());
+            packetsHead_ = (packetsHead_ + 1) % packetLengths_.size();
+            --packetsCount_;
+            return size;
+        }
+
+        if (error_ != LIBUSB_SUCCESS)
+        {
+            throw UsbException{error_};
+        }
+        return 0;
+    }
+
+    std::size_t ReceiveQueue::droppedPackets() const
+    {
+        std::lock_guard lock{mutex_};
+        return droppedPackets_;
+    }
+
+    void ReceiveQueue::stop()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+
+        std::for_each(transfers_.cbegin(), transfers_.cend(), [](auto* transfer)
+                      { libusb_cancel_transfer(transfer); });
+
+        // Cancellation completes through the event handling; this also waits if another thread handles the events
+        for (;;)
+        {
+            {
+                std::lock_guard lock{mutex_};
+
+                if (transfersInFlight_ == 0)
+                {
+                    break;
+                }
+            }
+
+            timeval tv{0, std::chrono::duration_cast<std::chrono::microseconds>(eventTimeout).count()};
+            libusb_handle_events_timeout_completed(nullptr, &tv, nullptr);
+        }
+
+        std::for_each(transfers_.cbegin(), transfers_.cend(), [](auto* transfer)
+                      { libusb_free_transfer(transfer); });
+        transfers_.clear();
+    }
+
+    void ReceiveQueue::onTransferCompleted(libusb_transfer* transfer)
+    {
+        std::lock_guard lock{mutex_};
+
+        if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+        {
+            if (packetsCount_ == packetLengths_.size())
+            {
+                // Keep receiving; the oldest packet is dropped and counted, the following receives are not affected
+                packetsHead_ = (packetsHead_ + 1) % packetLengths_.size();
+                --packetsCount_;
+                ++droppedPackets_;
+            }
+
+            const std::size_t index = (packetsHead_ + packetsCount_) % packetLengths_.size();
+            const auto size = std::min(static_cast<std::size_t>(transfer->actual_length), packetSize_);
+            std::copy_n(transfer->buffer, size, std::next(packets_.begin(), static_cast<std::ptrdiff_t>(index * packetSize_)));
+            packetLengths_[index] = size;
+            ++packetsCount_;
+        }
+        else if ((transfer->status != LIBUSB_TRANSFER_TIMED_OUT) && (transfer->status != LIBUSB_TRANSFER_CANCELLED))
+        {
+            error_ = toErrorCode(transfer->status);
+        }
+
+        const bool resubmit = (stopping_ == false) && (error_ == LIBUSB_SUCCESS) && (transfer->status != LIBUSB_TRANSFER_CANCELLED);
+
+        if (resubmit == true)
+        {
+            if (const int result = libusb_submit_transfer(transfer); result == LIBUSB_SUCCESS)
+            {
+                packetsAvailable_.notify_all();
+                return;
+            }
+            else
+            {
+                error_ = result;
+            }
+        }
+
+        --transfersInFlight_;
+        packetsAvailable_.notify_all();
+    }
+
+    void ReceiveQueue::transferCallback(libusb_transfer* transfer)
+    {
+        static_cast<ReceiveQueue*>(transfer->user_data)->onTransferCompleted(transfer);
+    }
+
+
+    std::future<std::size_t> submitWrite(libusb_device_handle* handle, std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize, std::chrono::milliseconds timeout)
+    {
+        libusb_transfer* transfer = allocateTransfer();
+        auto request = std::make_unique<WriteRequest>(WriteRequest{{data, std::next(data, static_cast<std::ptrdiff_t>(dataSize))}, {}});
+        auto future = request->result.get_future();
+
+        // The data is owned by the request, the caller's buffer may go away before the transfer completes
+        libusb_fill_interrupt_transfer(transfer, handle, endpoint, request->data.data(), static_cast<int>(dataSize), &writeCallback, request.get(), static_cast<unsigned int>(timeout.count()));
+
+        if (const int result = libusb_submit_transfer(transfer); result != LIBUSB_SUCCESS)
+        {
+            libusb_free_transfer(transfer);
+            throw UsbException{result};
+        }
+
+        // Owned by the transfer until its completion
+        request.release();
+        return future;
+    }
+}
@@ -0,0 +1,259 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/AmpDaemon.h"
+#include "com/ModelRegistry.h"
+#include "com/PresetRecord.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace plug::daemon
+{
+    namespace
+    {
+        inline constexpr std::size_t receiveBufferSize{4096};
+
+        void removeStaleSocket(const std::filesystem::path& path)
+        {
+            if (!std::filesystem::exists(path))
+            {
+                return;
+            }
+
+            try
+            {
+                connectTo(path);
+            }
+            catch (const std::system_error&)
+            {
+                // Nobody is listening anymore
+                std::filesystem::remove(path);
+                return;
+            }
+            throw std::runtime_error{"Daemon already running on " + path.string()};
+        }
+
+        void requirePayloadSize(const Frame& request, std::size_t size)
+        {
+            if (request.payload.size() != size)
+            {
+                throw std::invalid_argument{"Invalid payload size of request " + std::to_string(request.type)};
+            }
+        }
+
+        std::vector<std::uint8_t> okResponse(std::span<const std::uint8_t> payload = {})
+        {
+            return encodeFrame(static_cast<std::uint8_t>(Status::Ok), payload);
+        }
+
+        std::vector<std::uint8_t> errorResponse(std::string_view message)
+        {
+            const auto size = std::min(message.size(), maxPayloadSize);
+            const std::vector<std::uint8_t> payload{message.cbegin(), std::next(message.cbegin(), static_cast<std::ptrdiff_t>(size))};
+            return encodeFrame(static_cast<std::uint8_t>(Status::Error), payload);
+        }
+
+        std::pair<FileDescriptor, FileDescriptor> createWakeup()
+        {
+            std::array<int, 2> fds{};
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds.data()) != 0)
+            {
+                throw std::system_error{errno, std::generic_category(), "Creating wakeup channel failed"};
+            }
+            return {FileDescriptor{fds[0]}, FileDescriptor{fds[1]}};
+        }
+    }
+
+    AmpDaemon::AmpDaemon(com::Mustang& mustang, const std::filesystem::path& socketPath)
+        : mustang_(mustang), socketPath_(socketPath), state_(mustang.start_amp()), listener_(), wakeupReceiver_(), wakeupSender_(), clients_()
+    {
+        removeStaleSocket(socketPath_);
+        listener_ = listenOn(socketPath_);
+        std::tie(wakeupReceiver_, wakeupSender_) = createWakeup();
+    }
+
+    AmpDaemon::~AmpDaemon()
+    {
+        std::error_code ignored;
+        std::filesystem::remove(socketPath_, ignored);
+    }
+
+    void AmpDaemon::run()
+    {
+        std::vector<pollfd> fds;
+
+        while (true)
+        {
+            fds.clear();
+            fds.push_back(pollfd{wakeupReceiver_.get(), POLLIN, 0});
+            fds.push_back(pollfd{listener_.get(), POLLIN, 0});
+            std::transform(clients_.cbegin(), clients_.cend(), std::back_inserter(fds), [](const auto& client)
+                           { return pollfd{client.socket.get(), POLLIN, 0}; });
+
+            if (::poll(fds.data(), fds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(), "Polling failed"};
+            }
+
+            if (fds[0].revents != 0)
+            {
+                return;
+            }
+
+            // New clients are polled from the next round on; their pollfds don't exist yet
+            for (std::size_t i = 0; i < clients_.size(); ++i)
+            {
+                if ((fds[i + 2].revents != 0) && !receive(clients_[i]))
+                {
+                    clients_[i].socket.close();
+                }
+            }
+            std::erase_if(clients_, [](const auto& client)
+                          { return !client.socket.isOpen(); });
+
+            if ((fds[1].revents & POLLIN) != 0)
+            {
+                clients_.push_back(Client{acceptFrom(listener_), {}});
+            }
+        }
+    }
+
+    void AmpDaemon::stop()
+    {
+        constexpr std::array<std::uint8_t, 1> wakeup{0x00};
+        wakeupSender_.writeAll(wakeup);
+    }
+
+    bool AmpDaemon::receive(Client& client)
+    {
+        std::array<std::uint8_t, receiveBufferSize> buffer{};
+
+        try
+        {
+            const auto received = client.socket.readSome(buffer);
+
+            if (received == 0)
+            {
+                return false;
+            }
+
+            client.reader.append(std::span{buffer}.first(received));
+
+            for (auto request = client.reader.next(); request.has_value(); request = client.reader.next())
+            {
+                client.socket.writeAll(handle(*request));
+            }
+        }
+        catch (const std::system_error&)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<std::uint8_t> AmpDaemon::handle(const Frame& request)
+    {
+        try
+        {
+            switch (static_cast<Request>(request.type))
+            {
+                case Request::State:
+                    requirePayloadSize(request, 0);
+                    return okResponse(encodeState(state_));
+                case Request::LoadPreset:
+                {
+                    requirePayloadSize(request, 1);
+                    const auto slot = request.payload[0];
+
+                    if (slot >= state_.presetNames.size())
+                    {
+                        throw std::invalid_argument{"Invalid preset slot: " + std::to_string(slot)};
+                    }
+
+                    state_.signalChain = mustang_.load_memory_bank(slot);
+                    return okResponse(com::encodePresetRecord(state_.signalChain));
+                }
+                case Request::SetAmp:
+                {
+                    requirePayloadSize(request, com::ampRecordSize);
+                    const auto amp = com::decodeAmpRecord(std::span{request.payload}.first<com::ampRecordSize>());
+
+                    if (!com::isKnownAmp(amp.amp_num))
+                    {
+                        throw std::invalid_argument{"Invalid amp: " + std::to_string(request.payload[0])};
+                    }
+
+                    mustang_.set_amplifier(amp);
+                    state_.signalChain.setAmp(amp);
+                    return okResponse();
+                }
+                case Request::SetEffect:
+                {
+                    requirePayloadSize(request, com::effectRecordSize);
+                    const auto effect = com::decodeEffectRecord(std::span{request.payload}.first<com::effectRecordSize>());
+
+                    if (!com::isKnownEffect(effect.effect_num))
+                    {
+                        throw std::invalid_argument{"Invalid effect: " + std::to_string(request.payload[1])};
+                    }
+
+                    mustang_.set_effect(effect);
+
+                    auto effects = state_.signalChain.effects();
+                    std::erase_if(effects, [&effect](const auto& e)
+                                  { return e.slot.id() == effect.slot.id(); });
+                    effects.push_back(effect);
+                    state_.signalChain.setEffects(effects);
+                    return okResponse();
+                }
+                case Request::SavePreset:
+                {
+                    if (request.payload.empty() || (request.payload[0] >= state_.presetNames.size()))
+                    {
+                        throw std::invalid_argument{"Invalid preset slot"};
+                    }
+
+                    const auto slot = request.payload[0];
+                    const std::string name{std::next(request.payload.cbegin()), request.payload.cend()};
+                    mustang_.save_on_amp(name, slot);
+                    state_.presetNames[slot] = name;
+                    state_.signalChain.setName(name);
+                    return okResponse();
+                }
+                default:
+                    throw std::invalid_argument{"Unknown request: " + std::to_string(request.type)};
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            return errorResponse(ex.what());
+        }
+    }
+}
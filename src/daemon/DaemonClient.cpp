@@ -0,0 +1,98 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/DaemonClient.h"
+#include "com/CommunicationException.h"
+#include "com/PresetRecord.h"
+#include <array>
+
+namespace plug::daemon
+{
+    namespace
+    {
+        inline constexpr std::size_t receiveBufferSize{4096};
+    }
+
+    DaemonClient::DaemonClient(const std::filesystem::path& socketPath)
+        : socket_(connectTo(socketPath)), reader_()
+    {
+    }
+
+    com::InitialData DaemonClient::state()
+    {
+        return decodeState(request(Request::State, {}));
+    }
+
+    SignalChain DaemonClient::loadPreset(std::uint8_t slot)
+    {
+        const std::array<std::uint8_t, 1> payload{slot};
+        const auto response = request(Request::LoadPreset, payload);
+
+        if (response.size() != com::presetRecordSize)
+        {
+            throw com::CommunicationException{"Invalid preset response"};
+        }
+        return com::decodePresetRecord(std::span{response}.first<com::presetRecordSize>());
+    }
+
+    void DaemonClient::setAmp(const amp_settings& amp)
+    {
+        request(Request::SetAmp, com::encodeAmpRecord(amp));
+    }
+
+    void DaemonClient::setEffect(const fx_pedal_settings& effect)
+    {
+        request(Request::SetEffect, com::encodeEffectRecord(effect));
+    }
+
+    void DaemonClient::savePreset(std::uint8_t slot, std::string_view name)
+    {
+        std::vector<std::uint8_t> payload{slot};
+        payload.insert(payload.end(), name.cbegin(), name.cend());
+        request(Request::SavePreset, payload);
+    }
+
+    std::vector<std::uint8_t> DaemonClient::request(Request type, std::span<const std::uint8_t> payload)
+    {
+        socket_.writeAll(encodeFrame(static_cast<std::uint8_t>(type), payload));
+
+        auto response = reader_.next();
+        std::array<std::uint8_t, receiveBufferSize> buffer{};
+
+        while (!response.has_value())
+        {
+            const auto received = socket_.readSome(buffer);
+
+            if (received == 0)
+            {
+                throw com::CommunicationException{"Connection closed by daemon"};
+            }
+
+            reader_.append(std::span{buffer}.first(received));
+            response = reader_.next();
+        }
+
+        if (response->type != static_cast<std::uint8_t>(Status::Ok))
+        {
+            throw com::CommunicationException{std::string{response->payload.cbegin(), response->payload.cend()}};
+        }
+        return std::move(response->payload);
+    }
+}
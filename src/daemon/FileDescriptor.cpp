@@ -0,0 +1,187 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/FileDescriptor.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace plug::daemon
+{
+    namespace
+    {
+        inline constexpr int backlog{16};
+
+        sockaddr_un socketAddress(const std::filesystem::path& path)
+        {
+            sockaddr_un address{};
+            const auto& name = path.native();
+
+            if (name.size() >= sizeof(address.sun_path))
+            {
+                throw std::invalid_argument{"Socket path too long: " + name};
+            }
+
+            address.sun_family = AF_UNIX;
+            std::copy(name.cbegin(), name.cend(), address.sun_path);
+            return address;
+        }
+
+        FileDescriptor createSocket()
+        {
+            FileDescriptor socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+
+            if (!socket.isOpen())
+            {
+                throw std::system_error{errno, std::generic_category(), "Creating socket failed"};
+            }
+            return socket;
+        }
+    }
+
+    FileDescriptor::FileDescriptor() noexcept
+        : fd_(-1)
+    {
+    }
+
+    FileDescriptor::FileDescriptor(int fd) noexcept
+        : fd_(fd)
+    {
+    }
+
+    FileDescriptor::FileDescriptor(FileDescriptor&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+    {
+    }
+
+    FileDescriptor::~FileDescriptor()
+    {
+        close();
+    }
+
+    int FileDescriptor::get() const noexcept
+    {
+        return fd_;
+    }
+
+    bool FileDescriptor::isOpen() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    void FileDescriptor::close() noexcept
+    {
+        if (isOpen())
+        {
+            ::close(std::exchange(fd_, -1));
+        }
+    }
+
+    void FileDescriptor::writeAll(std::span<const std::uint8_t> data) const
+    {
+        while (!data.empty())
+        {
+            const auto written = ::send(fd_, data.data(), data.size(), MSG_NOSIGNAL);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(), "Writing failed"};
+            }
+            data = data.subspan(static_cast<std::size_t>(written));
+        }
+    }
+
+    std::size_t FileDescriptor::readSome(std::span<std::uint8_t> buffer) const
+    {
+        ssize_t received{0};
+
+        do
+        {
+            received = ::recv(fd_, buffer.data(), buffer.size(), 0);
+        } while ((received < 0) && (errno == EINTR));
+
+        if (received < 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "Reading failed"};
+        }
+        return static_cast<std::size_t>(received);
+    }
+
+    FileDescriptor& FileDescriptor::operator=(FileDescriptor&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+
+    FileDescriptor listenOn(const std::filesystem::path& path)
+    {
+        const auto address = socketAddress(path);
+        auto socket = createSocket();
+
+        if (::bind(socket.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "Binding " + path.string() + " failed"};
+        }
+
+        if (::listen(socket.get(), backlog) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "Listening on " + path.string() + " failed"};
+        }
+        return socket;
+    }
+
+    FileDescriptor connectTo(const std::filesystem::path& path)
+    {
+        const auto address = socketAddress(path);
+        auto socket = createSocket();
+
+        if (::connect(socket.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "Connecting to " + path.string() + " failed"};
+        }
+        return socket;
+    }
+
+    FileDescriptor acceptFrom(const FileDescriptor& listener)
+    {
+        FileDescriptor socket{::accept4(listener.get(), nullptr, nullptr, SOCK_CLOEXEC)};
+
+        if (!socket.isOpen())
+        {
+            throw std::system_error{errno, std::generic_category(), "Accepting connection failed"};
+        }
+        return socket;
+    }
+}
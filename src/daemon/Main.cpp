@@ -0,0 +1,90 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/AmpDaemon.h"
+#include "com/ConnectionFactory.h"
+#include "com/Mustang.h"
+#include "com/UsbContext.h"
+#include "Version.h"
+#include <csignal>
+#include <filesystem>
+#include <pthread.h>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+int main(int argc, char* argv[])
+{
+    const std::string_view option{argc > 1 ? argv[1] : ""};
+
+    if ((option == "--help") || (option == "-h") || (argc > 2))
+    {
+        std::cout << "Usage: plugd [socket]\n"
+                  << "Serves the connected amp on the socket (default: " << plug::daemon::defaultSocketPath().string() << ")\n";
+        return (argc > 2) ? 1 : 0;
+    }
+
+    if (option == "--version")
+    {
+        std::cout << "plugd " << plug::version() << '\n';
+        return 0;
+    }
+
+    // Termination signals are handled by a thread instead of an async handler
+    sigset_t signals{};
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+        plug::com::usb::Context context{};
+
+        auto mustang = plug::com::connect();
+        plug::daemon::AmpDaemon daemon{*mustang, option.empty() ? plug::daemon::defaultSocketPath() : std::filesystem::path{option}};
+
+        std::jthread signalHandler{[&daemon, &signals]
+                                   {
+                                       int signal{0};
+                                       sigwait(&signals, &signal);
+                                       daemon.stop();
+                                   }};
+
+        try
+        {
+            daemon.run();
+        }
+        catch (...)
+        {
+            // Releases the signal thread, it's joined on unwinding
+            pthread_kill(signalHandler.native_handle(), SIGTERM);
+            throw;
+        }
+
+        mustang->stop_amp();
+        return 0;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "error: " << ex.what() << '\n';
+        return 1;
+    }
+}
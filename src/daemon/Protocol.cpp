@@ -0,0 +1,130 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/Protocol.h"
+#include "com/PresetRecord.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace plug::daemon
+{
+    namespace
+    {
+        inline constexpr std::size_t maxPresetNameSize{0xff};
+    }
+
+    std::vector<std::uint8_t> encodeFrame(std::uint8_t type, std::span<const std::uint8_t> payload)
+    {
+        if (payload.size() > maxPayloadSize)
+        {
+            throw std::length_error{"Payload too large: " + std::to_string(payload.size())};
+        }
+
+        std::vector<std::uint8_t> frame;
+        frame.reserve(frameHeaderSize + payload.size());
+        frame.push_back(type);
+        frame.push_back(static_cast<std::uint8_t>(payload.size() & 0xff));
+        frame.push_back(static_cast<std::uint8_t>((payload.size() >> 8) & 0xff));
+        frame.insert(frame.end(), payload.begin(), payload.end());
+        return frame;
+    }
+
+    std::vector<std::uint8_t> encodeState(const com::InitialData& state)
+    {
+        // Current preset record, number of presets and the length prefixed preset names
+        const auto record = com::encodePresetRecord(state.signalChain);
+        const auto numberOfPresets = std::min<std::size_t>(state.presetNames.size(), 0xff);
+
+        std::vector<std::uint8_t> payload{record.cbegin(), record.cend()};
+        payload.push_back(static_cast<std::uint8_t>(numberOfPresets));
+
+        std::for_each_n(state.presetNames.cbegin(), numberOfPresets, [&payload](const auto& name)
+                        {
+            const auto size = std::min(name.size(), maxPresetNameSize);
+            payload.push_back(static_cast<std::uint8_t>(size));
+            payload.insert(payload.end(), name.cbegin(), std::next(name.cbegin(), static_cast<std::ptrdiff_t>(size))); });
+        return payload;
+    }
+
+    com::InitialData decodeState(std::span<const std::uint8_t> payload)
+    {
+        if (payload.size() < (com::presetRecordSize + 1))
+        {
+            throw std::invalid_argument{"Invalid state payload"};
+        }
+
+        com::InitialData state{com::decodePresetRecord(payload.first<com::presetRecordSize>()), {}};
+        const std::size_t numberOfPresets{payload[com::presetRecordSize]};
+        auto names = payload.subspan(com::presetRecordSize + 1);
+
+        state.presetNames.reserve(numberOfPresets);
+
+        for (std::size_t i = 0; i < numberOfPresets; ++i)
+        {
+            if (names.empty() || (names.size() < (names[0] + std::size_t{1})))
+            {
+                throw std::invalid_argument{"Truncated state payload"};
+            }
+
+            const auto name = names.subspan(1, names[0]);
+            state.presetNames.emplace_back(name.begin(), name.end());
+            names = names.subspan(name.size() + 1);
+        }
+        return state;
+    }
+
+    std::filesystem::path defaultSocketPath()
+    {
+        if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR"); runtimeDir != nullptr)
+        {
+            return std::filesystem::path{runtimeDir} / "plug.sock";
+        }
+        return std::filesystem::temp_directory_path() / ("plug-" + std::to_string(::getuid()) + ".sock");
+    }
+
+
+    void FrameReader::append(std::span<const std::uint8_t> data)
+    {
+        buffer_.insert(buffer_.end(), data.begin(), data.end());
+    }
+
+    std::optional<Frame> FrameReader::next()
+    {
+        if (buffer_.size() < frameHeaderSize)
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t payloadSize = buffer_[1] | (buffer_[2] << 8);
+        const auto frameSize = static_cast<std::ptrdiff_t>(frameHeaderSize + payloadSize);
+
+        if (buffer_.size() < static_cast<std::size_t>(frameSize))
+        {
+            return std::nullopt;
+        }
+
+        Frame frame{buffer_[0], {std::next(buffer_.cbegin(), frameHeaderSize), std::next(buffer_.cbegin(), frameSize)}};
+        buffer_.erase(buffer_.cbegin(), std::next(buffer_.cbegin(), frameSize));
+        return frame;
+    }
+}
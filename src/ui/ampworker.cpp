@@ -0,0 +1,279 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/ampworker.h"
+#include "com/ConnectionFactory.h"
+#include "com/MustangUpdater.h"
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <QDebug>
+
+namespace plug
+{
+    AmpWorker::AmpWorker(QObject* parent)
+        : QObject(parent),
+          watcher(nullptr),
+          amp_ops(nullptr),
+          firmwareStop(),
+          commandsAvailable(0),
+          freeSlots(CommandQueue::capacity()),
+          worker([this](std::stop_token stopToken)
+                 { run(stopToken); })
+    {
+        qRegisterMetaType<plug::DeviceModel>();
+        qRegisterMetaType<plug::SignalChain>();
+        qRegisterMetaType<plug::com::InitialData>();
+    }
+
+    AmpWorker::~AmpWorker()
+    {
+        firmwareStop.request_stop();
+        worker.request_stop();
+        commandsAvailable.release();
+        worker.join();
+
+        // The worker thread is done, the watcher isn't accessed anymore
+        watcher.reset();
+    }
+
+    void AmpWorker::start()
+    {
+        // The watcher is owned by the worker thread; the availability of present amps is reported
+        // on this thread while it's created, later changes on the usb event thread
+        post([this]
+             { watcher = std::make_unique<com::AmpWatcher>([this](bool available)
+                                                           { emit ampAvailable(available); }); });
+    }
+
+    void AmpWorker::connectAmp()
+    {
+        post([this]
+             {
+            if (watcher == nullptr)
+            {
+                throw std::logic_error{"Amp worker not started"};
+            }
+
+            // Hotplug and connect on startup may both request a connection
+            if (amp_ops != nullptr)
+            {
+                return;
+            }
+
+            amp_ops = watcher->connect();
+            auto data = amp_ops->start_amp();
+            emit connected(data, amp_ops->getDeviceModel()); });
+    }
+
+    void AmpWorker::disconnectAmp()
+    {
+        post([this]
+             {
+            if (amp_ops != nullptr)
+            {
+                amp_ops->stop_amp();
+                amp_ops.reset();
+            }
+            emit disconnected(); });
+    }
+
+    void AmpWorker::releaseAmp()
+    {
+        // The amp is gone, so it's dropped without the shutdown communication
+        post([this]
+             {
+            if (amp_ops != nullptr)
+            {
+                amp_ops.reset();
+                emit disconnected();
+            } });
+    }
+
+    void AmpWorker::sendSettings(com::PendingSettings settings)
+    {
+        post([this, settings]
+             {
+            if (amp_ops != nullptr)
+            {
+                com::sendSettings(*amp_ops, settings);
+            } });
+    }
+
+    void AmpWorker::saveOnAmp(std::string name, std::uint8_t slot)
+    {
+        post([this, name, slot]
+             {
+            if (amp_ops != nullptr)
+            {
+                amp_ops->save_on_amp(name, slot);
+                emit savedOnAmp(QString::fromStdString(name), slot);
+            } });
+    }
+
+    void AmpWorker::loadFromAmp(std::uint8_t slot)
+    {
+        post([this, slot]
+             {
+            if (amp_ops != nullptr)
+            {
+                emit memoryBankLoaded(slot, amp_ops->load_memory_bank(slot));
+            } });
+    }
+
+    void AmpWorker::selectMemoryBank(std::uint8_t slot)
+    {
+        post([this, slot]
+             {
+            if (amp_ops != nullptr)
+            {
+                amp_ops->select_memory_bank(slot);
+            } });
+    }
+
+    void AmpWorker::saveEffects(std::uint8_t slot, std::string name, std::vector<fx_pedal_settings> effects)
+    {
+        post([this, slot, name, effects]
+             {
+            if (amp_ops != nullptr)
+            {
+                amp_ops->save_effects(slot, name, effects);
+            } });
+    }
+
+    void AmpWorker::updateFirmware(std::string filename)
+    {
+        firmwareStop = std::stop_source{};
+
+        post([this, filename, stopToken = firmwareStop.get_token()]
+             {
+            try
+            {
+                const auto status = com::updateFirmware(filename, [this](std::size_t sent, std::size_t total)
+                                                        { emit firmwareProgress(static_cast<int>(sent), static_cast<int>(total)); },
+                                                        stopToken);
+                emit firmwareUpdateFinished(status == com::UpdateStatus::finished);
+            }
+            catch (...)
+            {
+                emit firmwareUpdateFinished(false);
+                throw;
+            } });
+    }
+
+    void AmpWorker::cancelFirmwareUpdate()
+    {
+        firmwareStop.request_stop();
+    }
+
+    void AmpWorker::backupAmp(std::string filename)
+    {
+        post([this, filename]
+             {
+            if (amp_ops == nullptr)
+            {
+                return;
+            }
+
+            try
+            {
+                std::ofstream out{filename, std::ios::binary};
+
+                if (!out)
+                {
+                    throw std::runtime_error{"Could not create " + filename};
+                }
+
+                amp_ops->backupAll(out);
+                emit backupFinished(true);
+            }
+            catch (...)
+            {
+                emit backupFinished(false);
+                throw;
+            } });
+    }
+
+    void AmpWorker::restoreAmp(std::string filename)
+    {
+        post([this, filename]
+             {
+            if (amp_ops == nullptr)
+            {
+                return;
+            }
+
+            try
+            {
+                std::ifstream in{filename, std::ios::binary};
+
+                if (!in)
+                {
+                    throw std::runtime_error{"Could not open " + filename};
+                }
+
+                amp_ops->restoreAll(com::readBackup(in));
+                emit restoreFinished(true);
+            }
+            catch (...)
+            {
+                emit restoreFinished(false);
+                throw;
+            } });
+    }
+
+    void AmpWorker::post(Command command)
+    {
+        // The GUI thread is the only producer; a full queue blocks until the worker has taken a command
+        freeSlots.acquire();
+        commands.tryPush(std::move(command));
+        commandsAvailable.release();
+    }
+
+    void AmpWorker::run(std::stop_token stopToken)
+    {
+        while (stopToken.stop_requested() == false)
+        {
+            commandsAvailable.acquire();
+
+            if (auto command = commands.tryPop(); command.has_value())
+            {
+                freeSlots.release();
+
+                try
+                {
+                    (*command)();
+                }
+                catch (const std::exception& ex)
+                {
+                    qWarning() << "ERROR: " << ex.what();
+                    emit failed(QString::fromUtf8(ex.what()));
+                }
+                catch (...)
+                {
+                    qWarning() << "ERROR: Unknown error";
+                    emit failed(tr("Unknown error"));
+                }
+            }
+        }
+    }
+}
+
+#include "ui/moc_ampworker.moc"
@@ -21,19 +21,34 @@
 
 #include "ui/library.h"
 #include "ui/mainwindow.h"
+#include "ui/loadfromfile.h"
 #include "ui_library.h"
+#include <QCryptographicHash>
 #include <QDir>
 #include <QFileDialog>
+#include <QFileSystemWatcher>
 #include <QSettings>
+#include <QSignalBlocker>
+#include <QStandardPaths>
 #include <algorithm>
+#include <fstream>
 
 namespace plug
 {
+    namespace
+    {
+        QString indexFile(const QString& directory)
+        {
+            // One index per library directory
+            const auto hash = QCryptographicHash::hash(directory.toUtf8(), QCryptographicHash::Sha1).toHex();
+            return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/library/" + QString::fromLatin1(hash) + ".index";
+        }
+    }
 
     Library::Library(const std::vector<std::string>& names, QWidget* parent)
         : QDialog(parent),
           ui(std::make_unique<Ui::Library>()),
-          files(std::make_unique<QList<QFileInfo>>())
+          watcher(new QFileSystemWatcher(this))
     {
         ui->setupUi(this);
         QSettings settings;
@@ -65,12 +80,14 @@ namespace plug
         connect(this, SIGNAL(directory_changed(QString)), this, SLOT(get_files(QString)));
         connect(ui->spinBox, SIGNAL(valueChanged(int)), this, SLOT(change_font_size(int)));
         connect(ui->fontComboBox, SIGNAL(currentFontChanged(QFont)), this, SLOT(change_font_family(QFont)));
+        connect(watcher, SIGNAL(directoryChanged(QString)), this, SLOT(refresh_files()));
     }
 
     Library::~Library()
     {
         QSettings settings;
         settings.setValue("Windows/libraryWindowGeometry", saveGeometry());
+        saveIndex();
     }
 
     void Library::load_slot(int slot)
@@ -95,24 +112,95 @@ namespace plug
 
     void Library::get_files(const QString& path)
     {
-        QDir directory(path, "*.fuse", (QDir::Name | QDir::IgnoreCase), (QDir::Files | QDir::NoDotAndDotDot | QDir::Readable));
-
-        if (!files->isEmpty())
+        if (path != directory)
         {
-            files->clear();
+            if (!directory.isEmpty())
+            {
+                saveIndex();
+                watcher->removePath(directory);
+            }
+
+            directory = path;
+            loadIndex();
+            watcher->addPath(directory);
         }
-        ui->listWidget_2->clear();
-        *files = directory.entryInfoList(QDir::Files | QDir::NoDotAndDotDot | QDir::Readable);
-        for (int i = 0; i < files->size(); ++i)
+        refresh_files();
+    }
+
+    void Library::refresh_files()
+    {
+        // Only new and changed files are parsed, all others are taken from the index
+        if (presetIndex.refresh(directory.toStdString(), loadPresetFile))
         {
-            ui->listWidget_2->addItem((*files)[i].completeBaseName());
+            saveIndex();
         }
+        showFiles();
     }
 
     void Library::load_file(int row)
     {
+        if ((row < 0) || (static_cast<std::size_t>(row) >= files.size()))
+        {
+            return;
+        }
+
         ui->listWidget->setCurrentRow(-1);
-        dynamic_cast<MainWindow*>(parent())->loadfile((*files)[row].canonicalFilePath());
+
+        // Files changed in place are reloaded, unchanged ones don't need to be parsed again
+        if (const auto signalChain = presetIndex.refreshFile(files[static_cast<std::size_t>(row)].path, loadPresetFile); signalChain.has_value())
+        {
+            dynamic_cast<MainWindow*>(parent())->loadSignalChain(*signalChain);
+        }
+        else
+        {
+            refresh_files();
+        }
+    }
+
+    void Library::loadIndex()
+    {
+        presetIndex = com::PresetLibraryIndex{};
+        std::ifstream in{indexFile(directory).toStdString(), std::ios::binary};
+
+        if (in)
+        {
+            presetIndex.load(in);
+        }
+    }
+
+    void Library::saveIndex() const
+    {
+        if (directory.isEmpty())
+        {
+            return;
+        }
+
+        const QString file = indexFile(directory);
+        QDir{}.mkpath(QFileInfo{file}.absolutePath());
+        std::ofstream out{file.toStdString(), std::ios::binary};
+        presetIndex.save(out);
+    }
+
+    void Library::showFiles()
+    {
+        const int row = ui->listWidget_2->currentRow();
+        const auto current = ((row >= 0) && (static_cast<std::size_t>(row) < files.size())) ? files[static_cast<std::size_t>(row)].path : std::filesystem::path{};
+
+        // Refreshing the list must not load the selected preset again
+        const QSignalBlocker blocker{ui->listWidget_2};
+        ui->listWidget_2->clear();
+        files = presetIndex.entries();
+
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            auto* item = new QListWidgetItem(QString::fromStdString(files[i].path.stem().string()), ui->listWidget_2);
+            item->setToolTip(QString::fromStdString(files[i].signalChain.name()));
+
+            if (files[i].path == current)
+            {
+                ui->listWidget_2->setCurrentRow(static_cast<int>(i));
+            }
+        }
     }
 
     void Library::resizeEvent(QResizeEvent* event)
@@ -21,6 +21,8 @@
 
 #include "ui/loadfromfile.h"
 #include "effects_enum.h"
+#include "com/ModelRegistry.h"
+#include <stdexcept>
 
 namespace plug
 {
@@ -59,6 +61,16 @@ namespace plug
         return settings;
     }
 
+    bool LoadFromFile::hasError() const
+    {
+        return xml.hasError();
+    }
+
+    QString LoadFromFile::errorString() const
+    {
+        return xml.errorString();
+    }
+
     amp_settings LoadFromFile::parseAmp()
     {
         xml.readNextStartElement();
@@ -69,75 +81,9 @@ namespace plug
             {
                 if (xml.name().toString() == "Module")
                 {
-                    switch (xml.attributes().value("ID").toString().toInt())
+                    if (const auto model = com::findAmpById(static_cast<std::size_t>(xml.attributes().value("ID").toString().toInt())); model.has_value())
                     {
-                        case 0x67:
-                            amp.amp_num = amps::FENDER_57_DELUXE;
-                            break;
-
-                        case 0x64:
-                            amp.amp_num = amps::FENDER_59_BASSMAN;
-                            break;
-
-                        case 0x7c:
-                            amp.amp_num = amps::FENDER_57_CHAMP;
-                            break;
-
-                        case 0x53:
-                            amp.amp_num = amps::FENDER_65_DELUXE_REVERB;
-                            break;
-
-                        case 0x6a:
-                            amp.amp_num = amps::FENDER_65_PRINCETON;
-                            break;
-
-                        case 0x75:
-                            amp.amp_num = amps::FENDER_65_TWIN_REVERB;
-                            break;
-
-                        case 0x72:
-                            amp.amp_num = amps::FENDER_SUPER_SONIC;
-                            break;
-
-                        case 0x61:
-                            amp.amp_num = amps::BRITISH_60S;
-                            break;
-
-                        case 0x79:
-                            amp.amp_num = amps::BRITISH_70S;
-                            break;
-
-                        case 0x5e:
-                            amp.amp_num = amps::BRITISH_80S;
-                            break;
-
-                        case 0x5d:
-                            amp.amp_num = amps::AMERICAN_90S;
-                            break;
-
-                        case 0x6d:
-                            amp.amp_num = amps::METAL_2000;
-                            break;
-
-                        case 0xf1:
-                            amp.amp_num = amps::STUDIO_PREAMP;
-                            break;
-
-                        case 0xf6:
-                            amp.amp_num = amps::FENDER_57_TWIN;
-                            break;
-
-                        case 0xf9:
-                            amp.amp_num = amps::FENDER_60_THRIFT;
-                            break;
-
-                        case 0xfc:
-                            amp.amp_num = amps::BRITISH_COLOUR;
-                            break;
-
-                        case 0xff:
-                            amp.amp_num = amps::BRITISH_WATTS;
-                            break;
+                        amp.amp_num = model->amp;
                     }
                 }
                 else if (xml.name().toString() == "Param")
@@ -228,191 +174,9 @@ namespace plug
                     const int position = xml.attributes().value("POS").toString().toInt();
                     effect.slot = FxSlot{static_cast<std::uint8_t>(position)};
 
-                    switch (xml.attributes().value("ID").toString().toInt())
+                    if (const auto model = com::findEffectByFileId(static_cast<std::size_t>(xml.attributes().value("ID").toString().toInt())); model.has_value())
                     {
-                        case 0x00:
-                            effect.effect_num = effects::EMPTY;
-                            break;
-
-                        case 0x3c:
-                            effect.effect_num = effects::OVERDRIVE;
-                            break;
-
-                        case 0x49:
-                            effect.effect_num = effects::WAH;
-                            break;
-
-                        case 0x4a:
-                            effect.effect_num = effects::TOUCH_WAH;
-                            break;
-
-                        case 0x1a:
-                            effect.effect_num = effects::FUZZ;
-                            break;
-
-                        case 0x1c:
-                            effect.effect_num = effects::FUZZ_TOUCH_WAH;
-                            break;
-
-                        case 0x88:
-                            effect.effect_num = effects::SIMPLE_COMP;
-                            break;
-
-                        case 0x07:
-                            effect.effect_num = effects::COMPRESSOR;
-                            break;
-
-                        case 0x12:
-                            effect.effect_num = effects::SINE_CHORUS;
-                            break;
-
-                        case 0x13:
-                            effect.effect_num = effects::TRIANGLE_CHORUS;
-                            break;
-
-                        case 0x18:
-                            effect.effect_num = effects::SINE_FLANGER;
-                            break;
-
-                        case 0x19:
-                            effect.effect_num = effects::TRIANGLE_FLANGER;
-                            break;
-
-                        case 0x2d:
-                            effect.effect_num = effects::VIBRATONE;
-                            break;
-
-                        case 0x40:
-                            effect.effect_num = effects::VINTAGE_TREMOLO;
-                            break;
-
-                        case 0x41:
-                            effect.effect_num = effects::SINE_TREMOLO;
-                            break;
-
-                        case 0x22:
-                            effect.effect_num = effects::RING_MODULATOR;
-                            break;
-
-                        case 0x29:
-                            effect.effect_num = effects::STEP_FILTER;
-                            break;
-
-                        case 0x4f:
-                            effect.effect_num = effects::PHASER;
-                            break;
-
-                        case 0x1f:
-                            effect.effect_num = effects::PITCH_SHIFTER;
-                            break;
-
-                        case 0x16:
-                            effect.effect_num = effects::MONO_DELAY;
-                            break;
-
-                        case 0x43:
-                            effect.effect_num = effects::MONO_ECHO_FILTER;
-                            break;
-
-                        case 0x48:
-                            effect.effect_num = effects::STEREO_ECHO_FILTER;
-                            break;
-
-                        case 0x44:
-                            effect.effect_num = effects::MULTITAP_DELAY;
-                            break;
-
-                        case 0x45:
-                            effect.effect_num = effects::PING_PONG_DELAY;
-                            break;
-
-                        case 0x15:
-                            effect.effect_num = effects::DUCKING_DELAY;
-                            break;
-
-                        case 0x46:
-                            effect.effect_num = effects::REVERSE_DELAY;
-                            break;
-
-                        case 0x2b:
-                            effect.effect_num = effects::TAPE_DELAY;
-                            break;
-
-                        case 0x2a:
-                            effect.effect_num = effects::STEREO_TAPE_DELAY;
-                            break;
-
-                        case 0x24:
-                            effect.effect_num = effects::SMALL_HALL_REVERB;
-                            break;
-
-                        case 0x3a:
-                            effect.effect_num = effects::LARGE_HALL_REVERB;
-                            break;
-
-                        case 0x26:
-                            effect.effect_num = effects::SMALL_ROOM_REVERB;
-                            break;
-
-                        case 0x3b:
-                            effect.effect_num = effects::LARGE_ROOM_REVERB;
-                            break;
-
-                        case 0x4e:
-                            effect.effect_num = effects::SMALL_PLATE_REVERB;
-                            break;
-
-                        case 0x4b:
-                            effect.effect_num = effects::LARGE_PLATE_REVERB;
-                            break;
-
-                        case 0x4c:
-                            effect.effect_num = effects::AMBIENT_REVERB;
-                            break;
-
-                        case 0x4d:
-                            effect.effect_num = effects::ARENA_REVERB;
-                            break;
-
-                        case 0x21:
-                            effect.effect_num = effects::FENDER_63_SPRING_REVERB;
-                            break;
-
-                        case 0x0b:
-                            effect.effect_num = effects::FENDER_65_SPRING_REVERB;
-                            break;
-
-                        case 0x103:
-                            effect.effect_num = effects::RANGER_BOOST;
-                            break;
-
-                        case 0xba:
-                            effect.effect_num = effects::GREENBOX;
-                            break;
-
-                        case 0x110:
-                            effect.effect_num = effects::ORANGEBOX;
-                            break;
-
-                        case 0x111:
-                            effect.effect_num = effects::BLACKBOX;
-                            break;
-
-                        case 0x10f:
-                            effect.effect_num = effects::BIG_FUZZ;
-                            break;
-
-                        case 0xf4:
-                            effect.effect_num = effects::WAH_MOD;
-                            break;
-
-                        case 0xf5:
-                            effect.effect_num = effects::TOUCH_WAH_MOD;
-                            break;
-
-                        case 0x11f:
-                            effect.effect_num = effects::DIATONIC_PITCH_SHIFTER;
-                            break;
+                        effect.effect_num = model->effect;
                     }
                 }
                 else if (xml.name().toString() == "Param")
@@ -471,4 +235,23 @@ namespace plug
         }
         return "Unknown";
     }
+
+    SignalChain loadPresetFile(const std::filesystem::path& path)
+    {
+        QFile file{QString::fromStdString(path.string())};
+
+        if (!file.open(QFile::ReadOnly | QFile::Text))
+        {
+            throw std::runtime_error{"Could not open file " + path.string()};
+        }
+
+        LoadFromFile loader{&file};
+        const auto fileSettings = loader.loadfile();
+
+        if (loader.hasError())
+        {
+            throw std::runtime_error{"Invalid preset file " + path.string() + ": " + loader.errorString().toStdString()};
+        }
+        return SignalChain{fileSettings.name.toStdString(), fileSettings.amp, fileSettings.effects};
+    }
 }
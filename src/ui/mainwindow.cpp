@@ -31,17 +31,20 @@
 #include "ui/saveonamp.h"
 #include "ui/savetofile.h"
 #include "ui/settings.h"
-#include "com/Mustang.h"
-#include "com/ConnectionFactory.h"
+#include "com/SettingsCoalescer.h"
 #include "com/CommunicationException.h"
-#include "com/MustangUpdater.h"
+#include "com/PresetBank.h"
 #include "ui_defaulteffects.h"
 #include "ui_mainwindow.h"
 #include <algorithm>
+#include <chrono>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QSettings>
 #include <QShortcut>
+#include <QTimer>
 #include <QDebug>
 
 namespace plug
@@ -80,7 +83,9 @@ namespace plug
         : QMainWindow(parent),
           ui(std::make_unique<Ui::MainWindow>()),
           presetNames(100, ""),
-          amp_ops(nullptr),
+          worker(new AmpWorker(this)),
+          pendingSettings(nullptr),
+          flushTimer(new QTimer(this)),
           effectComponents{{new Effect{this, FxSlot{0}},
                             new Effect{this, FxSlot{1}},
                             new Effect{this, FxSlot{2}},
@@ -118,6 +123,23 @@ namespace plug
         {
             settings.setValue("Settings/defaultEffectValues", true);
         }
+        if (!settings.contains("Settings/minUpdateIntervalMs"))
+        {
+            settings.setValue("Settings/minUpdateIntervalMs", 20);
+        }
+
+        // settings changes are coalesced and sent at a limited rate
+        pendingSettings = std::make_unique<com::SettingsCoalescer>(std::chrono::milliseconds{settings.value("Settings/minUpdateIntervalMs").toInt()});
+        flushTimer->setSingleShot(true);
+        connect(flushTimer, &QTimer::timeout, this, &MainWindow::flushSettings);
+
+        // results of the communication worker thread
+        connect(worker, &AmpWorker::connected, this, &MainWindow::ampConnected);
+        connect(worker, &AmpWorker::disconnected, this, &MainWindow::ampDisconnected);
+        connect(worker, &AmpWorker::ampAvailable, this, &MainWindow::ampAvailabilityChanged, Qt::QueuedConnection);
+        connect(worker, &AmpWorker::savedOnAmp, this, &MainWindow::savedOnAmp);
+        connect(worker, &AmpWorker::memoryBankLoaded, this, &MainWindow::memoryBankLoaded);
+        connect(worker, &AmpWorker::failed, this, &MainWindow::showError);
 
         // create child objects
         amp = new Amplifier(this);
@@ -152,6 +174,8 @@ namespace plug
         connect(ui->actionS_ave_to_file, SIGNAL(triggered()), saver, SLOT(show()));
         connect(ui->action_Library_view, SIGNAL(triggered()), this, SLOT(show_library()));
         connect(ui->action_Update_firmware, SIGNAL(triggered()), this, SLOT(update_firmware()));
+        connect(ui->action_Backup_amplifier, SIGNAL(triggered()), this, SLOT(backup_amp()));
+        connect(ui->action_Restore_amplifier, SIGNAL(triggered()), this, SLOT(restore_amp()));
         connect(ui->action_Default_effects, SIGNAL(triggered()), this, SLOT(show_default_effects()));
         connect(ui->action_Quick_presets, SIGNAL(triggered()), quickpres, SLOT(show()));
 
@@ -189,6 +213,9 @@ namespace plug
         this->show();
         this->repaint();
 
+        // The user interface is complete, amps present already are reported from now on; posted before the connect on startup
+        worker->start();
+
         emit started();
     }
 
@@ -221,29 +248,18 @@ namespace plug
 
     void MainWindow::start_amp()
     {
-        QSettings settings;
-        amp_settings amplifier_set{};
-        std::vector<fx_pedal_settings> effects_set{};
-        QString name;
-
         ui->statusBar->showMessage(tr("Connecting..."));
-        this->repaint(); // this should not be needed!
+        worker->connectAmp();
+    }
 
-        try
-        {
-            amp_ops = plug::com::connect();
-            const auto [signalChain, presets] = amp_ops->start_amp();
-            name = QString::fromStdString(signalChain.name());
-            amplifier_set = signalChain.amp();
-            effects_set = signalChain.effects();
-            presetNames = presets;
-        }
-        catch (const std::exception& ex)
-        {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
-        }
+    void MainWindow::ampConnected(const plug::com::InitialData& data, const plug::DeviceModel& model)
+    {
+        QSettings settings;
+        presetCache.clear();
+        const QString name = QString::fromStdString(data.signalChain.name());
+        const amp_settings amplifier_set = data.signalChain.amp();
+        const std::vector<fx_pedal_settings> effects_set = data.signalChain.effects();
+        presetNames = data.presetNames;
 
         load->load_names(presetNames);
         save->load_names(presetNames);
@@ -256,7 +272,6 @@ namespace plug
         }
         else
         {
-            const auto model = amp_ops->getDeviceModel();
             setWindowTitle(QString(tr("PLUG - %1 %2: %3"))
                                .arg(QString::fromStdString(model.name()))
                                .arg(model.category() == DeviceModel::Category::MustangV2 ? "(v2)" : "")
@@ -266,7 +281,7 @@ namespace plug
 
         current_name = name;
 
-        amp->setDeviceModel(amp_ops->getDeviceModel());
+        amp->setDeviceModel(model);
         amp->load(amplifier_set);
         if (settings.value("Settings/popupChangedWindows").toBool())
         {
@@ -274,7 +289,6 @@ namespace plug
         }
 
         // Enable only those effects supported by the Mustang
-        const auto model = amp_ops->getDeviceModel();
         std::for_each(effectComponents.cbegin(), effectComponents.cend(), [&model](const auto& effect)
                       { effect->setDeviceModel(model); });
 
@@ -298,6 +312,8 @@ namespace plug
         ui->action_Load_from_amplifier->setDisabled(false);
         ui->actionSave_effects->setDisabled(false);
         ui->action_Library_view->setDisabled(false);
+        ui->action_Backup_amplifier->setDisabled(false);
+        ui->action_Restore_amplifier->setDisabled(false);
         ui->statusBar->showMessage(tr("Connected"), 3000);
 
         connected = true;
@@ -309,31 +325,52 @@ namespace plug
         load->delete_items();
         quickpres->delete_items();
 
-        try
-        {
-            amp_ops->stop_amp();
+        flushTimer->stop();
+        pendingSettings->discard();
 
-            // deactivate buttons
-            amp->enable_set_button(false);
-            std::for_each(effectComponents.cbegin(), effectComponents.cend(), [](const auto& effect)
-                          { effect->enable_set_button(false); });
-            ui->actionConnect->setDisabled(false);
-            ui->actionDisconnect->setDisabled(true);
-            ui->actionSave_to_amplifier->setDisabled(true);
-            ui->action_Load_from_amplifier->setDisabled(true);
-            ui->actionSave_effects->setDisabled(true);
-            ui->action_Library_view->setDisabled(true);
-            setWindowTitle(QString(tr("PLUG")));
-            setAccessibleName(QString(tr("Main window: None")));
-            ui->statusBar->showMessage(tr("Disconnected"), 5000);
+        worker->disconnectAmp();
+    }
 
-            connected = false;
+    void MainWindow::ampDisconnected()
+    {
+        presetCache.clear();
+
+        // deactivate buttons
+        amp->enable_set_button(false);
+        std::for_each(effectComponents.cbegin(), effectComponents.cend(), [](const auto& effect)
+                      { effect->enable_set_button(false); });
+        ui->actionConnect->setDisabled(false);
+        ui->actionDisconnect->setDisabled(true);
+        ui->actionSave_to_amplifier->setDisabled(true);
+        ui->action_Load_from_amplifier->setDisabled(true);
+        ui->actionSave_effects->setDisabled(true);
+        ui->action_Library_view->setDisabled(true);
+        ui->action_Backup_amplifier->setDisabled(true);
+        ui->action_Restore_amplifier->setDisabled(true);
+        setWindowTitle(QString(tr("PLUG")));
+        setAccessibleName(QString(tr("Main window: None")));
+        ui->statusBar->showMessage(tr("Disconnected"), 5000);
+
+        connected = false;
+    }
+
+    void MainWindow::ampAvailabilityChanged(bool available)
+    {
+        // A plugged in amp is connected right away, a removed one is released without talking to it
+        if (available && !connected)
+        {
+            start_amp();
         }
-        catch (const std::exception& ex)
+        else if (!available && connected)
         {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
+            save->delete_items();
+            load->delete_items();
+            quickpres->delete_items();
+
+            flushTimer->stop();
+            pendingSettings->discard();
+
+            worker->releaseAmp();
         }
     }
 
@@ -349,16 +386,8 @@ namespace plug
 
         if (!settings.value("Settings/oneSetToSetThemAll").toBool())
         {
-            try
-            {
-                amp_ops->set_effect(pedal);
-            }
-            catch (const std::exception& ex)
-            {
-                qWarning() << "ERROR: " << ex.what();
-                ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-                return;
-            }
+            pendingSettings->update(pedal);
+            scheduleSettingsFlush();
         }
         amp->send_amp();
     }
@@ -372,26 +401,18 @@ namespace plug
 
         QSettings settings;
 
-        try
-        {
-            if (settings.value("Settings/oneSetToSetThemAll").toBool())
-            {
-                std::for_each(effectComponents.begin(), effectComponents.end(), [this](const auto& comp)
-                              {
-                    if (comp->get_changed())
-                    {
-                        amp_ops->set_effect(comp->getSettings());
-                    } });
-            }
-
-            amp_ops->set_amplifier(amp_settings);
-        }
-        catch (const std::exception& ex)
+        if (settings.value("Settings/oneSetToSetThemAll").toBool())
         {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
+            std::for_each(effectComponents.begin(), effectComponents.end(), [this](const auto& comp)
+                          {
+                if (comp->get_changed())
+                {
+                    pendingSettings->update(comp->getSettings());
+                } });
         }
+
+        pendingSettings->update(amp_settings);
+        scheduleSettingsFlush();
     }
 
     void MainWindow::save_on_amp(char* name, int slot)
@@ -401,18 +422,16 @@ namespace plug
             return;
         }
 
-        try
-        {
-            amp_ops->save_on_amp(name, static_cast<std::uint8_t>(slot));
-        }
-        catch (const std::exception& ex)
-        {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
-        }
+        flushSettings();
+
+        worker->saveOnAmp(name, static_cast<std::uint8_t>(slot));
+    }
 
-        if (name[0] == 0x00)
+    void MainWindow::savedOnAmp(const QString& name, int slot)
+    {
+        presetCache.invalidate(static_cast<std::uint8_t>(slot));
+
+        if (name.isEmpty() == true)
         {
             setWindowTitle(QString(tr("PLUG: NONE")));
             setAccessibleName(QString(tr("Main window: NONE")));
@@ -434,50 +453,64 @@ namespace plug
             return;
         }
 
-        QSettings settings;
-        try
-        {
-            const auto signalChain = amp_ops->load_memory_bank(static_cast<std::uint8_t>(slot));
-            const QString bankName = QString::fromStdString(signalChain.name());
+        // pending changes are outdated by the loaded preset
+        flushTimer->stop();
+        pendingSettings->discard();
 
+        // cached banks are shown instantly, the amp only has to switch to the bank
+        if (const auto signalChain = presetCache.get(static_cast<std::uint8_t>(slot)); signalChain.has_value())
+        {
+            worker->selectMemoryBank(static_cast<std::uint8_t>(slot));
+            memoryBankLoaded(slot, *signalChain);
+        }
+        else
+        {
+            worker->loadFromAmp(static_cast<std::uint8_t>(slot));
+        }
+    }
 
-            if (bankName.isEmpty())
-            {
-                setWindowTitle(QString(tr("PLUG: NONE")));
-                setAccessibleName(QString(tr("Main window: NONE")));
-            }
-            else
-            {
-                setWindowTitle(QString(tr("PLUG: %1")).arg(bankName));
-                setAccessibleName(QString(tr("Main window: %1")).arg(bankName));
-            }
+    void MainWindow::memoryBankLoaded(int slot, const plug::SignalChain& signalChain)
+    {
+        presetCache.put(static_cast<std::uint8_t>(slot), signalChain);
 
-            current_name = bankName;
+        QSettings settings;
+        const QString bankName = QString::fromStdString(signalChain.name());
 
-            amp->load(signalChain.amp());
-            if (settings.value("Settings/popupChangedWindows").toBool())
-            {
-                amp->show();
-            }
+        if (bankName.isEmpty())
+        {
+            setWindowTitle(QString(tr("PLUG: NONE")));
+            setAccessibleName(QString(tr("Main window: NONE")));
+        }
+        else
+        {
+            setWindowTitle(QString(tr("PLUG: %1")).arg(bankName));
+            setAccessibleName(QString(tr("Main window: %1")).arg(bankName));
+        }
 
-            const auto effects_set = signalChain.effects();
-            const bool shouldPopup = settings.value("Settings/popupChangedWindows").toBool();
-            std::for_each(effects_set.cbegin(), effects_set.cend(), [this, shouldPopup](const auto& effect)
-                          {
-                const auto component = effectComponents.at(effect.slot.id());
+        current_name = bankName;
 
-                component->load(effect);
-                if ((effect.effect_num != effects::EMPTY) && shouldPopup)
-                {
-                    component->show();
-                } });
-        }
-        catch (const std::exception& ex)
+        amp->load(signalChain.amp());
+        if (settings.value("Settings/popupChangedWindows").toBool())
         {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
+            amp->show();
         }
+
+        const auto effects_set = signalChain.effects();
+        const bool shouldPopup = settings.value("Settings/popupChangedWindows").toBool();
+        std::for_each(effects_set.cbegin(), effects_set.cend(), [this, shouldPopup](const auto& effect)
+                      {
+            const auto component = effectComponents.at(effect.slot.id());
+
+            component->load(effect);
+            if ((effect.effect_num != effects::EMPTY) && shouldPopup)
+            {
+                component->show();
+            } });
+    }
+
+    void MainWindow::showError(const QString& message)
+    {
+        ui->statusBar->showMessage(QString(tr("Error: %1")).arg(message), 5000);
     }
 
     // activate buttons
@@ -492,6 +525,8 @@ namespace plug
         ui->action_Load_from_amplifier->setDisabled(false);
         ui->actionSave_effects->setDisabled(false);
         ui->action_Library_view->setDisabled(false);
+        ui->action_Backup_amplifier->setDisabled(false);
+        ui->action_Restore_amplifier->setDisabled(false);
     }
 
     void MainWindow::change_name(int slot, QString* name)
@@ -539,16 +574,9 @@ namespace plug
             set_effect(effects[1]);
         }
 
-        try
-        {
-            amp_ops->save_effects(static_cast<std::uint8_t>(slot), name, effects);
-        }
-        catch (const std::exception& ex)
-        {
-            qWarning() << "ERROR: " << ex.what();
-            ui->statusBar->showMessage(QString(tr("Error: %1")).arg(ex.what()), 5000);
-            return;
-        }
+        flushSettings();
+        presetCache.clear();
+        worker->saveEffects(static_cast<std::uint8_t>(slot), name, effects);
     }
 
     void MainWindow::loadfile(QString filename)
@@ -557,7 +585,7 @@ namespace plug
 
         if (filename.isEmpty())
         {
-            filename = QFileDialog::getOpenFileName(this, tr("Open..."), settings.value("LoadFile/lastDirectory", QDir::homePath()).toString(), tr("FUSE files (*.fuse *.xml)"));
+            filename = QFileDialog::getOpenFileName(this, tr("Open..."), settings.value("LoadFile/lastDirectory", QDir::homePath()).toString(), tr("FUSE files (*.fuse *.xml);;Preset banks (*.plugbank)"));
         }
 
         if (filename.isEmpty())
@@ -566,6 +594,13 @@ namespace plug
         }
 
         settings.setValue("LoadFile/lastDirectory", QFileInfo(filename).absolutePath());
+
+        if (QFileInfo(filename).suffix() == "plugbank")
+        {
+            loadFromBank(filename);
+            return;
+        }
+
         QFile file{filename, this};
 
         if (file.exists())
@@ -586,9 +621,50 @@ namespace plug
         const auto fileSettings = loader.loadfile();
         file.close();
 
-        change_title(fileSettings.name);
+        loadSignalChain(SignalChain{fileSettings.name.toStdString(), fileSettings.amp, fileSettings.effects});
+    }
+
+    void MainWindow::loadFromBank(const QString& filename)
+    {
+        try
+        {
+            // Only the names are read for the selection, just the chosen preset is decoded
+            const com::PresetBank bank{filename.toStdString()};
+            QStringList names;
+
+            for (std::size_t i = 0; i < bank.size(); ++i)
+            {
+                names << QString("[%1] %2").arg(i + 1).arg(QString::fromStdString(bank.name(i)));
+            }
+
+            if (names.isEmpty())
+            {
+                QMessageBox::critical(this, tr("Error!"), tr("The preset bank is empty"));
+                return;
+            }
+
+            bool selected{true};
+            const QString name = (names.size() == 1) ? names.front() : QInputDialog::getItem(this, tr("Load from bank"), tr("Preset:"), names, 0, false, &selected);
 
-        amp->load(fileSettings.amp);
+            if (selected)
+            {
+                loadSignalChain(bank.at(static_cast<std::size_t>(names.indexOf(name))));
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            QMessageBox::critical(this, tr("Error!"), tr("Could not load preset bank: %1").arg(ex.what()));
+        }
+    }
+
+    void MainWindow::loadSignalChain(const SignalChain& signalChain)
+    {
+        QSettings settings;
+        const auto fxSettings = signalChain.effects();
+
+        change_title(QString::fromStdString(signalChain.name()));
+
+        amp->load(signalChain.amp());
         if (connected)
         {
             amp->send_amp();
@@ -601,7 +677,7 @@ namespace plug
             amp->show();
         }
 
-        std::for_each(fileSettings.effects.cbegin(), fileSettings.effects.cend(), [this, shouldPopup](auto& effect)
+        std::for_each(fxSettings.cbegin(), fxSettings.cend(), [this, shouldPopup](auto& effect)
                       {
             const auto& component = effectComponents.at(effect.slot.id());
             component->load(effect);
@@ -688,7 +764,7 @@ namespace plug
     void MainWindow::update_firmware()
     {
         QString filename;
-        QMessageBox::information(this, "Prepare", R"(Please power off the amplifier, then power it back on while holding down:<ul><li>The "Save" button (Mustang I and II)</li><li>The Data Wheel (Mustang III, IV and IV)</li></ul>After pressing "OK" choose firmware file and then update will begin.It will take about one minute. You will be notified when it's finished.)");
+        QMessageBox::information(this, "Prepare", R"(Please power off the amplifier, then power it back on while holding down:<ul><li>The "Save" button (Mustang I and II)</li><li>The Data Wheel (Mustang III, IV and IV)</li></ul>After pressing "OK" choose firmware file and then update will begin. You will be notified when it's finished.)");
 
         filename = QFileDialog::getOpenFileName(this, tr("Open..."), QDir::homePath(), tr("Mustang firmware (*.upd)"));
         if (filename.isEmpty())
@@ -704,22 +780,104 @@ namespace plug
         ui->statusBar->showMessage("Updating firmware. Please wait...");
         ui->centralWidget->setDisabled(true);
         ui->menuBar->setDisabled(true);
-        this->repaint();
-        const int ret = com::updateFirmware(filename.toLatin1().constData());
-        ui->centralWidget->setDisabled(false);
-        ui->menuBar->setDisabled(false);
-        ui->statusBar->showMessage("", 1);
-        if (ret == -100)
+
+        // The firmware is streamed by the worker, the dialog follows its progress and cancels the update
+        auto* progress = new QProgressDialog{tr("Updating firmware..."), tr("Cancel"), 0, 0, this};
+        progress->setWindowModality(Qt::WindowModal);
+        progress->setMinimumDuration(0);
+        progress->setAutoClose(false);
+        progress->setAutoReset(false);
+
+        connect(progress, &QProgressDialog::canceled, worker, &AmpWorker::cancelFirmwareUpdate);
+        connect(worker, &AmpWorker::firmwareProgress, progress, [progress](int sent, int total)
+                {
+            progress->setMaximum(total);
+            progress->setValue(sent); });
+        connect(
+            worker, &AmpWorker::firmwareUpdateFinished, this, [this, progress](bool completed)
+            {
+            progress->deleteLater();
+            ui->centralWidget->setDisabled(false);
+            ui->menuBar->setDisabled(false);
+            ui->statusBar->showMessage("", 1);
+
+            if (completed)
+            {
+                QMessageBox::information(this, "Update finished", R"(<b>Update finished</b><br>If "Exit" button is lit - update was succesful<br>If "Save" button is lit - update failed<br><br>Power off the amplifier and then back on to finish the process.)");
+            } },
+            Qt::SingleShotConnection);
+
+        worker->updateFirmware(filename.toStdString());
+    }
+
+    void MainWindow::backup_amp()
+    {
+        QString filename = QFileDialog::getSaveFileName(this, tr("Backup..."), QDir::homePath(), tr("Amplifier backups (*.plugbackup)"));
+
+        if (filename.isEmpty())
+        {
+            return;
+        }
+
+        if (QFileInfo(filename).suffix().isEmpty())
+        {
+            filename.append(".plugbackup");
+        }
+
+        ui->statusBar->showMessage(tr("Backing up amplifier. Please wait..."));
+        ui->centralWidget->setDisabled(true);
+        ui->menuBar->setDisabled(true);
+
+        connect(
+            worker, &AmpWorker::backupFinished, this, [this](bool completed)
+            {
+            ui->centralWidget->setDisabled(false);
+            ui->menuBar->setDisabled(false);
+            ui->statusBar->showMessage(completed ? tr("Backup finished") : "", 5000); },
+            Qt::SingleShotConnection);
+
+        worker->backupAmp(filename.toStdString());
+    }
+
+    void MainWindow::restore_amp()
+    {
+        const QString filename = QFileDialog::getOpenFileName(this, tr("Restore..."), QDir::homePath(), tr("Amplifier backups (*.plugbackup)"));
+
+        if (filename.isEmpty())
         {
-            ui->statusBar->showMessage(tr("Error: Suitable device not found!"), 5000);
             return;
         }
-        if (ret != 0)
+
+        if (QMessageBox::question(this, tr("Restore"), tr("All presets on the amplifier will be overwritten. Continue?")) != QMessageBox::Yes)
         {
-            ui->statusBar->showMessage(QString(tr("Communication error: %1")).arg(ret), 5000);
             return;
         }
-        QMessageBox::information(this, "Update finished", R"(<b>Update finished</b><br>If "Exit" button is lit - update was succesful<br>If "Save" button is lit - update failed<br><br>Power off the amplifier and then back on to finish the process.)");
+
+        ui->statusBar->showMessage(tr("Restoring amplifier. Please wait..."));
+        ui->centralWidget->setDisabled(true);
+        ui->menuBar->setDisabled(true);
+
+        connect(
+            worker, &AmpWorker::restoreFinished, this, [this](bool completed)
+            {
+            ui->centralWidget->setDisabled(false);
+            ui->menuBar->setDisabled(false);
+
+            if (!completed)
+            {
+                // The cause is reported through the failed signal; the connection is kept as it is
+                QMessageBox::critical(this, tr("Error!"), tr("Restoring the amplifier failed, its presets may be incomplete"));
+                return;
+            }
+
+            ui->statusBar->showMessage(tr("Restore finished"), 5000);
+
+            // Preset names and the current state are reloaded from the amp
+            stop_amp();
+            start_amp(); },
+            Qt::SingleShotConnection);
+
+        worker->restoreAmp(filename.toStdString());
     }
 
     void MainWindow::show_default_effects()
@@ -757,6 +915,41 @@ namespace plug
         }
     }
 
+    void MainWindow::scheduleSettingsFlush()
+    {
+        if (flushTimer->isActive())
+        {
+            return;
+        }
+
+        const auto delay = pendingSettings->timeUntilFlush(com::SettingsCoalescer::Clock::now());
+
+        if (delay == com::SettingsCoalescer::Clock::duration::zero())
+        {
+            flushSettings();
+        }
+        else
+        {
+            flushTimer->start(std::chrono::ceil<std::chrono::milliseconds>(delay));
+        }
+    }
+
+    void MainWindow::flushSettings()
+    {
+        flushTimer->stop();
+
+        if (!connected)
+        {
+            pendingSettings->discard();
+            return;
+        }
+
+        if (pendingSettings->hasPending())
+        {
+            worker->sendSettings(pendingSettings->take(com::SettingsCoalescer::Clock::now()));
+        }
+    }
+
 }
 
 #include "ui/moc_mainwindow.moc"
@@ -22,11 +22,30 @@
 #include "ui/savetofile.h"
 #include "ui/mainwindow.h"
 #include "ui_savetofile.h"
+#include "com/ModelRegistry.h"
+#include "com/PresetBank.h"
 #include <QFileDialog>
 #include <QMessageBox>
+#include <span>
+#include <sstream>
 
 namespace plug
 {
+    namespace
+    {
+        bool isPresetBank(const QString& filename)
+        {
+            return QFileInfo{filename}.suffix() == "plugbank";
+        }
+
+        void writeBank(QFile& file, const SignalChain& preset)
+        {
+            std::ostringstream out;
+            com::writePresetBank(out, std::span{&preset, 1});
+            const auto data = out.str();
+            file.write(data.data(), static_cast<qint64>(data.size()));
+        }
+    }
 
     SaveToFile::SaveToFile(QWidget* parent)
         : QDialog(parent),
@@ -42,12 +61,13 @@ namespace plug
 
     QString SaveToFile::choose_destination()
     {
-        QString filename = QFileDialog::getSaveFileName(this, tr("Save..."), QDir::homePath(), tr("FUSE files (*.fuse)"));
+        QString selectedFilter;
+        QString filename = QFileDialog::getSaveFileName(this, tr("Save..."), QDir::homePath(), tr("FUSE files (*.fuse);;Preset banks (*.plugbank)"), &selectedFilter);
 
         QFileInfo info(filename);
         if (info.suffix().isEmpty())
         {
-            filename.append(".fuse");
+            filename.append(selectedFilter.contains("plugbank") ? ".plugbank" : ".fuse");
         }
         emit destination_chosen(filename);
         return filename;
@@ -70,11 +90,20 @@ namespace plug
 
         dynamic_cast<MainWindow*>(parent())->change_title(ui->lineEdit_2->text());
 
-        xml = std::make_unique<QXmlStreamWriter>(file.get());
         amp_settings amplifier_settings{};
         std::vector<fx_pedal_settings> fx_settings{};
         dynamic_cast<MainWindow*>(parent())->get_settings(&amplifier_settings, fx_settings);
 
+        if (isPresetBank(file->fileName()))
+        {
+            writeBank(*file, SignalChain{ui->lineEdit_2->text().toStdString(), amplifier_settings, fx_settings});
+            file->close();
+            this->close();
+            return;
+        }
+
+        xml = std::make_unique<QXmlStreamWriter>(file.get());
+
         xml->setAutoFormatting(true);
         xml->writeStartDocument();
         xml->writeStartElement("Preset");
@@ -97,116 +126,11 @@ namespace plug
 
     void SaveToFile::writeAmp(amp_settings settings)
     {
-        int model{0};
-        int something{0};
-        int something2{0};
-        int something3{128};
-
-        switch (static_cast<amps>(settings.amp_num))
-        {
-            case amps::FENDER_57_DELUXE:
-                model = 0x67;
-                something = 0x01;
-                something2 = 0x53;
-                break;
-
-            case amps::FENDER_59_BASSMAN:
-                model = 0x64;
-                something = 0x02;
-                something2 = 0x67;
-                break;
-
-            case amps::FENDER_57_CHAMP:
-                model = 0x7c;
-                something = 0x0c;
-                something2 = 0x00;
-                break;
-
-            case amps::FENDER_65_DELUXE_REVERB:
-                model = 0x53;
-                something = 0x03;
-                something2 = 0x6a;
-                something3 = 0x00;
-                break;
-
-            case amps::FENDER_65_PRINCETON:
-                model = 0x6a;
-                something = 0x04;
-                something2 = 0x61;
-                break;
-
-            case amps::FENDER_65_TWIN_REVERB:
-                model = 0x75;
-                something = 0x05;
-                something2 = 0x72;
-                break;
-
-            case amps::FENDER_SUPER_SONIC:
-                model = 0x72;
-                something = 0x06;
-                something2 = 0x79;
-                break;
-
-            case amps::BRITISH_60S:
-                model = 0x61;
-                something = 0x07;
-                something2 = 0x5e;
-                break;
-
-            case amps::BRITISH_70S:
-                model = 0x79;
-                something = 0x0b;
-                something2 = 0x7c;
-                break;
-
-            case amps::BRITISH_80S:
-                model = 0x5e;
-                something = 0x09;
-                something2 = 0x5d;
-                break;
-
-            case amps::AMERICAN_90S:
-                model = 0x5d;
-                something = 0x0a;
-                something2 = 0x6d;
-                break;
-
-            case amps::METAL_2000:
-                model = 0x6d;
-                something = 0x08;
-                something2 = 0x75;
-                break;
-
-            case amps::STUDIO_PREAMP:
-                model = 0xf1;
-                something = 0x0d;
-                something2 = 0xf6;
-                break;
-
-            case amps::FENDER_57_TWIN:
-                model = 0xf6;
-                something = 0x0e;
-                something2 = 0xf9;
-                break;
-
-            case amps::FENDER_60_THRIFT:
-                model = 0xf9;
-                something = 0x0f;
-                something2 = 0xfc;
-                break;
-
-            case amps::BRITISH_COLOUR:
-                model = 0xfc;
-                something = 0x10;
-                something2 = 0xff;
-                break;
-
-            case amps::BRITISH_WATTS:
-                model = 0xff;
-                something = 0x11;
-                something2 = 0x00;
-                break;
-        }
+        const auto& amp = com::ampModel(settings.amp_num);
+        const int model{amp.id};
+        const int something{amp.unknownAmpSpecific[0]};
+        const int something2{amp.unknownAmpSpecific[4]};
+        const int something3{amp.unknown};
 
         xml->writeStartElement("Amplifier");
         xml->writeStartElement("Module");
@@ -377,186 +301,7 @@ namespace plug
 
     void SaveToFile::writeFX(fx_pedal_settings settings)
     {
-        int model{0};
-
-        switch (static_cast<effects>(settings.effect_num))
-        {
-            case effects::EMPTY:
-                model = 0x00;
-                break;
-
-            case effects::OVERDRIVE:
-                model = 0x3c;
-                break;
-
-            case effects::WAH:
-                model = 0x49;
-                break;
-
-            case effects::TOUCH_WAH:
-                model = 0x4a;
-                break;
-
-            case effects::FUZZ:
-                model = 0x1a;
-                break;
-
-            case effects::FUZZ_TOUCH_WAH:
-                model = 0x1c;
-                break;
-
-            case effects::SIMPLE_COMP:
-                model = 0x88;
-                break;
-
-            case effects::COMPRESSOR:
-                model = 0x07;
-                break;
-
-            case effects::SINE_CHORUS:
-                model = 0x12;
-                break;
-
-            case effects::TRIANGLE_CHORUS:
-                model = 0x13;
-                break;
-
-            case effects::SINE_FLANGER:
-                model = 0x18;
-                break;
-
-            case effects::TRIANGLE_FLANGER:
-                model = 0x19;
-                break;
-
-            case effects::VIBRATONE:
-                model = 0x2d;
-                break;
-
-            case effects::VINTAGE_TREMOLO:
-                model = 0x40;
-                break;
-
-            case effects::SINE_TREMOLO:
-                model = 0x41;
-                break;
-
-            case effects::RING_MODULATOR:
-                model = 0x22;
-                break;
-
-            case effects::STEP_FILTER:
-                model = 0x29;
-                break;
-
-            case effects::PHASER:
-                model = 0x4f;
-                break;
-
-            case effects::PITCH_SHIFTER:
-                model = 0x1f;
-                break;
-
-            case effects::MONO_DELAY:
-                model = 0x16;
-                break;
-
-            case effects::MONO_ECHO_FILTER:
-                model = 0x43;
-                break;
-
-            case effects::STEREO_ECHO_FILTER:
-                model = 0x48;
-                break;
-
-            case effects::MULTITAP_DELAY:
-                model = 0x44;
-                break;
-
-            case effects::PING_PONG_DELAY:
-                model = 0x45;
-                break;
-
-            case effects::DUCKING_DELAY:
-                model = 0x15;
-                break;
-
-            case effects::REVERSE_DELAY:
-                model = 0x46;
-                break;
-
-            case effects::TAPE_DELAY:
-                model = 0x2b;
-                break;
-
-            case effects::STEREO_TAPE_DELAY:
-                model = 0x2a;
-                break;
-
-            case effects::SMALL_HALL_REVERB:
-                model = 0x24;
-                break;
-
-            case effects::LARGE_HALL_REVERB:
-                model = 0x3a;
-                break;
-
-            case effects::SMALL_ROOM_REVERB:
-                model = 0x26;
-                break;
-
-            case effects::LARGE_ROOM_REVERB:
-                model = 0x3b;
-                break;
-
-            case effects::SMALL_PLATE_REVERB:
-                model = 0x4e;
-                break;
-
-            case effects::LARGE_PLATE_REVERB:
-                model = 0x4b;
-                break;
-
-            case effects::AMBIENT_REVERB:
-                model = 0x4c;
-                break;
-
-            case effects::ARENA_REVERB:
-                model = 0x4d;
-                break;
-
-            case effects::FENDER_63_SPRING_REVERB:
-                model = 0x21;
-                break;
-
-            case effects::FENDER_65_SPRING_REVERB:
-                model = 0x0b;
-                break;
-            case effects::RANGER_BOOST:
-                model = 0x103;
-                break;
-            case effects::GREENBOX:
-                model = 0xba;
-                break;
-            case effects::ORANGEBOX:
-                model = 0x110;
-                break;
-            case effects::BLACKBOX:
-                model = 0x111;
-                break;
-            case effects::BIG_FUZZ:
-                model = 0x10f;
-                break;
-            case effects::WAH_MOD:
-                model = 0xf4;
-                break;
-            case effects::TOUCH_WAH_MOD:
-                model = 0xf5;
-                break;
-            case effects::DIATONIC_PITCH_SHIFTER:
-                model = 0x11f;
-                break;
-        }
+        const int model{com::effectModel(settings.effect_num).fileId};
 
         xml->writeStartElement("Module");
         xml->writeAttribute("ID", QString("%1").arg(model));
@@ -0,0 +1,160 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/AmpBackup.h"
+#include "com/CommunicationException.h"
+#include "com/Mustang.h"
+#include "com/PacketSerializer.h"
+#include "com/SimulatorConnection.h"
+#include <sstream>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class AmpBackupTest : public testing::Test
+    {
+    protected:
+        PacketRawType packet(std::uint8_t value) const
+        {
+            PacketRawType data{};
+            data.fill(value);
+            return data;
+        }
+
+        const DeviceModel model{"Simulator", DeviceModel::Category::MustangV1, 24};
+        std::shared_ptr<SimulatorConnection> conn = std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0});
+        Mustang mustang{model, conn};
+    };
+
+
+    TEST_F(AmpBackupTest, readReturnsWrittenBackup)
+    {
+        const std::array<PacketRawType, 7> bank{packet(1), packet(2), packet(3), packet(4), packet(5), packet(6), packet(7)};
+        const std::vector knobPresets{packet(8), packet(9)};
+
+        std::stringstream stream;
+        writeBackupHeader(stream);
+        writeBackupKnobPresets(stream, knobPresets);
+        writeBackupBank(stream, bank);
+        writeBackupBank(stream, bank);
+
+        const auto backup = readBackup(stream);
+        EXPECT_THAT(backup.knobPresets, ContainerEq(knobPresets));
+        ASSERT_THAT(backup.banks, SizeIs(2));
+        EXPECT_THAT(backup.banks[1], ContainerEq(bank));
+    }
+
+    TEST_F(AmpBackupTest, readThrowsOnInvalidHeader)
+    {
+        std::stringstream stream{"PLUGREC\x01"};
+        EXPECT_THROW(readBackup(stream), CommunicationException);
+    }
+
+    TEST_F(AmpBackupTest, readThrowsOnTruncatedBank)
+    {
+        std::stringstream stream;
+        writeBackupHeader(stream);
+        stream << '\x01' << "abc";
+
+        EXPECT_THROW(readBackup(stream), CommunicationException);
+    }
+
+    TEST_F(AmpBackupTest, backupContainsAllBanksAndKnobPresets)
+    {
+        std::stringstream stream;
+        mustang.backupAll(stream);
+
+        const auto backup = readBackup(stream);
+        ASSERT_THAT(backup.banks, SizeIs(24));
+        EXPECT_THAT(decodeNameFromData(PacketView<NamePayload>{backup.banks[0][0]}), Eq("Preset 1"));
+        EXPECT_THAT(decodeNameFromData(PacketView<NamePayload>{backup.banks[23][0]}), Eq("Preset 24"));
+        EXPECT_THAT(backup.knobPresets, SizeIs(12 * 3 + 12 * 4));
+    }
+
+    TEST_F(AmpBackupTest, backupConsumesWholeTransmission)
+    {
+        std::stringstream stream;
+        mustang.backupAll(stream);
+
+        PacketRawType data{};
+        EXPECT_THAT(conn->receiveInto(data), Eq(0));
+    }
+
+    TEST_F(AmpBackupTest, backupRequestsBanksOfLargeAmpsInChunks)
+    {
+        const auto largeConn = std::make_shared<SimulatorConnection>(100, std::chrono::microseconds{0});
+        Mustang large{DeviceModel{"Simulator", DeviceModel::Category::MustangV2, 100}, largeConn};
+
+        std::stringstream stream;
+        large.backupAll(stream);
+
+        const auto backup = readBackup(stream);
+        ASSERT_THAT(backup.banks, SizeIs(100));
+        EXPECT_THAT(decodeNameFromData(PacketView<NamePayload>{backup.banks[99][0]}), Eq("Preset 100"));
+    }
+
+    TEST_F(AmpBackupTest, backupSelectsPreviousPresetAgain)
+    {
+        mustang.start_amp();
+        mustang.load_memory_bank(5);
+
+        std::stringstream stream;
+        mustang.backupAll(stream);
+
+        EXPECT_THAT(mustang.start_amp().signalChain.name(), Eq("Preset 6"));
+    }
+
+    TEST_F(AmpBackupTest, restoreWritesBackupToAmp)
+    {
+        std::stringstream original;
+        mustang.backupAll(original);
+
+        // Another amp with changed presets and knob presets
+        const auto otherConn = std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0});
+        Mustang other{model, otherConn};
+        amp_settings amp{};
+        amp.amp_num = amps::BRITISH_80S;
+        other.set_amplifier(amp);
+        other.set_effect(fx_pedal_settings{FxSlot{1}, effects::SINE_FLANGER, 1, 2, 3, 0, 0, 0, true});
+        other.save_on_amp("changed", 4);
+        other.save_effects(3, "changed", {fx_pedal_settings{FxSlot{1}, effects::VIBRATONE, 1, 2, 3, 4, 5, 6, true}});
+
+        other.restoreAll(readBackup(original));
+
+        std::stringstream restored;
+        other.backupAll(restored);
+        original.clear();
+        original.seekg(0);
+        EXPECT_THAT(restored.str(), Eq(original.str()));
+    }
+
+    TEST_F(AmpBackupTest, restoreFailsIfSlotIsNotStored)
+    {
+        std::stringstream stream;
+        mustang.backupAll(stream);
+        auto backup = readBackup(stream);
+        backup.banks.resize(25, backup.banks.front());
+
+        EXPECT_THROW(mustang.restoreAll(backup), CommunicationException);
+    }
+}
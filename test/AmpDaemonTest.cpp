@@ -0,0 +1,136 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/AmpDaemon.h"
+#include "daemon/DaemonClient.h"
+#include "com/CommunicationException.h"
+#include "com/SimulatorConnection.h"
+#include <thread>
+#include <unistd.h>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::daemon;
+    using namespace plug::com;
+    using namespace testing;
+
+    class AmpDaemonTest : public testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            daemon.stop();
+        }
+
+        const std::filesystem::path socketPath{std::filesystem::temp_directory_path() / ("plug-test-" + std::to_string(::getpid()) + ".sock")};
+        std::shared_ptr<SimulatorConnection> conn = std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0});
+        Mustang mustang{DeviceModel{"Simulator", DeviceModel::Category::MustangV1, 24}, conn};
+        AmpDaemon daemon{mustang, socketPath};
+        std::jthread server{[this]
+                            { daemon.run(); }};
+    };
+
+
+    TEST_F(AmpDaemonTest, stateReturnsStartedAmpState)
+    {
+        DaemonClient client{socketPath};
+        const auto [signalChain, presetNames] = client.state();
+
+        EXPECT_THAT(signalChain.name(), Eq("Preset 1"));
+        EXPECT_THAT(presetNames, SizeIs(24));
+        EXPECT_THAT(presetNames[23], Eq("Preset 24"));
+    }
+
+    TEST_F(AmpDaemonTest, loadPresetIsSharedWithOtherClients)
+    {
+        DaemonClient client0{socketPath};
+        DaemonClient client1{socketPath};
+
+        const auto preset = client0.loadPreset(3);
+
+        EXPECT_THAT(preset.name(), Eq("Preset 4"));
+        EXPECT_THAT(preset.amp().amp_num, Eq(amps::FENDER_65_DELUXE_REVERB));
+        EXPECT_THAT(client1.state().signalChain.name(), Eq("Preset 4"));
+    }
+
+    TEST_F(AmpDaemonTest, settingsAreAppliedOnAmp)
+    {
+        amp_settings amp{};
+        amp.amp_num = amps::BRITISH_80S;
+        amp.volume = 0x12;
+        const fx_pedal_settings effect{FxSlot{1}, effects::SINE_FLANGER, 1, 2, 3, 0, 0, 0, true};
+        DaemonClient client{socketPath};
+
+        client.setAmp(amp);
+        client.setEffect(effect);
+        client.savePreset(7, "saved");
+        client.loadPreset(0);
+        const auto preset = client.loadPreset(7);
+
+        EXPECT_THAT(preset.name(), Eq("saved"));
+        EXPECT_THAT(preset.amp().amp_num, Eq(amps::BRITISH_80S));
+        EXPECT_THAT(preset.amp().volume, Eq(0x12));
+        EXPECT_THAT(preset.effects()[1].effect_num, Eq(effects::SINE_FLANGER));
+        EXPECT_THAT(client.state().presetNames[7], Eq("saved"));
+    }
+
+    TEST_F(AmpDaemonTest, errorsAreReportedToClient)
+    {
+        DaemonClient client{socketPath};
+
+        EXPECT_THROW(client.loadPreset(24), CommunicationException);
+        EXPECT_THROW(client.savePreset(30, "invalid"), CommunicationException);
+        EXPECT_THAT(client.state().presetNames, SizeIs(24));
+    }
+
+    TEST_F(AmpDaemonTest, invalidAmpAndEffectIdsAreRejected)
+    {
+        amp_settings amp{};
+        amp.amp_num = static_cast<amps>(0xff);
+        const fx_pedal_settings effect{FxSlot{1}, static_cast<effects>(0xff), 0, 0, 0, 0, 0, 0, true};
+        DaemonClient client{socketPath};
+        const auto before = client.state().signalChain;
+
+        EXPECT_THROW(client.setAmp(amp), CommunicationException);
+        EXPECT_THROW(client.setEffect(effect), CommunicationException);
+
+        const auto after = client.state().signalChain;
+        EXPECT_THAT(after.amp().amp_num, Eq(before.amp().amp_num));
+        EXPECT_THAT(after.effects().size(), Eq(before.effects().size()));
+    }
+
+    TEST_F(AmpDaemonTest, closedClientsAreRemoved)
+    {
+        {
+            DaemonClient client{socketPath};
+            client.state();
+        }
+
+        DaemonClient client{socketPath};
+        EXPECT_THAT(client.loadPreset(1).name(), Eq("Preset 2"));
+    }
+
+    TEST_F(AmpDaemonTest, secondDaemonOnSameSocketThrows)
+    {
+        Mustang other{DeviceModel{"Simulator", DeviceModel::Category::MustangV1, 24}, std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0})};
+        EXPECT_THROW((AmpDaemon{other, socketPath}), std::runtime_error);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/AmpSession.h"
+#include "com/CommunicationException.h"
+#include "com/SimulatorConnection.h"
+#include "mocks/MockConnection.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class AmpSessionTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::vector<std::unique_ptr<Mustang>> amps;
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                amps.push_back(std::make_unique<Mustang>(model, std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0})));
+            }
+            sessions = openSessions(std::move(amps));
+        }
+
+        static SignalChain preset()
+        {
+            amp_settings amp{};
+            amp.amp_num = amps::BRITISH_80S;
+            amp.volume = 0x12;
+            return SignalChain{"broadcast", amp, {fx_pedal_settings{FxSlot{1}, effects::SINE_FLANGER, 1, 2, 3, 0, 0, 0, true}}};
+        }
+
+        static SignalChain saveAndReload(Mustang& mustang)
+        {
+            mustang.save_on_amp("saved", 7);
+            mustang.load_memory_bank(0);
+            return mustang.load_memory_bank(7);
+        }
+
+        const DeviceModel model{"Simulator", DeviceModel::Category::MustangV1, 24};
+        std::vector<std::unique_ptr<AmpSession>> sessions;
+    };
+
+
+    TEST_F(AmpSessionTest, sessionsAreIndependent)
+    {
+        auto state0 = sessions[0]->start();
+        auto state1 = sessions[1]->load(5);
+
+        EXPECT_THAT(state0.get().signalChain.name(), Eq("Preset 1"));
+        EXPECT_THAT(state1.get().name(), Eq("Preset 6"));
+        EXPECT_THAT(sessions[2]->getDeviceModel().name(), Eq("Simulator"));
+    }
+
+    TEST_F(AmpSessionTest, submitRunsOnSessionThread)
+    {
+        const auto callerThread = std::this_thread::get_id();
+
+        auto thread = sessions[0]->submit([](Mustang&)
+                                                { return std::this_thread::get_id(); });
+
+        EXPECT_THAT(thread.get(), Ne(callerThread));
+    }
+
+    TEST_F(AmpSessionTest, failuresAreDeliveredThroughFuture)
+    {
+        auto result = sessions[0]->submit([](Mustang&) -> int
+                                          { throw CommunicationException{"failed"}; });
+
+        EXPECT_THROW(result.get(), CommunicationException);
+        EXPECT_THAT(sessions[0]->load(1).get().name(), Eq("Preset 2"));
+    }
+
+    TEST_F(AmpSessionTest, broadcastAppliesToAllAmps)
+    {
+        broadcast(sessions, preset());
+
+        for (const auto& session : sessions)
+        {
+            const auto result = session->submit(saveAndReload).get();
+
+            EXPECT_THAT(result.amp().amp_num, Eq(amps::BRITISH_80S));
+            EXPECT_THAT(result.amp().volume, Eq(0x12));
+            EXPECT_THAT(result.effects()[1].effect_num, Eq(effects::SINE_FLANGER));
+        }
+    }
+
+    TEST_F(AmpSessionTest, broadcastRethrowsFailureAfterAllAmps)
+    {
+        auto failing = std::make_shared<NiceMock<mock::MockConnection>>();
+        EXPECT_CALL(*failing, sendImpl(_, _)).WillRepeatedly(Throw(CommunicationException{"failed"}));
+        sessions.insert(sessions.begin(), std::make_unique<AmpSession>(std::make_unique<Mustang>(model, failing)));
+
+        EXPECT_THROW(broadcast(sessions, preset()), CommunicationException);
+
+        const auto result = sessions[3]->submit(saveAndReload).get();
+        EXPECT_THAT(result.amp().amp_num, Eq(amps::BRITISH_80S));
+    }
+}
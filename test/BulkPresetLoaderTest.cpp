@@ -0,0 +1,114 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/BulkPresetLoader.h"
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class BulkPresetLoaderTest : public testing::Test
+    {
+    protected:
+        std::vector<std::filesystem::path> createFiles(std::size_t count) const
+        {
+            std::vector<std::filesystem::path> files;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                files.emplace_back("preset-" + std::to_string(i) + ".fuse");
+            }
+            return files;
+        }
+
+        static SignalChain loadByName(const std::filesystem::path& file)
+        {
+            return SignalChain{file.stem().string(), amp_settings{}, {}};
+        }
+    };
+
+
+    TEST_F(BulkPresetLoaderTest, loadsNothingIfNoFiles)
+    {
+        EXPECT_THAT(loadPresets({}, loadByName, 4).empty(), IsTrue());
+    }
+
+    TEST_F(BulkPresetLoaderTest, resultsAreInOrderOfFiles)
+    {
+        const auto files = createFiles(1000);
+        const auto results = loadPresets(files, loadByName, 4);
+
+        ASSERT_THAT(results.size(), Eq(files.size()));
+
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            EXPECT_THAT(results[i].path, Eq(files[i]));
+            ASSERT_THAT(results[i].signalChain.has_value(), IsTrue());
+            EXPECT_THAT(results[i].signalChain->name(), Eq("preset-" + std::to_string(i)));
+        }
+    }
+
+    TEST_F(BulkPresetLoaderTest, reportsErrorsPerFile)
+    {
+        const auto files = createFiles(3);
+        const auto results = loadPresets(files, [](const auto& file)
+                                         {
+                                             if (file.stem() == "preset-1")
+                                             {
+                                                 throw std::runtime_error{"Invalid preset"};
+                                             }
+                                             return loadByName(file); },
+                                         2);
+
+        EXPECT_THAT(results[0].signalChain.has_value(), IsTrue());
+        EXPECT_THAT(results[0].error, IsEmpty());
+        EXPECT_THAT(results[1].signalChain.has_value(), IsFalse());
+        EXPECT_THAT(results[1].error, Eq("Invalid preset"));
+        EXPECT_THAT(results[2].signalChain.has_value(), IsTrue());
+    }
+
+    TEST_F(BulkPresetLoaderTest, loadsEachFileOnce)
+    {
+        const auto files = createFiles(500);
+        std::mutex mutex;
+        std::multiset<std::filesystem::path> loaded;
+
+        loadPresets(files, [&mutex, &loaded](const auto& file)
+                    {
+                        const std::lock_guard lock{mutex};
+                        loaded.insert(file);
+                        return loadByName(file); },
+                    8);
+
+        EXPECT_THAT(loaded.size(), Eq(files.size()));
+        EXPECT_THAT(std::set(loaded.cbegin(), loaded.cend()).size(), Eq(files.size()));
+    }
+
+    TEST_F(BulkPresetLoaderTest, moreThreadsThanFiles)
+    {
+        const auto results = loadPresets(createFiles(2), loadByName, 16);
+        EXPECT_THAT(results.size(), Eq(2));
+    }
+}
@@ -0,0 +1,198 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cli/CommandInterpreter.h"
+#include "com/Mustang.h"
+#include "com/PresetBank.h"
+#include "com/SimulatorConnection.h"
+#include "daemon/AmpDaemon.h"
+#include "daemon/DaemonClient.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::cli;
+    using namespace plug::com;
+    using namespace testing;
+
+    class CommandInterpreterTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            interpreter.start();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(file);
+        }
+
+        static SignalChain loadPreset(const std::filesystem::path& path)
+        {
+            amp_settings amp{};
+            amp.amp_num = amps::BRITISH_60S;
+            amp.gain = 0x42;
+            return SignalChain{path.stem().string(), amp, {fx_pedal_settings{FxSlot{2}, effects::TAPE_DELAY, 1, 2, 3, 4, 5, 0, true}}};
+        }
+
+        const std::filesystem::path file{std::filesystem::temp_directory_path() / "plug-cli-test.bin"};
+        std::shared_ptr<SimulatorConnection> conn = std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0});
+        Mustang mustang{DeviceModel{"Simulator", DeviceModel::Category::MustangV1, 24}, conn};
+        MustangControl control{mustang};
+        std::ostringstream out;
+        CommandInterpreter interpreter{control, loadPreset, out};
+    };
+
+
+    TEST(CommandTest, splitCommandSplitsAtWhitespace)
+    {
+        EXPECT_THAT(splitCommand("  set-amp gain=3\tvolume=4 "), ElementsAre("set-amp", "gain=3", "volume=4"));
+        EXPECT_THAT(splitCommand(""), IsEmpty());
+    }
+
+    TEST_F(CommandInterpreterTest, loadPrintsPresetName)
+    {
+        interpreter.execute({"load", "3"});
+
+        EXPECT_THAT(out.str(), Eq("Preset 4\n"));
+    }
+
+    TEST_F(CommandInterpreterTest, loadThrowsOnInvalidSlot)
+    {
+        EXPECT_THROW(interpreter.execute({"load", "24"}), std::invalid_argument);
+        EXPECT_THROW(interpreter.execute({"load", "x"}), std::invalid_argument);
+        EXPECT_THROW(interpreter.execute({"load"}), std::invalid_argument);
+    }
+
+    TEST_F(CommandInterpreterTest, dumpPrintsStateAndPresets)
+    {
+        interpreter.execute({"dump"});
+
+        EXPECT_THAT(out.str(), StartsWith("name: Preset 1\namp: model="));
+        EXPECT_THAT(out.str(), HasSubstr("\npreset 23: Preset 24\n"));
+    }
+
+    TEST_F(CommandInterpreterTest, setAmpChangesOnlyGivenSettings)
+    {
+        const auto before = mustang.load_memory_bank(0).amp();
+        interpreter.execute({"set-amp", "model=3", "volume=18"});
+        mustang.save_on_amp("saved", 5);
+
+        const auto amp = mustang.load_memory_bank(5).amp();
+        EXPECT_THAT(amp.amp_num, Eq(amps::FENDER_65_DELUXE_REVERB));
+        EXPECT_THAT(amp.volume, Eq(18));
+        EXPECT_THAT(amp.gain, Eq(before.gain));
+    }
+
+    TEST_F(CommandInterpreterTest, setAmpThrowsOnInvalidSetting)
+    {
+        EXPECT_THROW(interpreter.execute({"set-amp", "unknown=1"}), std::invalid_argument);
+        EXPECT_THROW(interpreter.execute({"set-amp", "gain"}), std::invalid_argument);
+        EXPECT_THROW(interpreter.execute({"set-amp", "gain=256"}), std::invalid_argument);
+    }
+
+    TEST_F(CommandInterpreterTest, setFxSetsEffectOfSlot)
+    {
+        interpreter.execute({"set-fx", "1", std::to_string(static_cast<int>(effects::SINE_FLANGER)), "1", "2", "3"});
+        mustang.save_on_amp("saved", 5);
+
+        const auto bank = mustang.load_memory_bank(5);
+        EXPECT_THAT(bank.effects()[1].effect_num, Eq(effects::SINE_FLANGER));
+        EXPECT_THAT(bank.effects()[1].knob3, Eq(3));
+    }
+
+    TEST_F(CommandInterpreterTest, applyUsesLoader)
+    {
+        interpreter.execute({"apply", "/presets/lead.fuse"});
+        mustang.save_on_amp("saved", 5);
+
+        EXPECT_THAT(out.str(), Eq("lead\n"));
+        EXPECT_THAT(mustang.load_memory_bank(5).amp().gain, Eq(0x42));
+    }
+
+    TEST_F(CommandInterpreterTest, applyPresetFromBank)
+    {
+        const std::filesystem::path bankFile{std::filesystem::temp_directory_path() / "plug-cli-test.plugbank"};
+        {
+            const std::vector presets{loadPreset("first"), loadPreset("second")};
+            std::ofstream stream{bankFile, std::ios::binary};
+            writePresetBank(stream, presets);
+        }
+
+        interpreter.execute({"apply", bankFile.string(), "1"});
+        std::filesystem::remove(bankFile);
+
+        EXPECT_THAT(out.str(), Eq("second\n"));
+    }
+
+    TEST_F(CommandInterpreterTest, unknownCommandThrows)
+    {
+        EXPECT_THROW(interpreter.execute({"unknown"}), std::invalid_argument);
+    }
+
+    TEST_F(CommandInterpreterTest, batchContinuesAfterErrors)
+    {
+        std::istringstream in{"# comment\n\nload 1\nunknown\nload 2\n"};
+        std::ostringstream err;
+
+        EXPECT_THAT(interpreter.runBatch(in, err), Eq(1));
+        EXPECT_THAT(out.str(), Eq("Preset 2\nPreset 3\n"));
+        EXPECT_THAT(err.str(), StartsWith("error: Unknown command: unknown"));
+    }
+
+    TEST_F(CommandInterpreterTest, backupAndRestore)
+    {
+        interpreter.execute({"backup", file.string()});
+        mustang.save_on_amp("changed", 0);
+        interpreter.execute({"restore", file.string()});
+        out.str("");
+        interpreter.execute({"load", "0"});
+
+        EXPECT_THAT(out.str(), Eq("Preset 1\n"));
+    }
+
+    TEST_F(CommandInterpreterTest, commandsAreSentThroughDaemon)
+    {
+        const std::filesystem::path socketPath{std::filesystem::temp_directory_path() / ("plug-cli-test-" + std::to_string(::getpid()) + ".sock")};
+        daemon::AmpDaemon ampDaemon{mustang, socketPath};
+        std::jthread server{[&ampDaemon]
+                            { ampDaemon.run(); }};
+        daemon::DaemonClient client{socketPath};
+        DaemonControl daemonAmp{client};
+        CommandInterpreter daemonInterpreter{daemonAmp, loadPreset, out};
+        daemonInterpreter.start();
+
+        daemonInterpreter.execute({"load", "3"});
+        daemonInterpreter.execute({"set-amp", "volume=18"});
+        EXPECT_THROW(daemonInterpreter.execute({"backup", file.string()}), std::runtime_error);
+        ampDaemon.stop();
+        server.join();
+
+        mustang.save_on_amp("saved", 5);
+        EXPECT_THAT(out.str(), Eq("Preset 4\n"));
+        EXPECT_THAT(mustang.load_memory_bank(5).amp().volume, Eq(18));
+    }
+}
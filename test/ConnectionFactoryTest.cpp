@@ -21,9 +21,11 @@
 #include "com/ConnectionFactory.h"
 #include "com/CommunicationException.h"
 #include "com/Mustang.h"
+#include "com/UsbException.h"
 #include "mocks/UsbDeviceMock.h"
 #include <gmock/gmock-spec-builders.h>
 #include <gmock/gmock.h>
+#include <libusb-1.0/libusb.h>
 #include <memory>
 
 namespace plug::test
@@ -78,4 +80,143 @@ namespace plug::test
         EXPECT_THAT(device, NotNull());
     }
 
+    TEST_F(ConnectionFactoryTest, connectReportsDeviceInUse)
+    {
+        std::vector<usb::Device> devices{};
+        devices.emplace_back(nullptr);
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::move(devices))));
+        EXPECT_CALL(*deviceMock, vendorId()).WillOnce(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0005));
+        EXPECT_CALL(*deviceMock, open()).WillOnce(Throw(usb::UsbException{LIBUSB_ERROR_BUSY}));
+
+        EXPECT_THROW(connect(), CommunicationException);
+    }
+
+    TEST_F(ConnectionFactoryTest, connectPassesOtherUsbErrors)
+    {
+        std::vector<usb::Device> devices{};
+        devices.emplace_back(nullptr);
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::move(devices))));
+        EXPECT_CALL(*deviceMock, vendorId()).WillOnce(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0005));
+        EXPECT_CALL(*deviceMock, open()).WillOnce(Throw(usb::UsbException{LIBUSB_ERROR_ACCESS}));
+
+        EXPECT_THROW(connect(), usb::UsbException);
+    }
+
+    TEST_F(ConnectionFactoryTest, connectAllThrowsIfNoDeviceFound)
+    {
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::vector<usb::Device>{})));
+
+        EXPECT_THROW(connectAll(), CommunicationException);
+    }
+
+    TEST_F(ConnectionFactoryTest, connectAllReturnsAllAmps)
+    {
+        std::vector<usb::Device> devices{};
+        devices.emplace_back(nullptr);
+        devices.emplace_back(nullptr);
+        devices.emplace_back(nullptr);
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::move(devices))));
+        EXPECT_CALL(*deviceMock, open()).Times(2);
+        EXPECT_CALL(*deviceMock, startReceiving(_, _)).Times(2);
+        EXPECT_CALL(*deviceMock, name()).Times(2);
+        EXPECT_CALL(*deviceMock, vendorId())
+            .WillOnce(Return(0x1ed8))
+            .WillOnce(Return(0xf0f0))
+            .WillOnce(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0004));
+
+        const auto amps = connectAll();
+        EXPECT_THAT(amps, SizeIs(2));
+    }
+
+#ifdef PLUG_DIAGNOSTICS
+    TEST_F(ConnectionFactoryTest, connectSimulatorDoesNotUseUsb)
+    {
+        EXPECT_CALL(*contextMock, listDevices).Times(0);
+
+        auto device = connectSimulator(24, std::chrono::microseconds{0});
+        ASSERT_THAT(device, NotNull());
+        EXPECT_THAT(device->getDeviceModel().name(), Eq("Mustang Simulator"));
+        EXPECT_THAT(device->getDeviceModel().numberOfPresets(), Eq(24));
+    }
+#endif
+
+    TEST_F(ConnectionFactoryTest, ampWatcherScansBusWithoutHotplugSupport)
+    {
+        EXPECT_CALL(*contextMock, hasHotplugSupport()).WillOnce(Return(false));
+        EXPECT_CALL(*contextMock, registerHotplug(_, _)).Times(0);
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::vector<usb::Device>{})));
+
+        AmpWatcher watcher{nullptr};
+        EXPECT_FALSE(watcher.isWatching());
+        EXPECT_THROW(watcher.connect(), CommunicationException);
+    }
+
+    TEST_F(ConnectionFactoryTest, ampWatcherConnectsArrivedAmpWithoutScanning)
+    {
+        usb::Hotplug::Callback hotplug;
+        std::vector<bool> notifications;
+        EXPECT_CALL(*contextMock, hasHotplugSupport()).WillOnce(Return(true));
+        EXPECT_CALL(*contextMock, registerHotplug(0x1ed8, _)).WillOnce(SaveArg<1>(&hotplug));
+        EXPECT_CALL(*contextMock, deregisterHotplug());
+        EXPECT_CALL(*contextMock, listDevices).Times(0);
+        EXPECT_CALL(*deviceMock, vendorId()).WillRepeatedly(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0005));
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(_, _));
+        EXPECT_CALL(*deviceMock, name());
+
+        AmpWatcher watcher{[&notifications](bool available)
+                           { notifications.push_back(available); }};
+        EXPECT_FALSE(watcher.isAvailable());
+
+        hotplug(usb::HotplugEvent::Arrived, usb::Device{nullptr});
+
+        EXPECT_TRUE(watcher.isAvailable());
+        EXPECT_THAT(watcher.connect(), NotNull());
+        EXPECT_THAT(notifications, ElementsAre(true));
+    }
+
+    TEST_F(ConnectionFactoryTest, ampWatcherIgnoresOtherDevices)
+    {
+        usb::Hotplug::Callback hotplug;
+        bool notified{false};
+        EXPECT_CALL(*contextMock, hasHotplugSupport()).WillOnce(Return(true));
+        EXPECT_CALL(*contextMock, registerHotplug(_, _)).WillOnce(SaveArg<1>(&hotplug));
+        EXPECT_CALL(*contextMock, deregisterHotplug());
+        EXPECT_CALL(*deviceMock, vendorId()).WillRepeatedly(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0f0f));
+
+        AmpWatcher watcher{[&notified](bool)
+                           { notified = true; }};
+        hotplug(usb::HotplugEvent::Arrived, usb::Device{nullptr});
+
+        EXPECT_FALSE(watcher.isAvailable());
+        EXPECT_FALSE(notified);
+        EXPECT_THROW(watcher.connect(), CommunicationException);
+    }
+
+    TEST_F(ConnectionFactoryTest, ampWatcherReportsRemovalOfTrackedAmp)
+    {
+        usb::Hotplug::Callback hotplug;
+        std::vector<bool> notifications;
+        libusb_device* other = reinterpret_cast<libusb_device*>(0x01);
+        EXPECT_CALL(*contextMock, hasHotplugSupport()).WillOnce(Return(true));
+        EXPECT_CALL(*contextMock, registerHotplug(_, _)).WillOnce(SaveArg<1>(&hotplug));
+        EXPECT_CALL(*contextMock, deregisterHotplug());
+        EXPECT_CALL(*deviceMock, vendorId()).WillRepeatedly(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillRepeatedly(Return(0x0004));
+
+        AmpWatcher watcher{[&notifications](bool available)
+                           { notifications.push_back(available); }};
+        hotplug(usb::HotplugEvent::Arrived, usb::Device{nullptr});
+        hotplug(usb::HotplugEvent::Left, usb::Device{other});
+        EXPECT_TRUE(watcher.isAvailable());
+
+        hotplug(usb::HotplugEvent::Left, usb::Device{nullptr});
+        EXPECT_FALSE(watcher.isAvailable());
+        EXPECT_THAT(notifications, ElementsAre(true, false));
+    }
 }
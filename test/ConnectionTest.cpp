@@ -0,0 +1,95 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/Connection.h"
+#include "mocks/MockConnection.h"
+#include <array>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class ConnectionTest : public testing::Test
+    {
+    protected:
+        mock::MockConnection conn;
+    };
+
+
+    TEST_F(ConnectionTest, receiveIntoCopiesReceivedData)
+    {
+        EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(std::vector<std::uint8_t>{0x01, 0x02, 0x03}));
+
+        PacketRawType packet{};
+        EXPECT_THAT(conn.receiveInto(packet), Eq(3));
+        EXPECT_THAT(packet[0], Eq(0x01));
+        EXPECT_THAT(packet[1], Eq(0x02));
+        EXPECT_THAT(packet[2], Eq(0x03));
+        EXPECT_THAT(packet[3], Eq(0x00));
+    }
+
+    TEST_F(ConnectionTest, receiveManyAppendsPackets)
+    {
+        EXPECT_CALL(conn, receive(packetRawTypeSize))
+            .WillOnce(Return(std::vector<std::uint8_t>{0x0a}))
+            .WillOnce(Return(std::vector<std::uint8_t>{0x0b}));
+
+        std::vector<PacketRawType> packets(1);
+        EXPECT_THAT(conn.receiveMany(packets, 2), Eq(2));
+        EXPECT_THAT(packets, SizeIs(3));
+        EXPECT_THAT(packets[1][0], Eq(0x0a));
+        EXPECT_THAT(packets[2][0], Eq(0x0b));
+    }
+
+    TEST_F(ConnectionTest, receiveManyStopsOnTimeout)
+    {
+        EXPECT_CALL(conn, receive(packetRawTypeSize))
+            .WillOnce(Return(std::vector<std::uint8_t>{0x0a}))
+            .WillOnce(Return(std::vector<std::uint8_t>{}));
+
+        std::vector<PacketRawType> packets;
+        EXPECT_THAT(conn.receiveMany(packets, 5), Eq(1));
+        EXPECT_THAT(packets, SizeIs(1));
+    }
+
+    TEST_F(ConnectionTest, sendBatchSendsAllPackets)
+    {
+        const std::array<PacketRawType, 2> packets{{PacketRawType{{0x01}}, PacketRawType{{0x02}}}};
+
+        InSequence s;
+        EXPECT_CALL(conn, sendImpl(packets[0].data(), packetRawTypeSize)).WillOnce(Return(packetRawTypeSize));
+        EXPECT_CALL(conn, sendImpl(packets[1].data(), packetRawTypeSize)).WillOnce(Return(packetRawTypeSize));
+
+        EXPECT_THAT(conn.sendBatch(packets), Eq(2));
+    }
+
+    TEST_F(ConnectionTest, sendBatchStopsOnIncompleteSend)
+    {
+        const std::array<PacketRawType, 3> packets{};
+
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize))
+            .WillOnce(Return(packetRawTypeSize))
+            .WillOnce(Return(0));
+
+        EXPECT_THAT(conn.sendBatch(packets), Eq(1));
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemon/Protocol.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::daemon;
+    using namespace testing;
+
+    TEST(DaemonProtocolTest, encodeFrame)
+    {
+        const std::vector<std::uint8_t> payload{0xa0, 0xa1};
+        EXPECT_THAT(encodeFrame(0x02, payload), ElementsAre(0x02, 0x02, 0x00, 0xa0, 0xa1));
+    }
+
+    TEST(DaemonProtocolTest, encodeFrameThrowsOnTooLargePayload)
+    {
+        const std::vector<std::uint8_t> payload(maxPayloadSize + 1, 0x00);
+        EXPECT_THROW(encodeFrame(0x01, payload), std::length_error);
+    }
+
+    TEST(DaemonProtocolTest, readerReturnsFramesInOrder)
+    {
+        const std::vector<std::uint8_t> first{0x01};
+        const auto frame0 = encodeFrame(0x03, first);
+        const auto frame1 = encodeFrame(0x04, {});
+        FrameReader reader;
+        reader.append(frame0);
+        reader.append(frame1);
+
+        const auto result0 = reader.next();
+        const auto result1 = reader.next();
+
+        ASSERT_TRUE(result0.has_value());
+        EXPECT_THAT(result0->type, Eq(0x03));
+        EXPECT_THAT(result0->payload, ElementsAre(0x01));
+        ASSERT_TRUE(result1.has_value());
+        EXPECT_THAT(result1->type, Eq(0x04));
+        EXPECT_THAT(result1->payload, IsEmpty());
+        EXPECT_FALSE(reader.next().has_value());
+    }
+
+    TEST(DaemonProtocolTest, readerWaitsForCompleteFrame)
+    {
+        const std::vector<std::uint8_t> payload{0x01, 0x02, 0x03};
+        const auto frame = encodeFrame(0x05, payload);
+        FrameReader reader;
+
+        reader.append(std::span{frame}.first(2));
+        EXPECT_FALSE(reader.next().has_value());
+        reader.append(std::span{frame}.subspan(2, 2));
+        EXPECT_FALSE(reader.next().has_value());
+        reader.append(std::span{frame}.subspan(4));
+
+        const auto result = reader.next();
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(result->payload, ElementsAre(0x01, 0x02, 0x03));
+    }
+
+    TEST(DaemonProtocolTest, stateRoundTrip)
+    {
+        amp_settings amp{};
+        amp.amp_num = amps::METAL_2000;
+        amp.gain = 0x33;
+        const com::InitialData state{SignalChain{"current", amp, {fx_pedal_settings{FxSlot{5}, effects::TAPE_DELAY, 1, 2, 3, 4, 5, 6, true}}},
+                                     {"first", "", "third"}};
+
+        const auto result = decodeState(encodeState(state));
+
+        EXPECT_THAT(result.signalChain.name(), Eq("current"));
+        EXPECT_THAT(result.signalChain.amp().amp_num, Eq(amps::METAL_2000));
+        EXPECT_THAT(result.signalChain.amp().gain, Eq(0x33));
+        ASSERT_THAT(result.signalChain.effects(), SizeIs(1));
+        EXPECT_THAT(result.signalChain.effects()[0].slot.id(), Eq(5));
+        EXPECT_THAT(result.signalChain.effects()[0].knob6, Eq(6));
+        EXPECT_THAT(result.presetNames, ElementsAre("first", "", "third"));
+    }
+
+    TEST(DaemonProtocolTest, decodeStateThrowsOnTruncatedPayload)
+    {
+        auto payload = encodeState(com::InitialData{SignalChain{}, {"first", "second"}});
+        payload.pop_back();
+
+        EXPECT_THROW(decodeState(payload), std::invalid_argument);
+        EXPECT_THROW(decodeState(std::span{payload}.first(10)), std::invalid_argument);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/LatencyHistogram.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+    using std::chrono::nanoseconds;
+
+    class LatencyHistogramTest : public testing::Test
+    {
+    protected:
+        LatencyHistogram histogram;
+    };
+
+
+    TEST_F(LatencyHistogramTest, emptyHistogram)
+    {
+        EXPECT_THAT(histogram.count(), Eq(0));
+        EXPECT_THAT(histogram.percentile(50.0), Eq(nanoseconds{0}));
+        EXPECT_THAT(histogram.max(), Eq(nanoseconds{0}));
+    }
+
+    TEST_F(LatencyHistogramTest, smallValuesAreExact)
+    {
+        histogram.record(nanoseconds{3});
+        histogram.record(nanoseconds{5});
+        histogram.record(nanoseconds{7});
+
+        EXPECT_THAT(histogram.count(), Eq(3));
+        EXPECT_THAT(histogram.percentile(0.0), Eq(nanoseconds{3}));
+        EXPECT_THAT(histogram.percentile(50.0), Eq(nanoseconds{5}));
+        EXPECT_THAT(histogram.percentile(100.0), Eq(nanoseconds{7}));
+    }
+
+    TEST_F(LatencyHistogramTest, percentilesWithinBucketPrecision)
+    {
+        for (int i = 1; i <= 1000; ++i)
+        {
+            histogram.record(nanoseconds{i * 1000});
+        }
+
+        EXPECT_THAT(histogram.count(), Eq(1000));
+        EXPECT_THAT(histogram.percentile(50.0).count(), AllOf(Ge(500'000), Le(500'000 * 9 / 8)));
+        EXPECT_THAT(histogram.percentile(99.0).count(), AllOf(Ge(990'000), Le(1'000'000)));
+        EXPECT_THAT(histogram.max(), Eq(nanoseconds{1'000'000}));
+    }
+
+    TEST_F(LatencyHistogramTest, percentileIsLimitedByMax)
+    {
+        histogram.record(nanoseconds{1001});
+
+        EXPECT_THAT(histogram.percentile(99.0), Eq(nanoseconds{1001}));
+    }
+
+    TEST_F(LatencyHistogramTest, negativeLatencyCountsAsZero)
+    {
+        histogram.record(nanoseconds{-5});
+
+        EXPECT_THAT(histogram.count(), Eq(1));
+        EXPECT_THAT(histogram.max(), Eq(nanoseconds{0}));
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/MappedFile.h"
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class MappedFileTest : public testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            std::filesystem::remove(path);
+        }
+
+        void writeFile(const std::string& content)
+        {
+            std::ofstream out{path, std::ios::binary};
+            out << content;
+        }
+
+        const std::string path{(std::filesystem::temp_directory_path() / "plug-mapped-file-test").string()};
+    };
+
+
+    TEST_F(MappedFileTest, mapsFileContent)
+    {
+        writeFile("abc");
+
+        const MappedFile file{path};
+        const auto data = file.data();
+        EXPECT_THAT(std::vector(data.begin(), data.end()), ElementsAre('a', 'b', 'c'));
+    }
+
+    TEST_F(MappedFileTest, mapsEmptyFile)
+    {
+        writeFile("");
+
+        const MappedFile file{path};
+        EXPECT_THAT(file.data().empty(), IsTrue());
+    }
+
+    TEST_F(MappedFileTest, throwsIfFileDoesNotExist)
+    {
+        EXPECT_THROW(MappedFile{path + "-missing"}, std::system_error);
+    }
+
+    TEST_F(MappedFileTest, moveTransfersMapping)
+    {
+        writeFile("abc");
+
+        MappedFile file{path};
+        const MappedFile moved{std::move(file)};
+        EXPECT_THAT(moved.data().size(), Eq(3));
+        EXPECT_THAT(file.data().empty(), IsTrue()); // NOLINT(bugprone-use-after-move)
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/ModelRegistry.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace testing;
+    using namespace plug::com;
+
+    class ModelRegistryTest : public testing::Test
+    {
+    protected:
+    };
+
+
+    TEST_F(ModelRegistryTest, ampModelReturnsRowOfAmp)
+    {
+        const auto& model = ampModel(amps::FENDER_65_DELUXE_REVERB);
+        EXPECT_THAT(model.amp, Eq(amps::FENDER_65_DELUXE_REVERB));
+        EXPECT_THAT(model.id, Eq(0x53));
+        EXPECT_THAT(model.unknownAmpSpecific, ElementsAre(0x03, 0x03, 0x03, 0x03, 0x6a));
+        EXPECT_THAT(model.unknown, Eq(0x00));
+    }
+
+    TEST_F(ModelRegistryTest, effectModelReturnsRowOfEffect)
+    {
+        const auto& model = effectModel(effects::TAPE_DELAY);
+        EXPECT_THAT(model.effect, Eq(effects::TAPE_DELAY));
+        EXPECT_THAT(model.id, Eq(0x2b));
+        EXPECT_THAT(model.dsp, Eq(DSP::effect2));
+        EXPECT_THAT(model.extraKnob, IsTrue());
+        EXPECT_THAT(model.unknown, ElementsAre(0x02, 0x01, 0x01));
+    }
+
+    TEST_F(ModelRegistryTest, modelThrowsOnOutOfRangeValue)
+    {
+        EXPECT_THROW(ampModel(static_cast<amps>(ampModels.size())), std::invalid_argument);
+        EXPECT_THROW(ampModel(static_cast<amps>(0xff)), std::invalid_argument);
+        EXPECT_THROW(effectModel(static_cast<effects>(effectModels.size())), std::invalid_argument);
+        EXPECT_THROW(effectModel(static_cast<effects>(0xff)), std::invalid_argument);
+    }
+
+    TEST_F(ModelRegistryTest, findByIdIsInverseOfModel)
+    {
+        for (const auto& model : ampModels)
+        {
+            EXPECT_THAT(findAmpById(model.id)->amp, Eq(model.amp));
+        }
+        for (const auto& model : effectModels)
+        {
+            EXPECT_THAT(findEffectById(model.id)->effect, Eq(model.effect));
+            EXPECT_THAT(findEffectByFileId(model.fileId)->effect, Eq(model.effect));
+        }
+    }
+
+    TEST_F(ModelRegistryTest, findReturnsEmptyOnUnknownId)
+    {
+        EXPECT_THAT(findAmpById(0x00), Eq(std::nullopt));
+        EXPECT_THAT(findAmpById(0x1000), Eq(std::nullopt));
+        EXPECT_THAT(findEffectById(0x01), Eq(std::nullopt));
+        EXPECT_THAT(findEffectById(0xffff), Eq(std::nullopt));
+        EXPECT_THAT(findEffectByFileId(0x101f), Eq(std::nullopt));
+    }
+
+    TEST_F(ModelRegistryTest, effectFileIdDiffersFromWireId)
+    {
+        EXPECT_THAT(findEffectByFileId(0x11f)->effect, Eq(effects::DIATONIC_PITCH_SHIFTER));
+        EXPECT_THAT(findEffectById(0x101f)->effect, Eq(effects::DIATONIC_PITCH_SHIFTER));
+    }
+
+    TEST_F(ModelRegistryTest, lookupIsConstexpr)
+    {
+        static_assert(ampModel(amps::BRITISH_WATTS).id == 0xff);
+        static_assert(findEffectById(0x3c)->effect == effects::OVERDRIVE);
+        static_assert(!findAmpById(0x01).has_value());
+    }
+}
@@ -61,6 +61,18 @@ namespace plug::test
         }
 
 
+        [[nodiscard]] std::vector<std::uint8_t> createConfirmationPacketData(std::uint8_t knob, std::uint8_t slotNumber) const
+        {
+            Header header{};
+            header.setStage(Stage::ready);
+            header.setType(Type::operation);
+            header.setDSP(DSP::none);
+            header.setSlot(slotNumber);
+            header.setUnknown(knob, 0x00, 0x00);
+            return asBuffer(Packet<EmptyPayload>{header, EmptyPayload{}}.getBytes());
+        }
+
+
         std::shared_ptr<mock::MockConnection> conn;
         std::unique_ptr<com::Mustang> m;
         const std::vector<std::uint8_t> noData{};
@@ -84,9 +96,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -115,6 +126,18 @@ namespace plug::test
         EXPECT_THROW(m->start_amp(), plug::com::CommunicationException);
     }
 
+    TEST_F(MustangTest, startThrowsOnIncompleteDump)
+    {
+        EXPECT_CALL(*conn, isOpen()).WillOnce(Return(true));
+        EXPECT_CALL(*conn, sendImpl(_, _)).WillRepeatedly(Return(packetRawTypeSize));
+
+        InSequence s;
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2 + numPresetPackets).WillRepeatedly(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreAmpData)).WillOnce(Return(noData));
+
+        EXPECT_THROW(m->start_amp(), plug::com::CommunicationException);
+    }
+
     TEST_F(MustangTest, startRequestsCurrentPresetName)
     {
         const auto [initPacket1, initPacket2] = serializeInitCommand();
@@ -126,9 +149,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -173,9 +195,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -221,9 +242,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -265,9 +285,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -315,9 +334,8 @@ namespace plug::test
 
         // Init commands
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
         EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         // Load cmd
         EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
@@ -340,6 +358,61 @@ namespace plug::test
         m->start_amp();
     }
 
+    TEST_F(MustangTest, startStopsReceivingAfterLastKnobPreset)
+    {
+        const auto [initPacket1, initPacket2] = serializeInitCommand();
+        const auto initCmd1 = initPacket1.getBytes();
+        const auto initCmd2 = initPacket2.getBytes();
+        constexpr std::size_t numKnobPresets{12};
+
+        InSequence s;
+        EXPECT_CALL(*conn, isOpen()).WillOnce(Return(true));
+
+        // Init commands
+        EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd1), initCmd1.size())).WillOnce(Return(initCmd1.size()));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(initCmd2), initCmd2.size())).WillOnce(Return(initCmd2.size()));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
+
+        // Load cmd
+        EXPECT_CALL(*conn, sendImpl(BufferIs(loadCmd), loadCmd.size())).WillOnce(Return(loadCmd.size()));
+
+        // Preset names data
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(numPresetPackets).WillRepeatedly(Return(ignoreData));
+
+        // Data
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreAmpData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(createConfirmationPacketData(0x00, slot)));
+
+        // Mod knob presets
+        for (std::uint8_t i = 0; i < numKnobPresets; ++i)
+        {
+            EXPECT_CALL(*conn, receive(packetRawTypeSize))
+                .WillOnce(Return(ignoreData))
+                .WillOnce(Return(ignoreData))
+                .WillOnce(Return(createConfirmationPacketData(0x01, i)));
+        }
+
+        // Dly/Rev knob presets, no further receive after the last one
+        for (std::uint8_t i = 0; i < numKnobPresets; ++i)
+        {
+            EXPECT_CALL(*conn, receive(packetRawTypeSize))
+                .WillOnce(Return(ignoreData))
+                .WillOnce(Return(ignoreData))
+                .WillOnce(Return(ignoreData))
+                .WillOnce(Return(createConfirmationPacketData(0x02, i)));
+        }
+
+
+        m->start_amp();
+    }
+
     TEST_F(MustangTest, stopAmpClosesConnection)
     {
         EXPECT_CALL(*conn, close());
@@ -369,6 +442,41 @@ namespace plug::test
         m->load_memory_bank(slot);
     }
 
+    TEST_F(MustangTest, loadMemoryBankStopsReceivingOnConfirmation)
+    {
+        InSequence s;
+        // Load cmd
+        EXPECT_CALL(*conn, sendImpl(_, _)).WillOnce(Return(packetRawTypeSize));
+
+        // Data, no further receive after the confirmation
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreAmpData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(createConfirmationPacketData(0x00, slot)));
+
+
+        m->load_memory_bank(slot);
+    }
+
+    TEST_F(MustangTest, selectMemoryBankSendsBankSelectionCommandAndReceivesPacket)
+    {
+        const auto loadSlotCmd = serializeLoadSlotCommand(slot).getBytes();
+
+        InSequence s;
+        EXPECT_CALL(*conn, sendImpl(BufferIs(loadSlotCmd), loadSlotCmd.size())).WillOnce(Return(loadSlotCmd.size()));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .Times(7)
+            .WillRepeatedly(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(createConfirmationPacketData(0x00, slot)));
+
+        m->select_memory_bank(slot);
+    }
+
     TEST_F(MustangTest, loadMemoryBankReceivesName)
     {
         const auto recvData = asBuffer(serializeName(0, "abc").getBytes());
@@ -466,21 +574,14 @@ namespace plug::test
 
 
         InSequence s;
-        // Data #1
+        // Commands are sent at once
         EXPECT_CALL(*conn, sendImpl(BufferIs(data), data.size())).WillOnce(Return(data.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Apply command
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Data #2
         EXPECT_CALL(*conn, sendImpl(BufferIs(data2), data2.size())).WillOnce(Return(data2.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Apply command
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+
+        // Acknowledges
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
 
 
         m->set_amplifier(settings);
@@ -493,22 +594,14 @@ namespace plug::test
         const PacketRawType clearEffect = serializeClearEffectSettings(settings).getBytes();
 
         InSequence s;
-
-        // Clear effect command
+        // Commands are sent at once
         EXPECT_CALL(*conn, sendImpl(BufferIs(clearEffect), clearEffect.size())).WillOnce(Return(clearEffect.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Apply command
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Data
         EXPECT_CALL(*conn, sendImpl(BufferIs(data), data.size())).WillOnce(Return(data.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Apply command
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+
+        // Acknowledges
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
 
         m->set_effect(settings);
     }
@@ -519,14 +612,9 @@ namespace plug::test
         const PacketRawType clearEffect = serializeClearEffectSettings(settings).getBytes();
 
         InSequence s;
-
-        // Clear effect command
         EXPECT_CALL(*conn, sendImpl(BufferIs(clearEffect), clearEffect.size())).WillOnce(Return(clearEffect.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
-
-        // Apply command
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
         m->set_effect(settings);
     }
@@ -538,18 +626,154 @@ namespace plug::test
 
 
         InSequence s;
-        // Clear command
         EXPECT_CALL(*conn, sendImpl(BufferIs(clearCmd), clearCmd.size())).WillOnce(Return(clearCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
+
+        m->set_effect(settings);
+    }
+
+    TEST_F(MustangTest, setAmpThrowsOnMissingAcknowledge)
+    {
+        constexpr amp_settings settings{amps::BRITISH_70S, 8, 9, 1, 2, 3,
+                                        cabinets::cab4x12G, 3, 5, 3, 2, 1,
+                                        4, 1, 5, true, 4};
 
-        // Apply command
+        EXPECT_CALL(*conn, sendImpl(_, packetRawTypeSize)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(noData))
+            .WillOnce(Return(ignoreData));
+
+        EXPECT_THROW(m->set_amplifier(settings), CommunicationException);
+    }
+
+    TEST_F(MustangTest, setEffectThrowsOnFailedSend)
+    {
+        constexpr fx_pedal_settings settings{FxSlot{3}, effects::OVERDRIVE, 8, 7, 6, 5, 4, 3};
+
+        // Commands following a failed one aren't sent
+        EXPECT_CALL(*conn, sendImpl(_, packetRawTypeSize))
+            .WillOnce(Return(packetRawTypeSize))
+            .WillOnce(Return(packetRawTypeSize))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
+
+        EXPECT_THROW(m->set_effect(settings), CommunicationException);
+    }
+
+    TEST_F(MustangTest, setAmpSkipsUnchangedUsbGain)
+    {
+        amp_settings settings{amps::BRITISH_70S, 8, 9, 1, 2, 3,
+                              cabinets::cab4x12G, 3, 5, 3, 2, 1,
+                              4, 1, 5, true, 4};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
+        m->set_amplifier(settings);
+
+        settings.gain = 99;
+        const auto data = serializeAmpSettings(settings).getBytes();
+
+        InSequence s;
+        EXPECT_CALL(*conn, sendImpl(BufferIs(data), data.size())).WillOnce(Return(data.size()));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
+
+        m->set_amplifier(settings);
+    }
+
+    TEST_F(MustangTest, setAmpSkipsUnchangedSettings)
+    {
+        constexpr amp_settings settings{amps::BRITISH_70S, 8, 9, 1, 2, 3,
+                                        cabinets::cab4x12G, 3, 5, 3, 2, 1,
+                                        4, 1, 5, true, 4};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
+
+        m->set_amplifier(settings);
+        m->set_amplifier(settings);
+    }
+
+    TEST_F(MustangTest, setAmpResendsSettingsAfterFailure)
+    {
+        constexpr amp_settings settings{amps::BRITISH_70S, 8, 9, 1, 2, 3,
+                                        cabinets::cab4x12G, 3, 5, 3, 2, 1,
+                                        4, 1, 5, true, 4};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(8).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .WillOnce(Return(noData))
+            .WillRepeatedly(Return(ignoreData));
+
+        EXPECT_THROW(m->set_amplifier(settings), CommunicationException);
+        m->set_amplifier(settings);
+    }
+
+    TEST_F(MustangTest, setEffectSendsOnlySettingsIfKnobsChanged)
+    {
+        fx_pedal_settings settings{FxSlot{3}, effects::OVERDRIVE, 8, 7, 6, 5, 4, 3};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
+        m->set_effect(settings);
+
+        settings.knob1 = 99;
+        const auto data = serializeEffectSettings(settings).getBytes();
+
+        InSequence s;
+        EXPECT_CALL(*conn, sendImpl(BufferIs(data), data.size())).WillOnce(Return(data.size()));
         EXPECT_CALL(*conn, sendImpl(BufferIs(applyCmd), applyCmd.size())).WillOnce(Return(applyCmd.size()));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(2).WillRepeatedly(Return(ignoreData));
 
+        m->set_effect(settings);
+    }
 
+    TEST_F(MustangTest, setEffectClearsIfEffectChanged)
+    {
+        fx_pedal_settings settings{FxSlot{3}, effects::OVERDRIVE, 8, 7, 6, 5, 4, 3};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(8).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(8).WillRepeatedly(Return(ignoreData));
+
+        m->set_effect(settings);
+        settings.effect_num = effects::FUZZ;
+        m->set_effect(settings);
+    }
+
+    TEST_F(MustangTest, setEffectSkipsUnchangedSettings)
+    {
+        constexpr fx_pedal_settings settings{FxSlot{3}, effects::OVERDRIVE, 8, 7, 6, 5, 4, 3};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
+
+        m->set_effect(settings);
         m->set_effect(settings);
     }
 
+    TEST_F(MustangTest, loadMemoryBankResetsShadowState)
+    {
+        constexpr amp_settings settings{amps::BRITISH_70S, 8, 9, 1, 2, 3,
+                                        cabinets::cab4x12G, 3, 5, 3, 2, 1,
+                                        4, 1, 5, true, 4};
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(9).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreAmpData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(ignoreData))
+            .WillOnce(Return(noData))
+            .WillRepeatedly(Return(ignoreData));
+
+        m->set_amplifier(settings);
+        m->load_memory_bank(slot);
+        m->set_amplifier(settings);
+    }
+
     TEST_F(MustangTest, saveEffectsSendsValues)
     {
         const std::vector<fx_pedal_settings> settings{fx_pedal_settings{FxSlot{1}, effects::MONO_DELAY, 0, 1, 2, 3, 4, 5},
@@ -562,22 +786,21 @@ namespace plug::test
 
         InSequence s;
         // Save effect name cmd
-        EXPECT_CALL(*conn, sendImpl(BufferIs(dataName), dataName.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(dataName), dataName.size())).WillOnce(Return(dataName.size()));
 
         // Effect #0
         const auto effect0 = packets[0].getBytes();
-        EXPECT_CALL(*conn, sendImpl(BufferIs(effect0), effect0.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(effect0), effect0.size())).WillOnce(Return(effect0.size()));
 
         // Effect #1
         const auto effect1 = packets[1].getBytes();
-        EXPECT_CALL(*conn, sendImpl(BufferIs(effect1), effect1.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(effect1), effect1.size())).WillOnce(Return(effect1.size()));
 
         // Apply cmd
-        EXPECT_CALL(*conn, sendImpl(BufferIs(cmdExecute), cmdExecute.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(cmdExecute), cmdExecute.size())).WillOnce(Return(cmdExecute.size()));
+
+        // Acknowledges
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(4).WillRepeatedly(Return(ignoreData));
 
 
         m->save_effects(slot, name, settings);
@@ -596,21 +819,31 @@ namespace plug::test
 
         InSequence s;
         // Save effect cmd
-        EXPECT_CALL(*conn, sendImpl(BufferIs(dataName), dataName.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(dataName), dataName.size())).WillOnce(Return(dataName.size()));
 
         // Effect #0
         const auto effect0 = packets[0].getBytes();
-        EXPECT_CALL(*conn, sendImpl(BufferIs(effect0), effect0.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(effect0), effect0.size())).WillOnce(Return(effect0.size()));
 
         // Apply cmd
-        EXPECT_CALL(*conn, sendImpl(BufferIs(cmdExecute), cmdExecute.size())).WillOnce(Return(0));
-        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(noData));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(cmdExecute), cmdExecute.size())).WillOnce(Return(cmdExecute.size()));
+
+        // Acknowledges
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).Times(3).WillRepeatedly(Return(ignoreData));
 
         m->save_effects(slot, name, settings);
     }
 
+    TEST_F(MustangTest, saveEffectsThrowsOnMissingAcknowledge)
+    {
+        const std::vector<fx_pedal_settings> settings{fx_pedal_settings{FxSlot{1}, effects::MONO_DELAY, 0, 1, 2, 3, 4, 5}};
+
+        EXPECT_CALL(*conn, sendImpl(_, packetRawTypeSize)).Times(3).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*conn, receive(packetRawTypeSize)).WillOnce(Return(ignoreData)).WillOnce(Return(noData)).WillOnce(Return(ignoreData));
+
+        EXPECT_THROW(m->save_effects(slot, "abcd", settings), CommunicationException);
+    }
+
     TEST_F(MustangTest, saveEffectsDoesNothingOnInvalidEffect)
     {
         const std::vector<fx_pedal_settings> settings{fx_pedal_settings{FxSlot{1}, effects::COMPRESSOR, 0, 1, 2, 3, 4, 5}};
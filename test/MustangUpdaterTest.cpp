@@ -0,0 +1,200 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/MustangUpdater.h"
+#include "com/CommunicationException.h"
+#include "mocks/MockConnection.h"
+#include "mocks/UsbDeviceMock.h"
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class MustangUpdaterTest : public testing::Test
+    {
+    protected:
+        static std::vector<std::uint8_t> createFirmware(std::size_t dataSize)
+        {
+            std::vector<std::uint8_t> firmware(0x110 + dataSize, 0x00);
+            std::iota(std::next(firmware.begin(), 0x1a), std::next(firmware.begin(), 0x1a + 11), std::uint8_t{0xd0});
+            std::iota(std::next(firmware.begin(), 0x110), firmware.end(), std::uint8_t{0x01});
+            return firmware;
+        }
+
+        mock::MockConnection conn;
+        const std::vector<std::uint8_t> firmware = createFirmware(100);
+    };
+
+
+    TEST_F(MustangUpdaterTest, numberOfFirmwarePackets)
+    {
+        EXPECT_THAT(numberOfFirmwarePackets(createFirmware(0)), Eq(3));
+        EXPECT_THAT(numberOfFirmwarePackets(createFirmware(100)), Eq(4));
+        EXPECT_THAT(numberOfFirmwarePackets(createFirmware(112)), Eq(5));
+    }
+
+    TEST_F(MustangUpdaterTest, numberOfFirmwarePacketsThrowsOnInvalidFirmware)
+    {
+        EXPECT_THROW(numberOfFirmwarePackets(std::vector<std::uint8_t>(0x10f)), CommunicationException);
+    }
+
+    TEST_F(MustangUpdaterTest, serializeDatePacket)
+    {
+        const auto packet = serializeFirmwarePacket(firmware, 0);
+
+        EXPECT_THAT(std::vector(packet.cbegin(), std::next(packet.cbegin(), 16)),
+                    ElementsAre(0x02, 0x03, 0x01, 0x06, 0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0x00));
+    }
+
+    TEST_F(MustangUpdaterTest, serializeDataPackets)
+    {
+        const auto first = serializeFirmwarePacket(firmware, 1);
+        EXPECT_THAT(std::vector(first.cbegin(), std::next(first.cbegin(), 6)), ElementsAre(0x03, 0x03, 0x00, 56, 0x01, 0x02));
+        EXPECT_THAT(first[59], Eq(56));
+        EXPECT_THAT(first[60], Eq(0x00));
+
+        const auto last = serializeFirmwarePacket(firmware, 2);
+        EXPECT_THAT(std::vector(last.cbegin(), std::next(last.cbegin(), 5)), ElementsAre(0x03, 0x03, 0x00, 44, 57));
+        EXPECT_THAT(last[47], Eq(100));
+        EXPECT_THAT(last[48], Eq(0x00));
+    }
+
+    TEST_F(MustangUpdaterTest, serializeEmptyLastDataPacket)
+    {
+        const auto packet = serializeFirmwarePacket(createFirmware(56), 2);
+
+        EXPECT_THAT(packet[0], Eq(0x03));
+        EXPECT_THAT(packet[1], Eq(0x03));
+        EXPECT_THAT(std::all_of(std::next(packet.cbegin(), 2), packet.cend(), [](auto v)
+                                { return v == 0x00; }),
+                    IsTrue());
+    }
+
+    TEST_F(MustangUpdaterTest, serializeFinishedPacket)
+    {
+        const auto packet = serializeFirmwarePacket(firmware, 3);
+
+        EXPECT_THAT(packet[0], Eq(0x04));
+        EXPECT_THAT(packet[1], Eq(0x03));
+        EXPECT_THAT(std::all_of(std::next(packet.cbegin(), 2), packet.cend(), [](auto v)
+                                { return v == 0x00; }),
+                    IsTrue());
+        EXPECT_THROW(serializeFirmwarePacket(firmware, 4), std::out_of_range);
+    }
+
+    TEST_F(MustangUpdaterTest, updateSendsEachPacketAfterAcknowledge)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> progress;
+        {
+            InSequence s;
+
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                const auto packet = serializeFirmwarePacket(firmware, i);
+                EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).With(Args<0, 1>(ElementsAreArray(packet))).WillOnce(Return(packetRawTypeSize));
+                EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(std::vector<std::uint8_t>(packetRawTypeSize, 0x00)));
+            }
+        }
+
+        const auto status = updateFirmware(conn, firmware, [&progress](std::size_t sent, std::size_t total)
+                                           { progress.emplace_back(sent, total); },
+                                           {});
+        EXPECT_THAT(status, Eq(UpdateStatus::finished));
+        EXPECT_THAT(progress, ElementsAre(Pair(1, 4), Pair(2, 4), Pair(3, 4), Pair(4, 4)));
+    }
+
+    TEST_F(MustangUpdaterTest, updateThrowsIfPacketIsNotAcknowledged)
+    {
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(conn, receive(packetRawTypeSize))
+            .WillOnce(Return(std::vector<std::uint8_t>(packetRawTypeSize, 0x00)))
+            .WillOnce(Return(std::vector<std::uint8_t>{}));
+
+        EXPECT_THROW(updateFirmware(conn, firmware, {}, {}), CommunicationException);
+    }
+
+    TEST_F(MustangUpdaterTest, updateThrowsOnFailedSend)
+    {
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).WillOnce(Return(0));
+
+        EXPECT_THROW(updateFirmware(conn, firmware, {}, {}), CommunicationException);
+    }
+
+    TEST_F(MustangUpdaterTest, updateStopsIfCancelled)
+    {
+        std::stop_source stop;
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).WillOnce(Return(packetRawTypeSize));
+        EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(std::vector<std::uint8_t>(packetRawTypeSize, 0x00)));
+
+        const auto status = updateFirmware(conn, firmware, [&stop](std::size_t, std::size_t)
+                                           { stop.request_stop(); },
+                                           stop.get_token());
+        EXPECT_THAT(status, Eq(UpdateStatus::cancelled));
+    }
+
+    TEST_F(MustangUpdaterTest, updateFromFileThrowsIfNoDeviceFound)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "plug-updater-test.upd").string();
+        {
+            std::ofstream out{path, std::ios::binary};
+            out.write(reinterpret_cast<const char*>(firmware.data()), static_cast<std::streamsize>(firmware.size()));
+        }
+        auto* contextMock = mock::resetUsbContextMock();
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::vector<usb::Device>{})));
+
+        EXPECT_THROW(updateFirmware(path, {}, {}), CommunicationException);
+
+        mock::clearUsbContextMock();
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(MustangUpdaterTest, updateFromFileReadsAcknowledgesWithoutReceiveRing)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "plug-updater-test.upd").string();
+        {
+            std::ofstream out{path, std::ios::binary};
+            out.write(reinterpret_cast<const char*>(firmware.data()), static_cast<std::streamsize>(firmware.size()));
+        }
+        std::vector<usb::Device> devices{};
+        devices.emplace_back(nullptr);
+        auto* contextMock = mock::resetUsbContextMock();
+        auto* deviceMock = mock::resetUsbDeviceMock();
+        EXPECT_CALL(*contextMock, listDevices).WillOnce(Return(ByMove(std::move(devices))));
+        EXPECT_CALL(*deviceMock, vendorId()).WillOnce(Return(0x1ed8));
+        EXPECT_CALL(*deviceMock, productId()).WillOnce(Return(0x0007));
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(_, _)).Times(0);
+        EXPECT_CALL(*deviceMock, name()).Times(0);
+        EXPECT_CALL(*deviceMock, write(0x01, NotNull(), packetRawTypeSize)).Times(4).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(*deviceMock, receive(0x81, packetRawTypeSize)).Times(4).WillRepeatedly(Return(std::vector<std::uint8_t>(packetRawTypeSize, 0x00)));
+        EXPECT_CALL(*deviceMock, close());
+
+        EXPECT_THAT(updateFirmware(path, {}, {}), Eq(UpdateStatus::finished));
+
+        mock::clearUsbDeviceMock();
+        mock::clearUsbContextMock();
+        std::filesystem::remove(path);
+    }
+}
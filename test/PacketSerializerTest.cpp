@@ -255,6 +255,12 @@ namespace plug::test
         EXPECT_THAT(packet[v1::DSP], Eq(0x05));
     }
 
+    TEST_F(PacketSerializerTest, serializeAmpSettingsThrowsOnInvalidAmp)
+    {
+        const amp_settings settings{static_cast<amps>(0xff), 0, 0, 0, 0, 0, cabinets::OFF, 0, 0, 0, 0, 0, 0, 0, 0, false, 0};
+        EXPECT_THROW(serializeAmpSettings(settings), std::invalid_argument);
+    }
+
     TEST_F(PacketSerializerTest, serializeAmpSettingsAmpControllsData)
     {
         constexpr amp_settings settings{amps::METAL_2000, 123, 101, 93, 30, 61, cabinets::cab2x12C, 3, 10, 15, 40, 0, 0, 100, 1, false, 0};
@@ -498,6 +504,13 @@ namespace plug::test
         EXPECT_THAT(packet.getBytes(), ContainerEq(expected));
     }
 
+    TEST_F(PacketSerializerTest, serializeEffectSettingsThrowsOnInvalidEffect)
+    {
+        const fx_pedal_settings settings{FxSlot{1}, static_cast<effects>(0xff), 0, 0, 0, 0, 0, 0};
+        EXPECT_THROW(serializeEffectSettings(settings), std::invalid_argument);
+        EXPECT_THROW(serializeClearEffectSettings(settings), std::invalid_argument);
+    }
+
     TEST_F(PacketSerializerTest, serializeEffectSettingsSetsInputPosition)
     {
         constexpr std::uint8_t value{3};
@@ -926,7 +939,7 @@ namespace plug::test
 
     TEST_F(PacketSerializerTest, decodePresetListIsSafeToEmptyData)
     {
-        const auto result = decodePresetListFromData({});
+        const auto result = decodePresetListFromData(std::vector<Packet<NamePayload>>{});
         EXPECT_THAT(result, SizeIs(0));
     }
 
@@ -0,0 +1,167 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PacketView.h"
+#include "com/PacketSerializer.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace testing;
+    using namespace plug::com;
+
+    class PacketViewTest : public testing::Test
+    {
+    protected:
+        template <class Payload>
+        PacketRawType toRawPacket(const Header& header, const Payload& payload) const
+        {
+            return Packet<Payload>{header, payload}.getBytes();
+        }
+    };
+
+    TEST_F(PacketViewTest, headerViewReadsFields)
+    {
+        Header h{};
+        h.setStage(Stage::ready);
+        h.setType(Type::data);
+        h.setDSP(DSP::effect2);
+        h.setSlot(0x0c);
+        const auto data = toRawPacket(h, EmptyPayload{});
+
+        const auto header = PacketView<NamePayload>{data}.getHeader();
+        EXPECT_THAT(header.getStage(), Eq(Stage::ready));
+        EXPECT_THAT(header.getType(), Eq(Type::data));
+        EXPECT_THAT(header.getDSP(), Eq(DSP::effect2));
+        EXPECT_THAT(header.getSlot(), Eq(0x0c));
+    }
+
+    TEST_F(PacketViewTest, headerViewThrowsOnInvalidDsp)
+    {
+        PacketRawType data{};
+        data[layout::header::dsp] = 0xee;
+
+        EXPECT_THROW(PacketView<NamePayload>{data}.getHeader().getDSP(), std::domain_error);
+    }
+
+    TEST_F(PacketViewTest, namePayloadViewReadsName)
+    {
+        NamePayload payload{};
+        payload.setName("abc def");
+        const auto data = toRawPacket(Header{}, payload);
+
+        EXPECT_THAT(PacketView<NamePayload>{data}.getPayload().getName(), StrEq("abc def"));
+    }
+
+    TEST_F(PacketViewTest, namePayloadViewLimitsNameLength)
+    {
+        NamePayload payload{};
+        payload.setName(std::string(40, 'x'));
+        const auto data = toRawPacket(Header{}, payload);
+
+        EXPECT_THAT(PacketView<NamePayload>{data}.getPayload().getName(), StrEq(std::string(32, 'x')));
+    }
+
+    TEST_F(PacketViewTest, effectPayloadViewReadsFields)
+    {
+        EffectPayload payload{};
+        payload.setModel(0x1234);
+        payload.setSlot(0x05);
+        payload.setKnob1(0x11);
+        payload.setKnob2(0x22);
+        payload.setKnob3(0x33);
+        payload.setKnob4(0x44);
+        payload.setKnob5(0x55);
+        payload.setKnob6(0x66);
+        const auto data = toRawPacket(Header{}, payload);
+
+        const auto view = PacketView<EffectPayload>{data}.getPayload();
+        EXPECT_THAT(view.getModel(), Eq(0x1234));
+        EXPECT_THAT(view.getSlot(), Eq(0x05));
+        EXPECT_THAT(view.getKnob1(), Eq(0x11));
+        EXPECT_THAT(view.getKnob2(), Eq(0x22));
+        EXPECT_THAT(view.getKnob3(), Eq(0x33));
+        EXPECT_THAT(view.getKnob4(), Eq(0x44));
+        EXPECT_THAT(view.getKnob5(), Eq(0x55));
+        EXPECT_THAT(view.getKnob6(), Eq(0x66));
+    }
+
+    TEST_F(PacketViewTest, ampPayloadViewReadsFields)
+    {
+        AmpPayload payload{};
+        payload.setModel(0xab);
+        payload.setVolume(0xaa);
+        payload.setGain(0x11);
+        payload.setGain2(0x22);
+        payload.setMasterVolume(0x03);
+        payload.setTreble(0x1a);
+        payload.setMiddle(0x1b);
+        payload.setBass(0x1c);
+        payload.setPresence(0x1d);
+        payload.setDepth(0x21);
+        payload.setBias(0x12);
+        payload.setNoiseGate(0x05);
+        payload.setThreshold(0x07);
+        payload.setCabinet(0x06);
+        payload.setSag(0x08);
+        payload.setBrightness(0x09);
+        const auto data = toRawPacket(Header{}, payload);
+
+        const auto view = PacketView<AmpPayload>{data}.getPayload();
+        EXPECT_THAT(view.getModel(), Eq(0xab));
+        EXPECT_THAT(view.getVolume(), Eq(0xaa));
+        EXPECT_THAT(view.getGain(), Eq(0x11));
+        EXPECT_THAT(view.getGain2(), Eq(0x22));
+        EXPECT_THAT(view.getMasterVolume(), Eq(0x03));
+        EXPECT_THAT(view.getTreble(), Eq(0x1a));
+        EXPECT_THAT(view.getMiddle(), Eq(0x1b));
+        EXPECT_THAT(view.getBass(), Eq(0x1c));
+        EXPECT_THAT(view.getPresence(), Eq(0x1d));
+        EXPECT_THAT(view.getDepth(), Eq(0x21));
+        EXPECT_THAT(view.getBias(), Eq(0x12));
+        EXPECT_THAT(view.getNoiseGate(), Eq(0x05));
+        EXPECT_THAT(view.getThreshold(), Eq(0x07));
+        EXPECT_THAT(view.getCabinet(), Eq(0x06));
+        EXPECT_THAT(view.getSag(), Eq(0x08));
+        EXPECT_THAT(view.getBrightness(), Eq(0x09));
+    }
+
+    TEST_F(PacketViewTest, viewReadsInPlace)
+    {
+        PacketRawType data{};
+        const PacketView<AmpPayload> view{data};
+
+        data[layout::headerSize + layout::amp::gain] = 0x42;
+        EXPECT_THAT(view.getPayload().getGain(), Eq(0x42));
+    }
+
+    TEST_F(PacketViewTest, decodePresetListFromRawPackets)
+    {
+        NamePayload payload1{};
+        payload1.setName("abc");
+        NamePayload payload2{};
+        payload2.setName("xyz");
+        const std::vector<PacketRawType> data{toRawPacket(Header{}, payload1), PacketRawType{},
+                                              toRawPacket(Header{}, payload2), PacketRawType{}};
+
+        const auto result = decodePresetListFromData(std::span<const PacketRawType>{data});
+        EXPECT_THAT(result, ElementsAre("abc", "xyz"));
+    }
+}
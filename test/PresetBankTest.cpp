@@ -0,0 +1,149 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetBank.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class PresetBankTest : public testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            std::filesystem::remove(path);
+        }
+
+        void writeBank(const std::vector<SignalChain>& presets)
+        {
+            std::ofstream out{path, std::ios::binary};
+            writePresetBank(out, presets);
+        }
+
+        void writeFile(const std::string& content)
+        {
+            std::ofstream out{path, std::ios::binary};
+            out << content;
+        }
+
+        const std::string path{(std::filesystem::temp_directory_path() / "plug-preset-bank-test").string()};
+        const amp_settings amp{amps::BRITISH_80S, 1, 2, 3, 4, 5, cabinets::cab4x12G, 6, 7, 8, 9, 10, 11, 12, 13, true, 14};
+        const std::vector<fx_pedal_settings> effects{{FxSlot{2}, effects::SINE_CHORUS, 1, 2, 3, 4, 5, 6, false},
+                                                     {FxSlot{5}, effects::TAPE_DELAY, 7, 8, 9, 10, 11, 12, true}};
+    };
+
+
+    TEST_F(PresetBankTest, readsWrittenPresets)
+    {
+        writeBank({SignalChain{"first", amp, effects}, SignalChain{"second", amp_settings{}, {}}});
+
+        const PresetBank bank{path};
+        ASSERT_THAT(bank.size(), Eq(2));
+
+        const auto first = bank.at(0);
+        EXPECT_THAT(first.name(), Eq("first"));
+        EXPECT_THAT(first.amp().amp_num, Eq(amps::BRITISH_80S));
+        EXPECT_THAT(first.amp().gain, Eq(1));
+        EXPECT_THAT(first.amp().cabinet, Eq(cabinets::cab4x12G));
+        EXPECT_THAT(first.amp().sag, Eq(13));
+        EXPECT_THAT(first.amp().brightness, IsTrue());
+        EXPECT_THAT(first.amp().usb_gain, Eq(14));
+        ASSERT_THAT(first.effects().size(), Eq(2));
+        EXPECT_THAT(first.effects()[0].slot.id(), Eq(2));
+        EXPECT_THAT(first.effects()[0].effect_num, Eq(effects::SINE_CHORUS));
+        EXPECT_THAT(first.effects()[0].enabled, IsFalse());
+        EXPECT_THAT(first.effects()[1].effect_num, Eq(effects::TAPE_DELAY));
+        EXPECT_THAT(first.effects()[1].knob6, Eq(12));
+
+        EXPECT_THAT(bank.at(1).name(), Eq("second"));
+        EXPECT_THAT(bank.at(1).effects().empty(), IsTrue());
+    }
+
+    TEST_F(PresetBankTest, readsNamesWithoutDecodingPresets)
+    {
+        writeBank({SignalChain{"first", amp, effects}, SignalChain{"second", amp, effects}});
+
+        const PresetBank bank{path};
+        EXPECT_THAT(bank.name(1), Eq("second"));
+    }
+
+    TEST_F(PresetBankTest, namesAreLimitedToRecordSize)
+    {
+        writeBank({SignalChain{std::string(40, 'x'), amp, effects}});
+
+        const PresetBank bank{path};
+        EXPECT_THAT(bank.name(0), Eq(std::string(32, 'x')));
+    }
+
+    TEST_F(PresetBankTest, emptyBank)
+    {
+        writeBank({});
+
+        const PresetBank bank{path};
+        EXPECT_THAT(bank.size(), Eq(0));
+    }
+
+    TEST_F(PresetBankTest, throwsIfIndexOutOfRange)
+    {
+        writeBank({SignalChain{"first", amp, effects}});
+
+        const PresetBank bank{path};
+        EXPECT_THROW(bank.at(1), std::out_of_range);
+    }
+
+    TEST_F(PresetBankTest, throwsOnInvalidAmpOrEffectId)
+    {
+        constexpr std::streamoff firstRecord{16};
+        writeBank({SignalChain{"amp", amp, effects}, SignalChain{"effect", amp, effects}});
+        {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(firstRecord + presetNameSize);
+            file.put(static_cast<char>(0xff));
+            // Skip the effect count and the slot of the first effect
+            file.seekp(firstRecord + presetRecordSize + presetNameSize + ampRecordSize + 1 + 1);
+            file.put(static_cast<char>(0xff));
+        }
+
+        const PresetBank bank{path};
+        EXPECT_THAT(bank.name(0), Eq("amp"));
+        EXPECT_THROW(bank.at(0), std::invalid_argument);
+        EXPECT_THROW(bank.at(1), std::invalid_argument);
+    }
+
+    TEST_F(PresetBankTest, throwsOnInvalidFile)
+    {
+        writeFile("PLUGREC\x01 invalid file content");
+        EXPECT_THROW(PresetBank{path}, std::runtime_error);
+    }
+
+    TEST_F(PresetBankTest, throwsOnTruncatedFile)
+    {
+        writeBank({SignalChain{"first", amp, effects}});
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+        EXPECT_THROW(PresetBank{path}, std::runtime_error);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetCache.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class PresetCacheTest : public testing::Test
+    {
+    protected:
+        const SignalChain signalChain{"abc", amp_settings{}, {}};
+    };
+
+
+    TEST_F(PresetCacheTest, emptyInitially)
+    {
+        const PresetCache cache;
+        EXPECT_FALSE(cache.get(0).has_value());
+    }
+
+    TEST_F(PresetCacheTest, getReturnsStoredPreset)
+    {
+        PresetCache cache;
+        cache.put(3, signalChain);
+
+        const auto result = cache.get(3);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(result->name(), Eq("abc"));
+        EXPECT_FALSE(cache.get(4).has_value());
+    }
+
+    TEST_F(PresetCacheTest, putReplacesStoredPreset)
+    {
+        PresetCache cache;
+        cache.put(3, signalChain);
+        cache.put(3, SignalChain{"def", amp_settings{}, {}});
+
+        EXPECT_THAT(cache.get(3)->name(), Eq("def"));
+    }
+
+    TEST_F(PresetCacheTest, invalidateRemovesPreset)
+    {
+        PresetCache cache;
+        cache.put(3, signalChain);
+        cache.put(4, signalChain);
+        cache.invalidate(3);
+
+        EXPECT_FALSE(cache.get(3).has_value());
+        EXPECT_TRUE(cache.get(4).has_value());
+    }
+
+    TEST_F(PresetCacheTest, clearRemovesAllPresets)
+    {
+        PresetCache cache;
+        cache.put(3, signalChain);
+        cache.put(4, signalChain);
+        cache.clear();
+
+        EXPECT_FALSE(cache.get(3).has_value());
+        EXPECT_FALSE(cache.get(4).has_value());
+    }
+}
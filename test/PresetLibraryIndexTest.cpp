@@ -0,0 +1,235 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/PresetLibraryIndex.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class PresetLibraryIndexTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::filesystem::create_directories(directory);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(directory);
+        }
+
+        void writeFile(const std::string& name, const std::string& content)
+        {
+            std::ofstream out{directory / name, std::ios::binary};
+            out << content;
+        }
+
+        std::vector<std::string> names(const PresetLibraryIndex& index) const
+        {
+            std::vector<std::string> result;
+            const auto entries = index.entries();
+            std::transform(entries.cbegin(), entries.cend(), std::back_inserter(result), [](const auto& entry)
+                           { return entry.signalChain.name(); });
+            return result;
+        }
+
+        const std::filesystem::path directory{std::filesystem::temp_directory_path() / "plug-preset-library-index-test"};
+        std::atomic<std::size_t> loads{0};
+        const PresetLibraryIndex::Loader loader{[this](const std::filesystem::path& file)
+                                                {
+                                                    ++loads;
+                                                    std::ifstream in{file};
+                                                    std::string content;
+                                                    std::getline(in, content);
+
+                                                    if (content == "invalid")
+                                                    {
+                                                        throw std::runtime_error{"Invalid preset"};
+                                                    }
+                                                    return SignalChain{content, amp_settings{}, {}};
+                                                }};
+    };
+
+
+    TEST_F(PresetLibraryIndexTest, refreshLoadsPresetFilesSortedByName)
+    {
+        writeFile("b.fuse", "preset b");
+        writeFile("A.FUSE", "preset a");
+        writeFile("c.txt", "no preset");
+
+        PresetLibraryIndex index;
+        EXPECT_TRUE(index.refresh(directory, loader));
+        EXPECT_THAT(names(index), ElementsAre("preset a", "preset b"));
+        EXPECT_THAT(loads.load(), Eq(2));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshKeepsUnchangedFiles)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        EXPECT_FALSE(index.refresh(directory, loader));
+        EXPECT_THAT(loads.load(), Eq(1));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshReloadsChangedFiles)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        writeFile("a.fuse", "changed preset a");
+
+        EXPECT_TRUE(index.refresh(directory, loader));
+        EXPECT_THAT(names(index), ElementsAre("changed preset a"));
+        EXPECT_THAT(loads.load(), Eq(2));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshDropsRemovedFiles)
+    {
+        writeFile("a.fuse", "preset a");
+        writeFile("b.fuse", "preset b");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        std::filesystem::remove(directory / "a.fuse");
+
+        EXPECT_TRUE(index.refresh(directory, loader));
+        EXPECT_THAT(names(index), ElementsAre("preset b"));
+        EXPECT_FALSE(index.get(directory / "a.fuse").has_value());
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshSkipsFilesFailingToLoad)
+    {
+        writeFile("a.fuse", "invalid");
+        writeFile("b.fuse", "preset b");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        EXPECT_THAT(names(index), ElementsAre("preset b"));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshOfMissingDirectoryClearsIndex)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+
+        EXPECT_TRUE(index.refresh(directory / "missing", loader));
+        EXPECT_THAT(index.size(), Eq(0));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshFileReturnsIndexedPreset)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+
+        const auto result = index.refreshFile(directory / "a.fuse", loader);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(result->name(), Eq("preset a"));
+        EXPECT_THAT(loads.load(), Eq(1));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshFileReloadsChangedFile)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        writeFile("a.fuse", "changed preset a");
+
+        EXPECT_THAT(index.refreshFile(directory / "a.fuse", loader)->name(), Eq("changed preset a"));
+        EXPECT_THAT(index.get(directory / "a.fuse")->name(), Eq("changed preset a"));
+    }
+
+    TEST_F(PresetLibraryIndexTest, refreshFileDropsRemovedFile)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+        std::filesystem::remove(directory / "a.fuse");
+
+        EXPECT_FALSE(index.refreshFile(directory / "a.fuse", loader).has_value());
+        EXPECT_THAT(index.size(), Eq(0));
+    }
+
+    TEST_F(PresetLibraryIndexTest, saveAndLoadRestoresIndex)
+    {
+        writeFile("a.fuse", "preset a");
+
+        const amp_settings amp{amps::BRITISH_80S, 1, 2, 3, 4, 5, cabinets::cab4x12G, 6, 7, 8, 9, 10, 11, 12, 13, true, 14};
+        const std::vector<fx_pedal_settings> effects{{FxSlot{2}, effects::SINE_CHORUS, 1, 2, 3, 4, 5, 6, false},
+                                                     {FxSlot{5}, effects::TAPE_DELAY, 7, 8, 9, 10, 11, 12, true}};
+        PresetLibraryIndex index;
+        index.refresh(directory, [&amp, &effects](const auto&)
+                      { return SignalChain{"preset a", amp, effects}; });
+
+        std::stringstream stream;
+        index.save(stream);
+
+        PresetLibraryIndex loaded;
+        ASSERT_TRUE(loaded.load(stream));
+        const auto result = loaded.get(directory / "a.fuse");
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(result->name(), Eq("preset a"));
+        EXPECT_THAT(result->amp().amp_num, Eq(amps::BRITISH_80S));
+        EXPECT_THAT(result->amp().cabinet, Eq(cabinets::cab4x12G));
+        EXPECT_THAT(result->amp().sag, Eq(13));
+        EXPECT_THAT(result->amp().brightness, IsTrue());
+        EXPECT_THAT(result->amp().usb_gain, Eq(14));
+        ASSERT_THAT(result->effects().size(), Eq(2));
+        EXPECT_THAT(result->effects()[0].slot.id(), Eq(2));
+        EXPECT_THAT(result->effects()[0].effect_num, Eq(effects::SINE_CHORUS));
+        EXPECT_THAT(result->effects()[0].enabled, IsFalse());
+        EXPECT_THAT(result->effects()[1].effect_num, Eq(effects::TAPE_DELAY));
+        EXPECT_THAT(result->effects()[1].knob6, Eq(12));
+
+        EXPECT_FALSE(loaded.refresh(directory, loader));
+        EXPECT_THAT(loads.load(), Eq(0));
+    }
+
+    TEST_F(PresetLibraryIndexTest, loadRejectsInvalidData)
+    {
+        writeFile("a.fuse", "preset a");
+
+        PresetLibraryIndex index;
+        index.refresh(directory, loader);
+
+        std::stringstream stream{"PLUGIDX\x01\x05"};
+        EXPECT_FALSE(index.load(stream));
+        EXPECT_THAT(index.size(), Eq(1));
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/RecordingConnection.h"
+#include "com/SessionRecording.h"
+#include "mocks/MockConnection.h"
+#include <sstream>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class RecordingConnectionTest : public testing::Test
+    {
+    protected:
+        std::vector<RecordedPacket> recorded()
+        {
+            std::istringstream in{out->str()};
+            return readRecording(in);
+        }
+
+        std::shared_ptr<mock::MockConnection> inner = std::make_shared<mock::MockConnection>();
+        mock::MockConnection& conn = *inner;
+        std::ostringstream* out = new std::ostringstream;
+        RecordingConnection recording{inner, std::unique_ptr<std::ostream>{out}};
+    };
+
+
+    TEST_F(RecordingConnectionTest, recordsSession)
+    {
+        const std::vector<std::uint8_t> command{0x01, 0x02};
+        const std::vector<std::uint8_t> response{0x03, 0x04, 0x05};
+        EXPECT_CALL(conn, sendImpl(command.data(), command.size())).WillOnce(Return(command.size()));
+        EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(response)).WillOnce(Return(std::vector<std::uint8_t>{}));
+
+        EXPECT_THAT(recording.send(command), Eq(2));
+        PacketRawType buffer{};
+        EXPECT_THAT(recording.receiveInto(buffer), Eq(3));
+        EXPECT_THAT(recording.receive(packetRawTypeSize), IsEmpty());
+
+        const auto packets = recorded();
+        ASSERT_THAT(packets, SizeIs(3));
+        EXPECT_THAT(packets[0].direction, Eq(Direction::send));
+        EXPECT_THAT(packets[0].data, Eq(command));
+        EXPECT_THAT(packets[1].direction, Eq(Direction::receive));
+        EXPECT_THAT(packets[1].data, Eq(response));
+        EXPECT_THAT(packets[2].direction, Eq(Direction::receive));
+        EXPECT_THAT(packets[2].data, IsEmpty());
+    }
+
+    TEST_F(RecordingConnectionTest, recordsSentPacketsOfBatch)
+    {
+        const std::array<PacketRawType, 2> packets{{PacketRawType{{0x01}}, PacketRawType{{0x02}}}};
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).WillOnce(Return(packetRawTypeSize)).WillOnce(Return(0));
+
+        EXPECT_THAT(recording.sendBatch(packets), Eq(1));
+
+        const auto recordedPackets = recorded();
+        ASSERT_THAT(recordedPackets, SizeIs(1));
+        EXPECT_THAT(recordedPackets[0].data[0], Eq(0x01));
+    }
+
+    TEST_F(RecordingConnectionTest, forwardsCalls)
+    {
+        EXPECT_CALL(conn, isOpen()).WillOnce(Return(true));
+        EXPECT_CALL(conn, name()).WillOnce(Return("recorded"));
+        EXPECT_CALL(conn, close());
+
+        EXPECT_THAT(recording.isOpen(), IsTrue());
+        EXPECT_THAT(recording.name(), Eq("recorded"));
+        recording.close();
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/ReplayConnection.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+    using std::chrono::microseconds;
+
+    class ReplayConnectionTest : public testing::Test
+    {
+    protected:
+        const std::vector<std::uint8_t> command{0x01};
+        const std::vector<RecordedPacket> recording{RecordedPacket{Direction::send, microseconds{0}, command},
+                                                    RecordedPacket{Direction::receive, microseconds{10}, {0x0a}},
+                                                    RecordedPacket{Direction::receive, microseconds{10}, {0x0b, 0x0c}},
+                                                    RecordedPacket{Direction::send, microseconds{10}, command},
+                                                    RecordedPacket{Direction::receive, microseconds{10}, {0x0d}}};
+        ReplayConnection conn{recording, ReplaySpeed::asFastAsPossible};
+    };
+
+
+    TEST_F(ReplayConnectionTest, replaysResponses)
+    {
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), ElementsAre(0x0a));
+
+        PacketRawType buffer{};
+        EXPECT_THAT(conn.receiveInto(buffer), Eq(2));
+        EXPECT_THAT(buffer[0], Eq(0x0b));
+        EXPECT_THAT(buffer[1], Eq(0x0c));
+    }
+
+    TEST_F(ReplayConnectionTest, receiveTimesOutIfSendIsExpected)
+    {
+        EXPECT_THAT(conn.receive(packetRawTypeSize), IsEmpty());
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), ElementsAre(0x0a));
+    }
+
+    TEST_F(ReplayConnectionTest, sendSkipsUnreceivedResponses)
+    {
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), ElementsAre(0x0d));
+        EXPECT_THAT(conn.finished(), IsTrue());
+    }
+
+    TEST_F(ReplayConnectionTest, exhaustedRecording)
+    {
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), ElementsAre(0x0d));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), IsEmpty());
+        EXPECT_THAT(conn.send(command), Eq(0));
+    }
+
+    TEST_F(ReplayConnectionTest, rewindRestartsReplay)
+    {
+        EXPECT_THAT(conn.send(command), Eq(1));
+        conn.close();
+        EXPECT_THAT(conn.isOpen(), IsFalse());
+
+        conn.rewind();
+        EXPECT_THAT(conn.isOpen(), IsTrue());
+        EXPECT_THAT(conn.finished(), IsFalse());
+        EXPECT_THAT(conn.send(command), Eq(1));
+        EXPECT_THAT(conn.receive(packetRawTypeSize), ElementsAre(0x0a));
+    }
+
+    TEST_F(ReplayConnectionTest, replayAtOriginalSpeedDelaysPackets)
+    {
+        ReplayConnection original{{RecordedPacket{Direction::receive, microseconds{20'000}, {0x0a}}}, ReplaySpeed::original};
+        const auto start = std::chrono::steady_clock::now();
+
+        EXPECT_THAT(original.receive(packetRawTypeSize), ElementsAre(0x0a));
+        EXPECT_THAT(std::chrono::steady_clock::now() - start, Ge(microseconds{20'000}));
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SessionRecording.h"
+#include "com/CommunicationException.h"
+#include <sstream>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+    using std::chrono::microseconds;
+
+    class SessionRecordingTest : public testing::Test
+    {
+    protected:
+        std::stringstream stream;
+    };
+
+
+    TEST_F(SessionRecordingTest, emptyRecording)
+    {
+        writeRecordingHeader(stream);
+
+        EXPECT_THAT(stream.str(), SizeIs(8));
+        EXPECT_THAT(readRecording(stream), IsEmpty());
+    }
+
+    TEST_F(SessionRecordingTest, roundTrip)
+    {
+        writeRecordingHeader(stream);
+        writeRecordedPacket(stream, RecordedPacket{Direction::send, microseconds{0}, {0x1c, 0x03, 0x05}});
+        writeRecordedPacket(stream, RecordedPacket{Direction::receive, microseconds{0x01020304}, std::vector<std::uint8_t>(packetRawTypeSize, 0xab)});
+        writeRecordedPacket(stream, RecordedPacket{Direction::receive, microseconds{500}, {}});
+
+        const auto packets = readRecording(stream);
+        ASSERT_THAT(packets, SizeIs(3));
+        EXPECT_THAT(packets[0].direction, Eq(Direction::send));
+        EXPECT_THAT(packets[0].delay, Eq(microseconds{0}));
+        EXPECT_THAT(packets[0].data, ElementsAre(0x1c, 0x03, 0x05));
+        EXPECT_THAT(packets[1].direction, Eq(Direction::receive));
+        EXPECT_THAT(packets[1].delay, Eq(microseconds{0x01020304}));
+        EXPECT_THAT(packets[1].data, Eq(std::vector<std::uint8_t>(packetRawTypeSize, 0xab)));
+        EXPECT_THAT(packets[2].delay, Eq(microseconds{500}));
+        EXPECT_THAT(packets[2].data, IsEmpty());
+    }
+
+    TEST_F(SessionRecordingTest, packetEncoding)
+    {
+        writeRecordedPacket(stream, RecordedPacket{Direction::receive, microseconds{0x0201}, {0xaa}});
+
+        EXPECT_THAT(stream.str(), Eq(std::string{'\x01', '\x01', '\x02', '\x00', '\x00', '\x01', '\xaa'}));
+    }
+
+    TEST_F(SessionRecordingTest, delayIsLimited)
+    {
+        writeRecordingHeader(stream);
+        writeRecordedPacket(stream, RecordedPacket{Direction::send, microseconds{0x1'0000'0000}, {}});
+
+        EXPECT_THAT(readRecording(stream)[0].delay, Eq(microseconds{0xffff'ffff}));
+    }
+
+    TEST_F(SessionRecordingTest, readThrowsOnInvalidHeader)
+    {
+        stream << "NOTPLUG";
+
+        EXPECT_THROW(readRecording(stream), CommunicationException);
+    }
+
+    TEST_F(SessionRecordingTest, readThrowsOnTruncatedPacket)
+    {
+        writeRecordingHeader(stream);
+        writeRecordedPacket(stream, RecordedPacket{Direction::send, microseconds{0}, {0x01, 0x02}});
+        const auto data = stream.str();
+        std::istringstream truncated{data.substr(0, data.size() - 1)};
+
+        EXPECT_THROW(readRecording(truncated), CommunicationException);
+    }
+}
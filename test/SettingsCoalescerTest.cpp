@@ -0,0 +1,188 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SettingsCoalescer.h"
+#include "com/Mustang.h"
+#include "com/PacketSerializer.h"
+#include "mocks/MockConnection.h"
+#include "matcher/Matcher.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::test::matcher;
+    using namespace plug::com;
+    using namespace testing;
+    using namespace std::chrono_literals;
+
+
+    class SettingsCoalescerTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            conn = std::make_shared<NiceMock<mock::MockConnection>>();
+            m = std::make_unique<com::Mustang>(DeviceModel{"Test Device", DeviceModel::Category::MustangV1, 100}, conn);
+            ON_CALL(*conn, sendImpl(_, _)).WillByDefault(Return(packetRawTypeSize));
+            ON_CALL(*conn, receive(_)).WillByDefault(Return(std::vector<std::uint8_t>(packetRawTypeSize)));
+        }
+
+        [[nodiscard]] static amp_settings createAmpSettings(std::uint8_t gain)
+        {
+            return amp_settings{amps::BRITISH_70S, gain, 9, 1, 2, 3, cabinets::cab4x12G, 3, 5, 3, 2, 1, 4, 1, 5, true, 4};
+        }
+
+        std::shared_ptr<NiceMock<mock::MockConnection>> conn;
+        std::unique_ptr<com::Mustang> m;
+        const SettingsCoalescer::Clock::time_point start{};
+    };
+
+    TEST_F(SettingsCoalescerTest, nothingPendingInitially)
+    {
+        SettingsCoalescer coalescer{20ms};
+        EXPECT_FALSE(coalescer.hasPending());
+        EXPECT_THAT(coalescer.timeUntilFlush(start), Eq(SettingsCoalescer::Clock::duration::zero()));
+    }
+
+    TEST_F(SettingsCoalescerTest, takeKeepsOnlyLatestAmpSettings)
+    {
+        const auto latest = serializeAmpSettings(createAmpSettings(30)).getBytes();
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(createAmpSettings(10));
+        coalescer.update(createAmpSettings(20));
+        coalescer.update(createAmpSettings(30));
+        EXPECT_TRUE(coalescer.hasPending());
+
+        const auto stale0 = serializeAmpSettings(createAmpSettings(10)).getBytes();
+        const auto stale1 = serializeAmpSettings(createAmpSettings(20)).getBytes();
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*conn, sendImpl(BufferIs(stale0), stale0.size())).Times(0);
+        EXPECT_CALL(*conn, sendImpl(BufferIs(stale1), stale1.size())).Times(0);
+        EXPECT_CALL(*conn, sendImpl(BufferIs(latest), latest.size()));
+        sendSettings(*m, coalescer.take(start));
+
+        EXPECT_FALSE(coalescer.hasPending());
+    }
+
+    TEST_F(SettingsCoalescerTest, takeKeepsLatestSettingsPerEffectSlot)
+    {
+        const fx_pedal_settings slot0{FxSlot{0}, effects::OVERDRIVE, 1, 2, 3, 4, 5, 6};
+        const fx_pedal_settings slot1{FxSlot{1}, effects::SINE_CHORUS, 1, 2, 3, 4, 5, 6};
+        const auto data0 = serializeEffectSettings(slot0).getBytes();
+        const auto data1 = serializeEffectSettings(slot1).getBytes();
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(fx_pedal_settings{FxSlot{0}, effects::OVERDRIVE, 9, 9, 9, 9, 9, 9});
+        coalescer.update(slot1);
+        coalescer.update(slot0);
+
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*conn, sendImpl(BufferIs(data0), data0.size()));
+        EXPECT_CALL(*conn, sendImpl(BufferIs(data1), data1.size()));
+        sendSettings(*m, coalescer.take(start));
+    }
+
+    TEST_F(SettingsCoalescerTest, effectMovedBetweenSlotsIsSentInUpdateOrder)
+    {
+        const fx_pedal_settings cleared{FxSlot{5}, effects::SINE_CHORUS, 0, 0, 0, 0, 0, 0, false};
+        const fx_pedal_settings moved{FxSlot{1}, effects::SINE_CHORUS, 1, 2, 3, 4, 5, 6, true};
+        const auto clearData = serializeClearEffectSettings(cleared).getBytes();
+        const auto movedData = serializeEffectSettings(moved).getBytes();
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(fx_pedal_settings{FxSlot{5}, effects::SINE_CHORUS, 9, 9, 9, 9, 9, 9});
+        coalescer.update(cleared);
+        coalescer.update(moved);
+
+        std::vector<PacketRawType> sent;
+        EXPECT_CALL(*conn, sendImpl(_, _)).WillRepeatedly([&sent](const std::uint8_t* data, std::size_t size)
+                                                          {
+            PacketRawType packet{};
+            std::copy_n(data, packet.size(), packet.begin());
+            sent.push_back(packet);
+            return size; });
+        sendSettings(*m, coalescer.take(start));
+
+        // Clearing the old slot after the move would clear the moved effect, both use the same DSP
+        const auto lastClear = std::find(sent.crbegin(), sent.crend(), clearData);
+        const auto moveAt = std::find(sent.crbegin(), sent.crend(), movedData);
+        ASSERT_THAT(lastClear, Ne(sent.crend()));
+        ASSERT_THAT(moveAt, Ne(sent.crend()));
+        EXPECT_THAT(moveAt, Lt(lastClear));
+    }
+
+    TEST_F(SettingsCoalescerTest, nextFlushIsRateLimited)
+    {
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(createAmpSettings(10));
+        sendSettings(*m, coalescer.take(start));
+
+        coalescer.update(createAmpSettings(20));
+        EXPECT_THAT(coalescer.timeUntilFlush(start + 5ms), Eq(15ms));
+        EXPECT_THAT(coalescer.timeUntilFlush(start + 20ms), Eq(SettingsCoalescer::Clock::duration::zero()));
+        EXPECT_THAT(coalescer.timeUntilFlush(start + 50ms), Eq(SettingsCoalescer::Clock::duration::zero()));
+    }
+
+    TEST_F(SettingsCoalescerTest, takeAfterIntervalReturnsFinalValue)
+    {
+        const auto latest = serializeAmpSettings(createAmpSettings(30)).getBytes();
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(createAmpSettings(10));
+        sendSettings(*m, coalescer.take(start));
+        coalescer.update(createAmpSettings(20));
+        coalescer.update(createAmpSettings(30));
+
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*conn, sendImpl(BufferIs(latest), latest.size()));
+        sendSettings(*m, coalescer.take(start + 20ms));
+        EXPECT_FALSE(coalescer.hasPending());
+    }
+
+    TEST_F(SettingsCoalescerTest, sendWithoutPendingSettingsSendsNothing)
+    {
+        SettingsCoalescer coalescer{20ms};
+
+        EXPECT_CALL(*conn, sendImpl(_, _)).Times(0);
+        sendSettings(*m, coalescer.take(start));
+    }
+
+    TEST_F(SettingsCoalescerTest, takeReturnsAndClearsPendingSettings)
+    {
+        const fx_pedal_settings effect{FxSlot{2}, effects::OVERDRIVE, 1, 2, 3, 4, 5, 6};
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(createAmpSettings(10));
+        coalescer.update(effect);
+
+        const auto pending = coalescer.take(start);
+        EXPECT_TRUE(pending.amp.has_value());
+        ASSERT_THAT(pending.effects, SizeIs(1));
+        EXPECT_THAT(pending.effects[0].slot.id(), Eq(2));
+        EXPECT_FALSE(coalescer.hasPending());
+        EXPECT_THAT(coalescer.timeUntilFlush(start), Eq(20ms));
+    }
+
+    TEST_F(SettingsCoalescerTest, discardDropsPendingSettings)
+    {
+        SettingsCoalescer coalescer{20ms};
+        coalescer.update(createAmpSettings(10));
+        coalescer.update(fx_pedal_settings{FxSlot{3}, effects::OVERDRIVE, 1, 2, 3, 4, 5, 6});
+        coalescer.discard();
+
+        EXPECT_FALSE(coalescer.hasPending());
+    }
+}
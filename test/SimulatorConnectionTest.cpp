@@ -0,0 +1,122 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SimulatorConnection.h"
+#include "com/Mustang.h"
+#include "com/PacketSerializer.h"
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class SimulatorConnectionTest : public testing::Test
+    {
+    protected:
+        std::shared_ptr<SimulatorConnection> conn = std::make_shared<SimulatorConnection>(24, std::chrono::microseconds{0});
+        Mustang mustang{DeviceModel{"Simulator", DeviceModel::Category::MustangV1, 24}, conn};
+    };
+
+
+    TEST_F(SimulatorConnectionTest, startAmpLoadsPresetsAndCurrentState)
+    {
+        const auto [signalChain, presetNames] = mustang.start_amp();
+
+        EXPECT_THAT(presetNames, SizeIs(24));
+        EXPECT_THAT(presetNames[0], Eq("Preset 1"));
+        EXPECT_THAT(presetNames[23], Eq("Preset 24"));
+        EXPECT_THAT(signalChain.name(), Eq("Preset 1"));
+        EXPECT_THAT(signalChain.effects(), SizeIs(4));
+    }
+
+    TEST_F(SimulatorConnectionTest, startAmpConsumesWholeTransmission)
+    {
+        mustang.start_amp();
+
+        PacketRawType packet{};
+        EXPECT_THAT(conn->receiveInto(packet), Eq(0));
+    }
+
+    TEST_F(SimulatorConnectionTest, loadMemoryBank)
+    {
+        const auto bank = mustang.load_memory_bank(3);
+
+        EXPECT_THAT(bank.name(), Eq("Preset 4"));
+        EXPECT_THAT(bank.amp().amp_num, Eq(amps::FENDER_65_DELUXE_REVERB));
+        EXPECT_THAT(bank.amp().gain, Eq(3));
+    }
+
+    TEST_F(SimulatorConnectionTest, appliedSettingsAreSavedOnAmp)
+    {
+        amp_settings amp{};
+        amp.amp_num = amps::BRITISH_80S;
+        amp.volume = 0x12;
+        const fx_pedal_settings effect{FxSlot{1}, effects::SINE_FLANGER, 1, 2, 3, 0, 0, 0, true};
+
+        mustang.set_amplifier(amp);
+        mustang.set_effect(effect);
+        mustang.save_on_amp("saved", 7);
+        mustang.load_memory_bank(0);
+        const auto bank = mustang.load_memory_bank(7);
+
+        EXPECT_THAT(bank.name(), Eq("saved"));
+        EXPECT_THAT(bank.amp().amp_num, Eq(amps::BRITISH_80S));
+        EXPECT_THAT(bank.amp().volume, Eq(0x12));
+        EXPECT_THAT(bank.effects()[1].effect_num, Eq(effects::SINE_FLANGER));
+        EXPECT_THAT(bank.effects()[1].knob3, Eq(3));
+    }
+
+    TEST_F(SimulatorConnectionTest, settingsAreNotAppliedWithoutApplyCommand)
+    {
+        amp_settings amp{};
+        amp.amp_num = amps::BRITISH_80S;
+        conn->send(serializeAmpSettings(amp).getBytes());
+        mustang.save_on_amp("saved", 1);
+
+        EXPECT_THAT(mustang.load_memory_bank(1).amp().amp_num, Eq(amps::FENDER_57_DELUXE));
+    }
+
+    TEST_F(SimulatorConnectionTest, invalidSlotIsConfirmedOnly)
+    {
+        conn->send(serializeLoadSlotCommand(30).getBytes());
+
+        PacketRawType packet{};
+        EXPECT_THAT(conn->receiveInto(packet), Eq(packetRawTypeSize));
+        EXPECT_THAT(conn->receiveInto(packet), Eq(0));
+    }
+
+    TEST_F(SimulatorConnectionTest, unknownPacketsAreIgnored)
+    {
+        EXPECT_THAT(conn->send(PacketRawType{{0x1c, 0x77}}), Eq(packetRawTypeSize));
+
+        PacketRawType packet{};
+        EXPECT_THAT(conn->receiveInto(packet), Eq(0));
+    }
+
+    TEST_F(SimulatorConnectionTest, closedSimulatorDoesNotReceive)
+    {
+        EXPECT_THAT(conn->isOpen(), IsTrue());
+        mustang.stop_amp();
+
+        EXPECT_THAT(conn->isOpen(), IsFalse());
+        EXPECT_THAT(conn->send(serializeLoadCommand().getBytes()), Eq(0));
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/SpscQueue.h"
+#include <memory>
+#include <thread>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class SpscQueueTest : public testing::Test
+    {
+    };
+
+
+    TEST_F(SpscQueueTest, emptyInitially)
+    {
+        SpscQueue<int, 4> queue;
+        EXPECT_TRUE(queue.empty());
+        EXPECT_THAT(queue.tryPop(), Eq(std::nullopt));
+    }
+
+    TEST_F(SpscQueueTest, popReturnsValuesInOrder)
+    {
+        SpscQueue<int, 4> queue;
+        EXPECT_TRUE(queue.tryPush(1));
+        EXPECT_TRUE(queue.tryPush(2));
+        EXPECT_TRUE(queue.tryPush(3));
+        EXPECT_FALSE(queue.empty());
+
+        EXPECT_THAT(queue.tryPop(), Optional(1));
+        EXPECT_THAT(queue.tryPop(), Optional(2));
+        EXPECT_THAT(queue.tryPop(), Optional(3));
+        EXPECT_TRUE(queue.empty());
+    }
+
+    TEST_F(SpscQueueTest, pushFailsIfFull)
+    {
+        SpscQueue<int, 2> queue;
+        EXPECT_TRUE(queue.tryPush(1));
+        EXPECT_TRUE(queue.tryPush(2));
+        EXPECT_FALSE(queue.tryPush(3));
+
+        EXPECT_THAT(queue.tryPop(), Optional(1));
+        EXPECT_TRUE(queue.tryPush(3));
+        EXPECT_THAT(queue.tryPop(), Optional(2));
+        EXPECT_THAT(queue.tryPop(), Optional(3));
+    }
+
+    TEST_F(SpscQueueTest, popReleasesValue)
+    {
+        auto value = std::make_shared<int>(5);
+        SpscQueue<std::shared_ptr<int>, 2> queue;
+        queue.tryPush(value);
+        queue.tryPop();
+
+        EXPECT_THAT(value.use_count(), Eq(1));
+    }
+
+    TEST_F(SpscQueueTest, transfersValuesBetweenThreads)
+    {
+        constexpr int count{10000};
+        SpscQueue<int, 16> queue;
+
+        std::thread producer{[&queue]
+                             {
+                                 for (int i = 0; i < count; ++i)
+                                 {
+                                     while (queue.tryPush(i) == false)
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                 }
+                             }};
+
+        bool inOrder{true};
+        for (int expected = 0; expected < count;)
+        {
+            if (const auto value = queue.tryPop(); value.has_value())
+            {
+                inOrder = inOrder && (*value == expected);
+                ++expected;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        EXPECT_TRUE(inOrder);
+        EXPECT_TRUE(queue.empty());
+    }
+}
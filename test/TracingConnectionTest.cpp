@@ -0,0 +1,208 @@
+/*
+ * PLUG - software to operate Fender Mustang amplifier
+ *        Linux replacement for Fender FUSE software
+ *
+ * Copyright (C) 2017-2026  offa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/TracingConnection.h"
+#include "com/Mustang.h"
+#include "com/PacketSerializer.h"
+#include "com/CommunicationException.h"
+#include "mocks/MockConnection.h"
+#include <sstream>
+#include <gmock/gmock.h>
+
+namespace plug::test
+{
+    using namespace plug::com;
+    using namespace testing;
+
+    class TracingConnectionTest : public testing::Test
+    {
+    protected:
+        std::shared_ptr<mock::MockConnection> inner = std::make_shared<mock::MockConnection>();
+        mock::MockConnection& conn = *inner;
+        TracingConnection tracing{inner, 8};
+        const PacketRawType packet = serializeAmpSettings(amp_settings{}).getBytes();
+    };
+
+
+    TEST_F(TracingConnectionTest, forwardsCalls)
+    {
+        EXPECT_CALL(conn, isOpen()).WillOnce(Return(true));
+        EXPECT_CALL(conn, name()).WillOnce(Return("traced"));
+        EXPECT_CALL(conn, close());
+
+        EXPECT_THAT(tracing.isOpen(), IsTrue());
+        EXPECT_THAT(tracing.name(), Eq("traced"));
+        tracing.close();
+    }
+
+    TEST_F(TracingConnectionTest, recordsSendWithDecodedHeader)
+    {
+        EXPECT_CALL(conn, sendImpl(packet.data(), packet.size())).WillOnce(Return(packet.size()));
+
+        EXPECT_THAT(tracing.send(packet), Eq(packet.size()));
+
+        const auto events = tracing.events();
+        ASSERT_THAT(events, SizeIs(1));
+        EXPECT_THAT(events[0].direction, Eq(Direction::send));
+        EXPECT_THAT(events[0].bytes, Eq(packet.size()));
+        EXPECT_THAT(events[0].timeout, IsFalse());
+        EXPECT_THAT(events[0].operation, Eq(std::nullopt));
+        ASSERT_THAT(events[0].header, Ne(std::nullopt));
+        EXPECT_THAT(events[0].header->stage, Eq(Stage::ready));
+        EXPECT_THAT(events[0].header->type, Eq(Type::data));
+        EXPECT_THAT(events[0].header->dsp, Eq(DSP::amp));
+    }
+
+    TEST_F(TracingConnectionTest, recordsReceiveTimeout)
+    {
+        EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(std::vector<std::uint8_t>{}));
+
+        PacketRawType buffer{};
+        EXPECT_THAT(tracing.receiveInto(buffer), Eq(0));
+
+        const auto events = tracing.events();
+        ASSERT_THAT(events, SizeIs(1));
+        EXPECT_THAT(events[0].direction, Eq(Direction::receive));
+        EXPECT_THAT(events[0].timeout, IsTrue());
+        EXPECT_THAT(events[0].header, Eq(std::nullopt));
+        EXPECT_THAT(tracing.statistics(Direction::receive).failures, Eq(1));
+    }
+
+    TEST_F(TracingConnectionTest, invalidHeaderFieldsAreNotDecoded)
+    {
+        const std::vector<std::uint8_t> data(packetRawTypeSize, 0xff);
+        EXPECT_CALL(conn, receive(packetRawTypeSize)).WillOnce(Return(data));
+
+        EXPECT_THAT(tracing.receive(packetRawTypeSize), Eq(data));
+
+        const auto events = tracing.events();
+        ASSERT_THAT(events, SizeIs(1));
+        ASSERT_THAT(events[0].header, Ne(std::nullopt));
+        EXPECT_THAT(events[0].header->stage, Eq(Stage::unknown));
+        EXPECT_THAT(events[0].header->type, Eq(std::nullopt));
+        EXPECT_THAT(events[0].header->dsp, Eq(std::nullopt));
+        EXPECT_THAT(events[0].header->slot, Eq(0xff));
+    }
+
+    TEST_F(TracingConnectionTest, keepsLastEventsOnly)
+    {
+        EXPECT_CALL(conn, sendImpl(_, _)).WillRepeatedly(Return(packetRawTypeSize));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            tracing.send(packet);
+        }
+
+        EXPECT_THAT(tracing.events(), SizeIs(8));
+        EXPECT_THAT(tracing.statistics(Direction::send).count, Eq(10));
+    }
+
+    TEST_F(TracingConnectionTest, batchIsRecordedAsSingleEvent)
+    {
+        const std::array<PacketRawType, 2> packets{{packet, packet}};
+        EXPECT_CALL(conn, sendImpl(_, packetRawTypeSize)).WillOnce(Return(packetRawTypeSize)).WillOnce(Return(0));
+
+        EXPECT_THAT(tracing.sendBatch(packets), Eq(1));
+
+        const auto events = tracing.events();
+        ASSERT_THAT(events, SizeIs(1));
+        EXPECT_THAT(events[0].packets, Eq(2));
+        EXPECT_THAT(events[0].bytes, Eq(packetRawTypeSize));
+        EXPECT_THAT(events[0].timeout, IsTrue());
+    }
+
+    TEST_F(TracingConnectionTest, tracesOperations)
+    {
+        {
+            const OperationScope scope{&tracing, Operation::setEffect};
+            EXPECT_CALL(conn, sendImpl(_, _)).WillOnce(Return(packetRawTypeSize));
+            tracing.send(packet);
+        }
+
+        EXPECT_THAT(tracing.events()[0].operation, Eq(Operation::setEffect));
+        EXPECT_THAT(tracing.statistics(Operation::setEffect).count, Eq(1));
+        EXPECT_THAT(tracing.statistics(Operation::setEffect).failures, Eq(0));
+        EXPECT_THAT(tracing.statistics(Operation::setAmplifier).count, Eq(0));
+    }
+
+    TEST_F(TracingConnectionTest, nestedOperationsAttributeTrafficToInnermost)
+    {
+        EXPECT_CALL(conn, sendImpl(_, _)).WillRepeatedly(Return(packetRawTypeSize));
+        {
+            const OperationScope outerScope{&tracing, Operation::startAmp};
+            {
+                const OperationScope innerScope{&tracing, Operation::loadMemoryBank};
+                tracing.send(packet);
+            }
+            tracing.send(packet);
+        }
+        tracing.send(packet);
+
+        const auto events = tracing.events();
+        ASSERT_THAT(events, SizeIs(3));
+        EXPECT_THAT(events[0].operation, Eq(Operation::loadMemoryBank));
+        EXPECT_THAT(events[1].operation, Eq(Operation::startAmp));
+        EXPECT_THAT(events[2].operation, Eq(std::nullopt));
+        EXPECT_THAT(tracing.statistics(Operation::startAmp).count, Eq(1));
+        EXPECT_THAT(tracing.statistics(Operation::loadMemoryBank).count, Eq(1));
+    }
+
+    TEST_F(TracingConnectionTest, operationLeftByExceptionCountsAsFailed)
+    {
+        try
+        {
+            const OperationScope scope{&tracing, Operation::loadMemoryBank};
+            throw CommunicationException{"failed"};
+        }
+        catch (const CommunicationException&)
+        {
+        }
+
+        EXPECT_THAT(tracing.statistics(Operation::loadMemoryBank).count, Eq(1));
+        EXPECT_THAT(tracing.statistics(Operation::loadMemoryBank).failures, Eq(1));
+    }
+
+    TEST_F(TracingConnectionTest, mustangOperationsAreTraced)
+    {
+        EXPECT_CALL(conn, sendImpl(_, _)).WillRepeatedly(Return(packetRawTypeSize));
+        EXPECT_CALL(conn, receive(_)).WillRepeatedly(Return(std::vector<std::uint8_t>(packetRawTypeSize, 0x00)));
+
+        auto traced = std::make_shared<TracingConnection>(inner, 0);
+        Mustang tracedMustang{DeviceModel{"Traced", DeviceModel::Category::MustangV1, 100}, traced, traced};
+        tracedMustang.set_amplifier(amp_settings{});
+
+        EXPECT_THAT(traced->statistics(Operation::setAmplifier).count, Eq(1));
+        EXPECT_THAT(traced->statistics(Direction::send).count, Eq(1));
+        EXPECT_THAT(traced->statistics(Direction::receive).count, Eq(4));
+    }
+
+    TEST_F(TracingConnectionTest, dumpListsOperations)
+    {
+        EXPECT_CALL(conn, name()).WillOnce(Return("traced"));
+        std::ostringstream out;
+
+        tracing.dump(out);
+
+        EXPECT_THAT(out.str(), HasSubstr("Connection trace (traced)"));
+        EXPECT_THAT(out.str(), HasSubstr("set_effect"));
+        EXPECT_THAT(out.str(), HasSubstr("load_memory_bank"));
+        EXPECT_THAT(out.str(), HasSubstr("receive"));
+    }
+}
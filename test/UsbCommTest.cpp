@@ -23,11 +23,14 @@
 #include "mocks/UsbDeviceMock.h"
 #include "matcher/Matcher.h"
 #include <array>
+#include <future>
 #include <gmock/gmock.h>
 
 namespace plug::test
 {
+    using plug::com::PacketRawType;
     using plug::com::UsbComm;
+    using plug::com::packetRawTypeSize;
     using plug::com::usb::Device;
     using namespace plug::test::matcher;
     using namespace testing;
@@ -50,12 +53,20 @@ namespace plug::test
             return UsbComm{Device{nullptr}};
         }
 
+        static std::future<std::size_t> readyFuture(std::size_t value)
+        {
+            std::promise<std::size_t> result;
+            result.set_value(value);
+            return result.get_future();
+        }
+
         mock::UsbDeviceMock* deviceMock{nullptr};
     };
 
     TEST_F(UsbCommTest, ctorOpensDevice)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name());
         UsbComm com{Device{nullptr}};
     }
@@ -63,6 +74,7 @@ namespace plug::test
     TEST_F(UsbCommTest, closeClosesDevice)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name());
         EXPECT_CALL(*deviceMock, close());
 
@@ -73,6 +85,7 @@ namespace plug::test
     TEST_F(UsbCommTest, isOpenReturnDeviceState)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name());
 
         UsbComm com = create();
@@ -85,19 +98,107 @@ namespace plug::test
     TEST_F(UsbCommTest, sendSendsData)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name());
 
         const std::array<std::uint8_t, 4> data{{0x00, 0xa1, 0xb2, 0xb3}};
-        EXPECT_CALL(*deviceMock, write(0x01, BufferIs(data), data.size())).WillOnce(Return(data.size()));
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, BufferIs(data), data.size())).WillOnce([](auto, auto, std::size_t size)
+                                                                                       {
+            std::promise<std::size_t> result;
+            result.set_value(size);
+            return result.get_future(); });
 
         UsbComm com = create();
         const auto n = com.send(data);
         EXPECT_THAT(n, Eq(4));
     }
 
+    TEST_F(UsbCommTest, sendThrowsOnFailedTransfer)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        const std::array<std::uint8_t, 2> data{{0x00, 0xa1}};
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, _, data.size())).WillOnce([](auto, auto, auto)
+                                                                            {
+            std::promise<std::size_t> result;
+            result.set_exception(std::make_exception_ptr(std::runtime_error{"transfer failed"}));
+            return result.get_future(); });
+
+        UsbComm com = create();
+        EXPECT_THROW(com.send(data), std::runtime_error);
+    }
+
+    TEST_F(UsbCommTest, sendPassesDataWithoutCopy)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        const std::array<std::uint8_t, 3> data{{0x00, 0xa1, 0xb2}};
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, data.data(), data.size())).WillOnce([](auto, auto, std::size_t size)
+                                                                                      {
+            std::promise<std::size_t> result;
+            result.set_value(size);
+            return result.get_future(); });
+
+        UsbComm com = create();
+        EXPECT_THAT(com.send(data), Eq(data.size()));
+    }
+
+    TEST_F(UsbCommTest, sendBatchSubmitsAllPackets)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        const std::array<PacketRawType, 3> packets{};
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, packets[0].data(), packetRawTypeSize)).WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))));
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, packets[1].data(), packetRawTypeSize)).WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))));
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, packets[2].data(), packetRawTypeSize)).WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))));
+
+        UsbComm com = create();
+        EXPECT_THAT(com.sendBatch(packets), Eq(3));
+    }
+
+    TEST_F(UsbCommTest, sendBatchCountsPacketsUntilIncompleteTransfer)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        const std::array<PacketRawType, 3> packets{};
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, _, packetRawTypeSize))
+            .WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))))
+            .WillOnce(Return(ByMove(readyFuture(10))))
+            .WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))));
+
+        UsbComm com = create();
+        EXPECT_THAT(com.sendBatch(packets), Eq(1));
+    }
+
+    TEST_F(UsbCommTest, sendBatchThrowsOnFailedTransfer)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        const std::array<PacketRawType, 2> packets{};
+        std::promise<std::size_t> failed;
+        failed.set_exception(std::make_exception_ptr(std::runtime_error{"transfer failed"}));
+        EXPECT_CALL(*deviceMock, writeAsync(0x01, _, packetRawTypeSize))
+            .WillOnce(Return(ByMove(failed.get_future())))
+            .WillOnce(Return(ByMove(readyFuture(packetRawTypeSize))));
+
+        UsbComm com = create();
+        EXPECT_THROW(com.sendBatch(packets), std::runtime_error);
+    }
+
     TEST_F(UsbCommTest, receiveReceivesData)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name());
 
         std::vector<std::uint8_t> data{{0x00, 0xa1, 0xb2, 0xb3, 0xc4}};
@@ -108,9 +209,29 @@ namespace plug::test
         EXPECT_THAT(received, Eq(data));
     }
 
+    TEST_F(UsbCommTest, receiveIntoReceivesDataIntoBuffer)
+    {
+        EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
+        EXPECT_CALL(*deviceMock, name());
+
+        std::array<std::uint8_t, 64> buffer{};
+        EXPECT_CALL(*deviceMock, receiveInto(0x81, _)).WillOnce([](std::uint8_t, std::span<std::uint8_t> data)
+                                                                 {
+            data[0] = 0xa1;
+            data[1] = 0xb2;
+            return std::size_t{2}; });
+
+        UsbComm com = create();
+        EXPECT_THAT(com.receiveInto(buffer), Eq(2));
+        EXPECT_THAT(buffer[0], Eq(0xa1));
+        EXPECT_THAT(buffer[1], Eq(0xb2));
+    }
+
     TEST_F(UsbCommTest, modelName)
     {
         EXPECT_CALL(*deviceMock, open());
+        EXPECT_CALL(*deviceMock, startReceiving(0x81, 64));
         EXPECT_CALL(*deviceMock, name()).WillOnce(Return("USB Device Name"));
 
         UsbComm com = create();
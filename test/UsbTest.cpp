@@ -20,8 +20,11 @@
 
 #include "com/UsbContext.h"
 #include "com/UsbException.h"
+#include "com/UsbHotplug.h"
 #include "mocks/LibUsbMocks.h"
 #include <array>
+#include <future>
+#include <memory>
 #include <libusb-1.0/libusb.h>
 #include <gmock/gmock.h>
 
@@ -50,7 +53,51 @@ namespace plug::test
             mock::clearUsbMock();
         }
 
+        libusb_transfer* allocateTransfer()
+        {
+            transfers.push_back(std::make_unique<libusb_transfer>());
+            return transfers.back().get();
+        }
+
+        void completeTransfer(libusb_transfer* transfer, libusb_transfer_status status, const std::vector<std::uint8_t>& data = {})
+        {
+            std::copy(data.cbegin(), data.cend(), transfer->buffer);
+            transfer->actual_length = static_cast<int>(data.size());
+            transfer->status = status;
+            transfer->callback(transfer);
+        }
+
+        void expectOpenAndClose()
+        {
+            EXPECT_CALL(*usbmock, ref_device(_)).WillOnce(Return(&dev));
+            EXPECT_CALL(*usbmock, get_device_descriptor(_, _)).WillOnce(DoAll(SetArgPointee<1>(libusb_device_descriptor{}), Return(LIBUSB_SUCCESS)));
+            EXPECT_CALL(*usbmock, unref_device(_));
+            EXPECT_CALL(*usbmock, open(_, _))
+                .WillOnce(DoAll(SetArgPointee<1>(handle), Return(LIBUSB_SUCCESS)));
+            EXPECT_CALL(*usbmock, set_auto_detach_kernel_driver(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
+            EXPECT_CALL(*usbmock, claim_interface(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
+            EXPECT_CALL(*usbmock, release_interface(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
+            EXPECT_CALL(*usbmock, close(_));
+        }
+
+        void expectReceiveTransfers()
+        {
+            EXPECT_CALL(*usbmock, alloc_transfer(0)).Times(4).WillRepeatedly(InvokeWithoutArgs([this]
+                                                                                               { return allocateTransfer(); }));
+            EXPECT_CALL(*usbmock, cancel_transfer(NotNull())).Times(4).WillRepeatedly([this](libusb_transfer* transfer)
+                                                                                      {
+                if (transfer->status != LIBUSB_TRANSFER_COMPLETED)
+                {
+                    return static_cast<int>(LIBUSB_ERROR_NOT_FOUND);
+                }
+                completeTransfer(transfer, LIBUSB_TRANSFER_CANCELLED);
+                return static_cast<int>(LIBUSB_SUCCESS); });
+            EXPECT_CALL(*usbmock, free_transfer(NotNull())).Times(4);
+        }
+
+
         mock::UsbMock* usbmock{nullptr};
+        std::vector<std::unique_ptr<libusb_transfer>> transfers;
         libusb_device dev;
         libusb_device_handle dummy;
         libusb_device_handle* handle{&dummy};
@@ -59,6 +106,8 @@ namespace plug::test
     TEST_F(UsbTest, contextCtorInitializesDefaultContext)
     {
         EXPECT_CALL(*usbmock, init(nullptr)).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, handle_events_timeout_completed(_, _, _)).WillRepeatedly(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, interrupt_event_handler(_));
         EXPECT_CALL(*usbmock, exit(_));
 
         Context context;
@@ -76,11 +125,29 @@ namespace plug::test
     TEST_F(UsbTest, contextDtorDeinitializesDefaultContext)
     {
         EXPECT_CALL(*usbmock, init(_)).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, handle_events_timeout_completed(_, _, _)).WillRepeatedly(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, interrupt_event_handler(_));
         EXPECT_CALL(*usbmock, exit(nullptr));
 
         Context ctx{};
     }
 
+    TEST_F(UsbTest, contextHandlesEventsOfDefaultContext)
+    {
+        std::promise<void> eventsHandled;
+        EXPECT_CALL(*usbmock, init(_)).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, handle_events_timeout_completed(nullptr, NotNull(), _))
+            .WillOnce(DoAll(InvokeWithoutArgs([&eventsHandled]
+                                              { eventsHandled.set_value(); }),
+                            Return(LIBUSB_SUCCESS)))
+            .WillRepeatedly(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, interrupt_event_handler(nullptr));
+        EXPECT_CALL(*usbmock, exit(_));
+
+        Context ctx{};
+        eventsHandled.get_future().wait();
+    }
+
     TEST_F(UsbTest, exceptionContainsErrorInformation)
     {
         EXPECT_CALL(*usbmock, error_name(_)).WillOnce(Return("name___LIBUSB_ERROR_NO_DEVICE"));
@@ -183,6 +250,94 @@ namespace plug::test
         EXPECT_THAT(devices[0].vendorId(), Eq(0x1234));
     }
 
+    TEST_F(UsbTest, listDevicesWithFilterOnlyReferencesMatchingDevices)
+    {
+        libusb_device device0;
+        libusb_device device1;
+        libusb_device device2;
+        std::array<libusb_device*, 3> deviceList{&device0, &device1, &device2};
+        EXPECT_CALL(*usbmock, get_device_list(nullptr, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(deviceList.data()), Return(deviceList.size())));
+        libusb_device_descriptor match{};
+        match.idVendor = 0x1ed8;
+        match.idProduct = 0x0005;
+        libusb_device_descriptor other{};
+        other.idVendor = 0x0ff0;
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device0, NotNull())).WillOnce(DoAll(SetArgPointee<1>(other), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device1, NotNull())).WillOnce(DoAll(SetArgPointee<1>(match), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device2, NotNull())).WillOnce(DoAll(SetArgPointee<1>(other), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, ref_device(&device1)).WillOnce(Return(&device1));
+        EXPECT_CALL(*usbmock, unref_device(&device1));
+        EXPECT_CALL(*usbmock, free_device_list(deviceList.data(), 1));
+
+        const auto devices = listDevices([](std::uint16_t vid, std::uint16_t)
+                                         { return vid == 0x1ed8; });
+        ASSERT_THAT(devices, SizeIs(1));
+        EXPECT_THAT(devices[0].productId(), Eq(0x0005));
+    }
+
+    TEST_F(UsbTest, listDevicesWithFilterSkipsFailingDescriptorWithoutError)
+    {
+        std::array<libusb_device*, 1> deviceList{&dev};
+        EXPECT_CALL(*usbmock, get_device_list(nullptr, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(deviceList.data()), Return(deviceList.size())));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&dev, NotNull())).WillOnce(Return(LIBUSB_ERROR_ACCESS));
+        EXPECT_CALL(*usbmock, error_name(_)).Times(0);
+        EXPECT_CALL(*usbmock, ref_device(_)).Times(0);
+        EXPECT_CALL(*usbmock, free_device_list(_, 1));
+
+        EXPECT_THAT(listDevices([](std::uint16_t, std::uint16_t)
+                                { return true; }),
+                    IsEmpty());
+    }
+
+    TEST_F(UsbTest, listDevicesWithFilterThrowsOnDeviceListError)
+    {
+        EXPECT_CALL(*usbmock, error_name(_)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(_)).WillOnce(Return("ignore_message"));
+        EXPECT_CALL(*usbmock, get_device_list(_, _)).WillOnce(Return(LIBUSB_ERROR_NO_MEM));
+
+        EXPECT_THROW(listDevices([](std::uint16_t, std::uint16_t)
+                                 { return true; }),
+                     UsbException);
+    }
+
+    TEST_F(UsbTest, findDeviceStopsAtFirstMatch)
+    {
+        libusb_device device0;
+        libusb_device device1;
+        libusb_device device2;
+        std::array<libusb_device*, 3> deviceList{&device0, &device1, &device2};
+        EXPECT_CALL(*usbmock, get_device_list(nullptr, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(deviceList.data()), Return(deviceList.size())));
+        libusb_device_descriptor match{};
+        match.idVendor = 0x1ed8;
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device0, NotNull())).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device1, NotNull())).WillOnce(DoAll(SetArgPointee<1>(match), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&device2, NotNull())).Times(0);
+        EXPECT_CALL(*usbmock, ref_device(&device1)).WillOnce(Return(&device1));
+        EXPECT_CALL(*usbmock, unref_device(&device1));
+        EXPECT_CALL(*usbmock, free_device_list(deviceList.data(), 1));
+
+        const auto device = findDevice([](std::uint16_t vid, std::uint16_t)
+                                       { return vid == 0x1ed8; });
+        ASSERT_TRUE(device.has_value());
+        EXPECT_THAT(device->native(), Eq(&device1));
+    }
+
+    TEST_F(UsbTest, findDeviceReturnsEmptyIfNoMatch)
+    {
+        std::array<libusb_device*, 1> deviceList{&dev};
+        EXPECT_CALL(*usbmock, get_device_list(nullptr, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(deviceList.data()), Return(deviceList.size())));
+        EXPECT_CALL(*usbmock, get_device_descriptor(&dev, NotNull())).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, free_device_list(_, 1));
+
+        EXPECT_FALSE(findDevice([](std::uint16_t, std::uint16_t)
+                                { return false; })
+                         .has_value());
+    }
+
     TEST_F(UsbTest, deviceRefsDevice)
     {
         EXPECT_CALL(*usbmock, ref_device(&dev)).WillOnce(Return(&dev));
@@ -249,6 +404,24 @@ namespace plug::test
     }
 
     TEST_F(UsbTest, deviceOpenThrowsOnClaimInterfaceError)
+    {
+        EXPECT_CALL(*usbmock, get_device_descriptor(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, ref_device(_)).WillOnce(Return(&dev));
+        EXPECT_CALL(*usbmock, release_interface(_, _));
+        EXPECT_CALL(*usbmock, unref_device(_));
+        EXPECT_CALL(*usbmock, open(_, _))
+            .WillOnce(DoAll(SetArgPointee<1>(handle), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, set_auto_detach_kernel_driver(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, claim_interface(_, _)).WillOnce(Return(LIBUSB_ERROR_ACCESS));
+        EXPECT_CALL(*usbmock, close(_));
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_ACCESS)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_ACCESS)).WillOnce(Return("ignore_message"));
+
+        Device device{&dev};
+        EXPECT_THROW(device.open(), UsbException);
+    }
+
+    TEST_F(UsbTest, deviceOpenReportsDeviceInUse)
     {
         EXPECT_CALL(*usbmock, get_device_descriptor(_, _)).WillOnce(Return(LIBUSB_SUCCESS));
         EXPECT_CALL(*usbmock, ref_device(_)).WillOnce(Return(&dev));
@@ -263,7 +436,15 @@ namespace plug::test
         EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_BUSY)).WillOnce(Return("ignore_message"));
 
         Device device{&dev};
-        EXPECT_THROW(device.open(), UsbException);
+        try
+        {
+            device.open();
+            FAIL() << "No exception thrown";
+        }
+        catch (const UsbException& ex)
+        {
+            EXPECT_THAT(ex.code(), Eq(LIBUSB_ERROR_BUSY));
+        }
     }
 
     TEST_F(UsbTest, deviceIsOpenReturnsFalseIfNotOpen)
@@ -558,4 +739,285 @@ namespace plug::test
         device.open();
         EXPECT_THROW(device.receive(0x33, 17), UsbException);
     }
+
+    TEST_F(UsbTest, startReceivingSubmitsTransfers)
+    {
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(4).WillRepeatedly(Return(LIBUSB_SUCCESS));
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+
+        EXPECT_THAT(transfers, SizeIs(4));
+        EXPECT_THAT(transfers[0]->endpoint, Eq(0x81));
+        EXPECT_THAT(transfers[0]->length, Eq(64));
+        EXPECT_THAT(transfers[0]->dev_handle, Eq(handle));
+    }
+
+    TEST_F(UsbTest, startReceivingThrowsOnSubmitFailure)
+    {
+        expectOpenAndClose();
+        EXPECT_CALL(*usbmock, alloc_transfer(0)).Times(2).WillRepeatedly(InvokeWithoutArgs([this]
+                                                                                           { return allocateTransfer(); }));
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).WillOnce(Return(LIBUSB_SUCCESS)).WillOnce(Return(LIBUSB_ERROR_NO_DEVICE));
+        EXPECT_CALL(*usbmock, cancel_transfer(NotNull())).WillOnce([this](libusb_transfer* transfer)
+                                                                   {
+                completeTransfer(transfer, LIBUSB_TRANSFER_CANCELLED);
+                return LIBUSB_SUCCESS; })
+            .WillOnce(Return(LIBUSB_ERROR_NOT_FOUND));
+        EXPECT_CALL(*usbmock, free_transfer(NotNull())).Times(2);
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_message"));
+
+        Device device{&dev};
+        device.open();
+        EXPECT_THROW(device.startReceiving(0x81, 64), UsbException);
+    }
+
+    TEST_F(UsbTest, receiveReturnsReceivedPackets)
+    {
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(6).WillRepeatedly(Return(LIBUSB_SUCCESS));
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+
+        const std::vector<std::uint8_t> packet0{0x01, 0x02, 0x03};
+        const std::vector<std::uint8_t> packet1{0x04, 0x05};
+        completeTransfer(transfers[0].get(), LIBUSB_TRANSFER_COMPLETED, packet0);
+        completeTransfer(transfers[1].get(), LIBUSB_TRANSFER_COMPLETED, packet1);
+
+        EXPECT_THAT(device.receive(0x81, 64), Eq(packet0));
+        EXPECT_THAT(device.receive(0x81, 64), Eq(packet1));
+    }
+
+    TEST_F(UsbTest, receiveIntoReceivesPacketsIntoBuffer)
+    {
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(5).WillRepeatedly(Return(LIBUSB_SUCCESS));
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+
+        const std::vector<std::uint8_t> packet{0x01, 0x02, 0x03};
+        completeTransfer(transfers[0].get(), LIBUSB_TRANSFER_COMPLETED, packet);
+
+        std::array<std::uint8_t, 64> buffer{};
+        EXPECT_THAT(device.receiveInto(0x81, buffer), Eq(packet.size()));
+        EXPECT_TRUE(std::equal(packet.cbegin(), packet.cend(), buffer.cbegin()));
+    }
+
+    TEST_F(UsbTest, receiveIntoReceivesDataDirectlyIfNotReceiving)
+    {
+        expectOpenAndClose();
+
+        std::array<std::uint8_t, 4> data{{0x10, 0x11, 0x12, 0x13}};
+        std::array<std::uint8_t, 4> buffer{};
+        EXPECT_CALL(*usbmock, interrupt_transfer(handle, 0xcd, buffer.data(), buffer.size(), NotNull(), 500))
+            .WillOnce(DoAll(SetArrayArgument<2>(data.begin(), data.end()), SetArgPointee<4>(data.size()), Return(LIBUSB_SUCCESS)));
+
+        Device device{&dev};
+        device.open();
+        EXPECT_THAT(device.receiveInto(0xcd, buffer), Eq(data.size()));
+        EXPECT_THAT(buffer, Eq(data));
+    }
+
+    TEST_F(UsbTest, receiveThrowsOnFailedReceiveTransfer)
+    {
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(4).WillRepeatedly(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_message"));
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+
+        completeTransfer(transfers[0].get(), LIBUSB_TRANSFER_NO_DEVICE);
+        EXPECT_THROW(device.receive(0x81, 64), UsbException);
+    }
+
+    TEST_F(UsbTest, receiveDropsOldestPacketOnOverflow)
+    {
+        constexpr std::size_t capacity{512};
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(4 + capacity + 2).WillRepeatedly(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, error_name(_)).Times(0);
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+
+        for (std::size_t i = 0; i < capacity + 1; ++i)
+        {
+            completeTransfer(transfers[i % 4].get(), LIBUSB_TRANSFER_COMPLETED, {static_cast<std::uint8_t>(i >> 8), static_cast<std::uint8_t>(i)});
+        }
+
+        EXPECT_THAT(device.droppedPackets(), Eq(1));
+        EXPECT_THAT(device.receive(0x81, 64), ElementsAre(0x00, 0x01));
+
+        for (std::size_t i = 2; i < capacity; ++i)
+        {
+            device.receive(0x81, 64);
+        }
+        EXPECT_THAT(device.receive(0x81, 64), ElementsAre(0x02, 0x00));
+
+        completeTransfer(transfers[0].get(), LIBUSB_TRANSFER_COMPLETED, {0xab});
+        EXPECT_THAT(device.receive(0x81, 64), ElementsAre(0xab));
+        EXPECT_THAT(device.droppedPackets(), Eq(1));
+    }
+
+    TEST_F(UsbTest, closeStopsReceiving)
+    {
+        expectOpenAndClose();
+        expectReceiveTransfers();
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).Times(4).WillRepeatedly(Return(LIBUSB_SUCCESS));
+
+        Device device{&dev};
+        device.open();
+        device.startReceiving(0x81, 64);
+        device.close();
+    }
+
+    TEST_F(UsbTest, writeAsyncSubmitsTransfer)
+    {
+        expectOpenAndClose();
+        EXPECT_CALL(*usbmock, alloc_transfer(0)).WillOnce(InvokeWithoutArgs([this]
+                                                                            { return allocateTransfer(); }));
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, free_transfer(NotNull()));
+
+        std::array<std::uint8_t, 4> buffer{{0x00, 0x01, 0x02, 0x03}};
+        Device device{&dev};
+        device.open();
+        auto result = device.writeAsync(0x01, buffer.data(), buffer.size());
+
+        EXPECT_THAT(transfers, SizeIs(1));
+        EXPECT_THAT(transfers[0]->endpoint, Eq(0x01));
+        EXPECT_THAT(transfers[0]->timeout, Eq(500));
+        EXPECT_TRUE(std::equal(buffer.cbegin(), buffer.cend(), transfers[0]->buffer));
+
+        transfers[0]->actual_length = 4;
+        transfers[0]->status = LIBUSB_TRANSFER_COMPLETED;
+        transfers[0]->callback(transfers[0].get());
+        EXPECT_THAT(result.get(), Eq(4));
+    }
+
+    TEST_F(UsbTest, writeAsyncCopiesData)
+    {
+        expectOpenAndClose();
+        EXPECT_CALL(*usbmock, alloc_transfer(0)).WillOnce(InvokeWithoutArgs([this]
+                                                                            { return allocateTransfer(); }));
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, free_transfer(NotNull()));
+
+        Device device{&dev};
+        device.open();
+        {
+            std::array<std::uint8_t, 4> buffer{{0x00, 0x01, 0x02, 0x03}};
+            device.writeAsync(0x01, buffer.data(), buffer.size());
+            buffer.fill(0xff);
+        }
+
+        EXPECT_THAT(std::vector<std::uint8_t>(transfers[0]->buffer, std::next(transfers[0]->buffer, transfers[0]->length)), ElementsAre(0x00, 0x01, 0x02, 0x03));
+
+        transfers[0]->actual_length = 4;
+        transfers[0]->status = LIBUSB_TRANSFER_COMPLETED;
+        transfers[0]->callback(transfers[0].get());
+    }
+
+    TEST_F(UsbTest, writeAsyncReportsFailedTransfer)
+    {
+        expectOpenAndClose();
+        EXPECT_CALL(*usbmock, alloc_transfer(0)).WillOnce(InvokeWithoutArgs([this]
+                                                                            { return allocateTransfer(); }));
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).WillOnce(Return(LIBUSB_SUCCESS));
+        EXPECT_CALL(*usbmock, free_transfer(NotNull()));
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_TIMEOUT)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_TIMEOUT)).WillOnce(Return("ignore_message"));
+
+        std::array<std::uint8_t, 4> buffer{{0x00, 0x01, 0x02, 0x03}};
+        Device device{&dev};
+        device.open();
+        auto result = device.writeAsync(0x01, buffer.data(), buffer.size());
+
+        transfers[0]->status = LIBUSB_TRANSFER_TIMED_OUT;
+        transfers[0]->callback(transfers[0].get());
+        EXPECT_THROW(result.get(), UsbException);
+    }
+
+    TEST_F(UsbTest, writeAsyncThrowsOnSubmitFailure)
+    {
+        expectOpenAndClose();
+        EXPECT_CALL(*usbmock, alloc_transfer(0)).WillOnce(InvokeWithoutArgs([this]
+                                                                            { return allocateTransfer(); }));
+        EXPECT_CALL(*usbmock, submit_transfer(NotNull())).WillOnce(Return(LIBUSB_ERROR_NO_DEVICE));
+        EXPECT_CALL(*usbmock, free_transfer(NotNull()));
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_NO_DEVICE)).WillOnce(Return("ignore_message"));
+
+        std::array<std::uint8_t, 4> buffer{{0x00, 0x01, 0x02, 0x03}};
+        Device device{&dev};
+        device.open();
+        EXPECT_THROW(device.writeAsync(0x01, buffer.data(), buffer.size()), UsbException);
+    }
+
+    TEST_F(UsbTest, hasHotplugSupportChecksCapability)
+    {
+        EXPECT_CALL(*usbmock, has_capability(LIBUSB_CAP_HAS_HOTPLUG)).WillOnce(Return(1)).WillOnce(Return(0));
+
+        EXPECT_TRUE(hasHotplugSupport());
+        EXPECT_FALSE(hasHotplugSupport());
+    }
+
+    TEST_F(UsbTest, hotplugRegistersForVendorAndEnumeratesDevices)
+    {
+        EXPECT_CALL(*usbmock, hotplug_register_callback(nullptr, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT, LIBUSB_HOTPLUG_ENUMERATE,
+                                                        0x1ed8, LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY, NotNull(), NotNull(), NotNull()))
+            .WillOnce(DoAll(SetArgPointee<8>(7), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, hotplug_deregister_callback(nullptr, 7));
+
+        Hotplug hotplug{0x1ed8, [](HotplugEvent, Device) {}};
+    }
+
+    TEST_F(UsbTest, hotplugThrowsOnRegisterError)
+    {
+        EXPECT_CALL(*usbmock, hotplug_register_callback(_, _, _, _, _, _, _, _, _)).WillOnce(Return(LIBUSB_ERROR_NOT_SUPPORTED));
+        EXPECT_CALL(*usbmock, error_name(LIBUSB_ERROR_NOT_SUPPORTED)).WillOnce(Return("ignore_name"));
+        EXPECT_CALL(*usbmock, strerror(LIBUSB_ERROR_NOT_SUPPORTED)).WillOnce(Return("ignore_message"));
+
+        EXPECT_THROW((Hotplug{0x1ed8, [](HotplugEvent, Device) {}}), UsbException);
+    }
+
+    TEST_F(UsbTest, hotplugReportsEventsWithDevice)
+    {
+        libusb_hotplug_callback_fn callback{nullptr};
+        void* userData{nullptr};
+        EXPECT_CALL(*usbmock, hotplug_register_callback(_, _, _, _, _, _, _, _, _))
+            .WillOnce(DoAll(SaveArg<6>(&callback), SaveArg<7>(&userData), Return(LIBUSB_SUCCESS)));
+        EXPECT_CALL(*usbmock, hotplug_deregister_callback(_, _));
+        EXPECT_CALL(*usbmock, ref_device(&dev)).Times(2).WillRepeatedly(Return(&dev));
+        EXPECT_CALL(*usbmock, unref_device(&dev)).Times(2);
+        libusb_device_descriptor descriptor{};
+        descriptor.idVendor = 0x1ed8;
+        descriptor.idProduct = 0x0005;
+        EXPECT_CALL(*usbmock, get_device_descriptor(&dev, NotNull())).Times(2).WillRepeatedly(DoAll(SetArgPointee<1>(descriptor), Return(LIBUSB_SUCCESS)));
+
+        std::vector<std::pair<HotplugEvent, std::uint16_t>> events;
+        Hotplug hotplug{0x1ed8, [&events](HotplugEvent event, Device device)
+                        { events.emplace_back(event, device.productId()); }};
+
+        ASSERT_THAT(callback, NotNull());
+        EXPECT_THAT(callback(nullptr, &dev, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData), Eq(0));
+        EXPECT_THAT(callback(nullptr, &dev, LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT, userData), Eq(0));
+        EXPECT_THAT(events, ElementsAre(std::pair{HotplugEvent::Arrived, std::uint16_t{0x0005}}, std::pair{HotplugEvent::Left, std::uint16_t{0x0005}}));
+    }
 }
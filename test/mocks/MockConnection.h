@@ -37,7 +37,7 @@ namespace plug::test::mock
         MOCK_METHOD(void, close, ());
         MOCK_METHOD(bool, isOpen, (), (const));
         MOCK_METHOD(std::vector<std::uint8_t>, receive, (std::size_t) );
-        MOCK_METHOD(std::size_t, sendImpl, (std::uint8_t*, std::size_t) );
+        MOCK_METHOD(std::size_t, sendImpl, (const std::uint8_t*, std::size_t) );
         MOCK_METHOD(std::string, name, (), (const));
     };
 }
@@ -19,7 +19,10 @@
  */
 
 #include "UsbDeviceMock.h"
+#include "com/UsbException.h"
+#include <algorithm>
 #include <memory>
+#include <string>
 
 namespace plug::test::mock
 {
@@ -80,6 +83,10 @@ namespace plug::com::usb
         void releaseHandle([[maybe_unused]] libusb_device_handle* handle)
         {
         }
+
+        void releaseReceiveQueue([[maybe_unused]] ReceiveQueue* queue)
+        {
+        }
     }
 
     std::vector<Device> listDevices()
@@ -87,9 +94,46 @@ namespace plug::com::usb
         return plug::test::mock::usbContextMock->listDevices();
     }
 
+    std::vector<Device> listDevices(const DeviceFilter& filter)
+    {
+        auto devices = plug::test::mock::usbContextMock->listDevices();
+        std::erase_if(devices, [&filter](const auto& device)
+                      { return !filter(device.vendorId(), device.productId()); });
+        return devices;
+    }
+
+    std::optional<Device> findDevice(const DeviceFilter& filter)
+    {
+        auto devices = plug::test::mock::usbContextMock->listDevices();
+        auto itr = std::find_if(devices.begin(), devices.end(), [&filter](const auto& device)
+                                { return filter(device.vendorId(), device.productId()); });
+        return (itr != devices.end()) ? std::optional<Device>{std::move(*itr)} : std::nullopt;
+    }
+
+    bool hasHotplugSupport()
+    {
+        return plug::test::mock::usbContextMock->hasHotplugSupport();
+    }
+
+    Hotplug::Hotplug(std::uint16_t vendorId, Callback callback)
+        : callback_(std::move(callback)), handle_(0)
+    {
+        plug::test::mock::usbContextMock->registerHotplug(vendorId, callback_);
+    }
+
+    Hotplug::~Hotplug()
+    {
+        plug::test::mock::usbContextMock->deregisterHotplug();
+    }
+
 
     Device::Device(libusb_device* device)
-        : device_(device), handle_(nullptr), descriptor_({})
+        : device_(device), handle_(nullptr), receiveQueue_(nullptr), descriptor_({})
+    {
+    }
+
+    Device::Device(libusb_device* device, [[maybe_unused]] const libusb_device_descriptor& descriptor)
+        : device_(device), handle_(nullptr), receiveQueue_(nullptr), descriptor_({})
     {
     }
 
@@ -123,7 +167,7 @@ namespace plug::com::usb
         return plug::test::mock::usbDeviceMock->name();
     }
 
-    std::size_t Device::write(std::uint8_t endpoint, std::uint8_t* data, std::size_t dataSize)
+    std::size_t Device::write(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize)
     {
         return plug::test::mock::usbDeviceMock->write(endpoint, data, dataSize);
     }
@@ -133,4 +177,54 @@ namespace plug::com::usb
         return plug::test::mock::usbDeviceMock->receive(endpoint, dataSize);
     }
 
+    std::size_t Device::receiveInto(std::uint8_t endpoint, std::span<std::uint8_t> buffer)
+    {
+        return plug::test::mock::usbDeviceMock->receiveInto(endpoint, buffer);
+    }
+
+    std::future<std::size_t> Device::writeAsync(std::uint8_t endpoint, const std::uint8_t* data, std::size_t dataSize)
+    {
+        return plug::test::mock::usbDeviceMock->writeAsync(endpoint, data, dataSize);
+    }
+
+    void Device::startReceiving(std::uint8_t endpoint, std::size_t packetSize)
+    {
+        plug::test::mock::usbDeviceMock->startReceiving(endpoint, packetSize);
+    }
+
+    void Device::stopReceiving()
+    {
+        plug::test::mock::usbDeviceMock->stopReceiving();
+    }
+
+    std::size_t Device::droppedPackets() const
+    {
+        return plug::test::mock::usbDeviceMock->droppedPackets();
+    }
+
+
+    UsbException::UsbException(int errorCode)
+        : error_(errorCode), name_("mock_error"), message_("mock error " + std::to_string(errorCode))
+    {
+    }
+
+    int UsbException::code() const noexcept
+    {
+        return error_;
+    }
+
+    std::string UsbException::name() const
+    {
+        return name_;
+    }
+
+    std::string UsbException::message() const
+    {
+        return message_;
+    }
+
+    const char* UsbException::what() const noexcept
+    {
+        return message_.c_str();
+    }
 }
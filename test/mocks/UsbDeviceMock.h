@@ -22,6 +22,7 @@
 
 #include "com/UsbContext.h"
 #include "com/UsbDevice.h"
+#include "com/UsbHotplug.h"
 #include <gmock/gmock.h>
 
 namespace plug::test::mock
@@ -29,6 +30,9 @@ namespace plug::test::mock
     struct UsbContextMock
     {
         MOCK_METHOD(std::vector<plug::com::usb::Device>, listDevices, ());
+        MOCK_METHOD(bool, hasHotplugSupport, ());
+        MOCK_METHOD(void, registerHotplug, (std::uint16_t, plug::com::usb::Hotplug::Callback));
+        MOCK_METHOD(void, deregisterHotplug, ());
     };
 
     UsbContextMock* resetUsbContextMock();
@@ -43,8 +47,13 @@ namespace plug::test::mock
         MOCK_METHOD(bool, isOpen, (), (const, noexcept));
         MOCK_METHOD(std::uint16_t, vendorId, (), (const noexcept));
         MOCK_METHOD(std::uint16_t, productId, (), (const noexcept));
-        MOCK_METHOD(std::size_t, write, (std::uint8_t, std::uint8_t*, std::size_t) );
+        MOCK_METHOD(std::size_t, write, (std::uint8_t, const std::uint8_t*, std::size_t) );
         MOCK_METHOD(std::vector<std::uint8_t>, receive, (std::uint8_t, std::size_t) );
+        MOCK_METHOD(std::size_t, receiveInto, (std::uint8_t, std::span<std::uint8_t>) );
+        MOCK_METHOD(std::future<std::size_t>, writeAsync, (std::uint8_t, const std::uint8_t*, std::size_t) );
+        MOCK_METHOD(void, startReceiving, (std::uint8_t, std::size_t) );
+        MOCK_METHOD(void, stopReceiving, ());
+        MOCK_METHOD(std::size_t, droppedPackets, (), (const));
         MOCK_METHOD(std::string, name, ());
     };
 